@@ -0,0 +1,248 @@
+/* <flatmap_lookup.c> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+/*
+ * Standalone lookup benchmark of ec_flatset (Eytzinger order) against a
+ * plain binary search over the same sorted keys and an open-addressing hash
+ * table. It is not a part of the library; configure with
+ * -DECLIBC_BUILD_BENCHMARKS=ON and run "ecBenchmarkFlatmap".
+ *
+ * Every key set is queried with the same random keys, half of them present.
+ * The best of 3 runs is reported in ns per lookup and the hit counts of the
+ * three searches are compared.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <ec/io.h>
+#include <ec/map.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#define EC_BENCHMARK_QUERIES    (4 * 1024 * 1024)
+#define EC_BENCHMARK_REPEAT     3
+#define EC_BENCHMARK_MAX_KEYS   10000000
+
+/* The keys are even, so the odd queries always miss and 0 marks an empty
+ * hash slot. */
+typedef struct
+{
+    uint64_t *slots;
+    uint64_t  mask;
+    unsigned  shift;
+} ec_benchmark_hash;
+
+static uint64_t *ec_benchmark_keys;
+static uint64_t *ec_benchmark_queries;
+static uint64_t  ec_benchmark_state = 88172645463325252ULL;
+
+static double ec_benchmark_now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+static uint64_t ec_benchmark_random(void)
+{
+    ec_benchmark_state ^= ec_benchmark_state << 13;
+    ec_benchmark_state ^= ec_benchmark_state >> 7;
+    ec_benchmark_state ^= ec_benchmark_state << 17;
+    return ec_benchmark_state;
+}
+
+static inline uint64_t
+ec_benchmark_hash_slot(const ec_benchmark_hash *hash, uint64_t key)
+{
+    return (key * 0x9E3779B97F4A7C15ULL) >> hash->shift;
+}
+
+/* Sizes the table to a load factor of at most one half. */
+static bool ec_benchmark_hash_build(ec_benchmark_hash *hash,
+                                    const uint64_t *keys, size_t count)
+{
+    uint64_t capacity = 2;
+    uint64_t slot;
+    size_t index;
+    hash->shift = 63;
+    while(capacity < 2 * (uint64_t)count)
+    {
+        capacity <<= 1;
+        hash->shift--;
+    }
+    hash->mask = capacity - 1;
+    hash->slots = (uint64_t *)calloc((size_t)capacity, sizeof(uint64_t));
+    if(hash->slots == EC_NULL)
+        return false;
+    for(index = 0; index < count; index++)
+    {
+        slot = ec_benchmark_hash_slot(hash, keys[index]);
+        while(hash->slots[slot] != 0)
+            slot = (slot + 1) & hash->mask;
+        hash->slots[slot] = keys[index];
+    }
+    return true;
+}
+
+static inline bool
+ec_benchmark_hash_contains(const ec_benchmark_hash *hash, uint64_t key)
+{
+    uint64_t slot = ec_benchmark_hash_slot(hash, key);
+    while(hash->slots[slot] != 0)
+    {
+        if(hash->slots[slot] == key)
+            return true;
+        slot = (slot + 1) & hash->mask;
+    }
+    return false;
+}
+
+static inline bool
+ec_benchmark_binary_contains(const uint64_t *keys, size_t count, uint64_t key)
+{
+    size_t low = 0;
+    size_t high = count;
+    size_t middle;
+    while(low < high)
+    {
+        middle = low + (high - low) / 2;
+        if(keys[middle] < key)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low < count && keys[low] == key;
+}
+
+/* Runs "statement" once per query EC_BENCHMARK_REPEAT times, counting the
+ * true results in "hits" and keeping the best run in "best". */
+#define EC_BENCHMARK_TIME(best, hits, statement)                               \
+    for(repeat = 0; repeat < EC_BENCHMARK_REPEAT; repeat++)                    \
+    {                                                                          \
+        hits = 0;                                                              \
+        start = ec_benchmark_now();                                            \
+        for(index = 0; index < EC_BENCHMARK_QUERIES; index++)                  \
+        {                                                                      \
+            query = ec_benchmark_queries[index];                               \
+            hits += (size_t)(statement);                                       \
+        }                                                                      \
+        elapsed = ec_benchmark_now() - start;                                  \
+        if(elapsed < best)                                                     \
+            best = elapsed;                                                    \
+    }
+
+static bool ec_benchmark_run(size_t count)
+{
+    ec_flatset set;
+    ec_benchmark_hash hash;
+    double flat_best   = 1e18;
+    double binary_best = 1e18;
+    double hash_best   = 1e18;
+    double start;
+    double elapsed;
+    uint64_t query;
+    size_t flat_hits   = 0;
+    size_t binary_hits = 0;
+    size_t hash_hits   = 0;
+    size_t index;
+    int repeat;
+
+    for(index = 0; index < EC_BENCHMARK_QUERIES; index++)
+    {
+        query = ec_benchmark_random();
+        ec_benchmark_queries[index] = ec_benchmark_keys[query % count] |
+                                      (query >> 63);
+    }
+    if(!ec_flatset_build(&set, ec_benchmark_keys, count))
+        return false;
+    if(!ec_benchmark_hash_build(&hash, ec_benchmark_keys, count))
+    {
+        ec_flatset_delete(&set);
+        return false;
+    }
+
+    EC_BENCHMARK_TIME(flat_best, flat_hits,
+                      ec_flatset_contains(&set, query))
+    EC_BENCHMARK_TIME(binary_best, binary_hits,
+                      ec_benchmark_binary_contains(ec_benchmark_keys, count,
+                                                   query))
+    EC_BENCHMARK_TIME(hash_best, hash_hits,
+                      ec_benchmark_hash_contains(&hash, query))
+
+    ec_printf("%10llu %10.2f %10.2f %10.2f\r\n", (uint64_t)count,
+              flat_best   / EC_BENCHMARK_QUERIES,
+              binary_best / EC_BENCHMARK_QUERIES,
+              hash_best   / EC_BENCHMARK_QUERIES);
+    if(flat_hits != binary_hits || flat_hits != hash_hits)
+        ec_printf("The hit counts differ: %llu, %llu, %llu\r\n",
+                  (uint64_t)flat_hits, (uint64_t)binary_hits,
+                  (uint64_t)hash_hits);
+
+    free(hash.slots);
+    ec_flatset_delete(&set);
+    return true;
+}
+
+int main(void)
+{
+    static const size_t counts[] = {1000, 10000, 100000, 1000000,
+                                    EC_BENCHMARK_MAX_KEYS};
+    uint64_t key = 0;
+    size_t index;
+
+    ec_benchmark_keys = (uint64_t *)malloc(EC_BENCHMARK_MAX_KEYS *
+                                           sizeof(uint64_t));
+    ec_benchmark_queries = (uint64_t *)malloc(EC_BENCHMARK_QUERIES *
+                                              sizeof(uint64_t));
+    if(ec_benchmark_keys == EC_NULL || ec_benchmark_queries == EC_NULL)
+    {
+        ec_printf("Memory allocation failed.\r\n");
+        return 1;
+    }
+    /* Sorted, unique and even keys with random gaps. */
+    for(index = 0; index < EC_BENCHMARK_MAX_KEYS; index++)
+    {
+        key += 2 + 2 * (ec_benchmark_random() % 16);
+        ec_benchmark_keys[index] = key;
+    }
+
+    ec_printf("eclibc: ec/benchmark/flatmap_lookup.c:\r\n");
+    ec_printf("ns per lookup, %llu random queries, half of them hits, "
+              "best of %llu runs\r\n\r\n", (uint64_t)EC_BENCHMARK_QUERIES,
+              (uint64_t)EC_BENCHMARK_REPEAT);
+    ec_printf("%10s %10s %10s %10s\r\n", "keys", "eytzinger", "binary",
+              "hash");
+    for(index = 0; index < sizeof(counts) / sizeof(counts[0]); index++)
+    {
+        if(!ec_benchmark_run(counts[index]))
+        {
+            ec_printf("Memory allocation failed.\r\n");
+            return 1;
+        }
+    }
+    free(ec_benchmark_queries);
+    free(ec_benchmark_keys);
+    return 0;
+}
@@ -0,0 +1,188 @@
+/* <ftoa_throughput.c> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+/*
+ * Standalone microbenchmark of the shortest and fixed double formatting of
+ * ec/internal/ftoa.c against snprintf. It is not a part of the library;
+ * configure with -DECLIBC_BUILD_BENCHMARKS=ON and run "ecBenchmarkFtoa".
+ *
+ * "money" formats values with three decimals below 100000, "random" formats
+ * random finite bit patterns. The best of 5 runs over 4096 values is
+ * reported in ns per call.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <ec/io.h>
+#include <ec/internal/text_parse/ftoa.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#define EC_BENCHMARK_COUNT      4096
+#define EC_BENCHMARK_LOOPS      20
+#define EC_BENCHMARK_REPEAT     5
+
+typedef enum
+{
+    ec_benchmark_libc_17g,
+    ec_benchmark_libc_g,
+    ec_benchmark_ec_shortest_g,
+    ec_benchmark_ec_shortest,
+    ec_benchmark_libc_f,
+    ec_benchmark_ec_f,
+    ec_benchmark_ec_fixed,
+    ec_benchmark_row_count
+} ec_benchmark_row;
+
+static const char *const ec_benchmark_names[ec_benchmark_row_count] =
+{
+    "snprintf %.17g",
+    "snprintf %g",
+    "ec_snprintf %!g",
+    "ec_double_to_shortest",
+    "snprintf %f",
+    "ec_snprintf %f",
+    "ec_double_to_fixed"
+};
+
+static double ec_benchmark_money[EC_BENCHMARK_COUNT];
+static double ec_benchmark_random[EC_BENCHMARK_COUNT];
+static volatile char ec_benchmark_sink;
+
+static double ec_benchmark_now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+/* Runs "statement" for every value EC_BENCHMARK_LOOPS times and keeps the
+ * best run of EC_BENCHMARK_REPEAT in "best". */
+#define EC_BENCHMARK_TIME(best, statement)                                     \
+    for(repeat = 0; repeat < EC_BENCHMARK_REPEAT; repeat++)                    \
+    {                                                                          \
+        start = ec_benchmark_now();                                            \
+        for(loop = 0; loop < EC_BENCHMARK_LOOPS; loop++)                       \
+        {                                                                      \
+            for(index = 0; index < EC_BENCHMARK_COUNT; index++)                \
+            {                                                                  \
+                statement;                                                     \
+            }                                                                  \
+        }                                                                      \
+        elapsed = ec_benchmark_now() - start;                                  \
+        if(elapsed < best)                                                     \
+            best = elapsed;                                                    \
+    }
+
+/* Returns the best time of one call of "row" in ns. */
+static double ec_benchmark_run(ec_benchmark_row row, const double *values)
+{
+    char buffer[EC_FTOA_FIXED_SIZE(6)];
+    char *const buflim = buffer + sizeof(buffer);
+    double best = 1e18;
+    double start;
+    double elapsed;
+    int repeat;
+    int loop;
+    int index;
+
+    switch(row)
+    {
+    case ec_benchmark_libc_17g:
+        EC_BENCHMARK_TIME(best,
+            snprintf(buffer, sizeof(buffer), "%.17g", values[index]);
+            ec_benchmark_sink = buffer[0])
+        break;
+    case ec_benchmark_libc_g:
+        EC_BENCHMARK_TIME(best,
+            snprintf(buffer, sizeof(buffer), "%g", values[index]);
+            ec_benchmark_sink = buffer[0])
+        break;
+    case ec_benchmark_ec_shortest_g:
+        EC_BENCHMARK_TIME(best,
+            ec_snprintf(buffer, sizeof(buffer), "%!g", values[index]);
+            ec_benchmark_sink = buffer[0])
+        break;
+    case ec_benchmark_ec_shortest:
+        EC_BENCHMARK_TIME(best,
+            ec_benchmark_sink =
+                *ec_double_to_shortest(values[index], buflim, false))
+        break;
+    case ec_benchmark_libc_f:
+        EC_BENCHMARK_TIME(best,
+            snprintf(buffer, sizeof(buffer), "%f", values[index]);
+            ec_benchmark_sink = buffer[0])
+        break;
+    case ec_benchmark_ec_f:
+        EC_BENCHMARK_TIME(best,
+            ec_snprintf(buffer, sizeof(buffer), "%f", values[index]);
+            ec_benchmark_sink = buffer[0])
+        break;
+    case ec_benchmark_ec_fixed:
+        EC_BENCHMARK_TIME(best,
+            ec_benchmark_sink =
+                *ec_double_to_fixed(values[index], buflim, 6,
+                                    ec_ftoa_round_nearest))
+        break;
+    case ec_benchmark_row_count:
+        break;
+    }
+    return best / (EC_BENCHMARK_LOOPS * (double)EC_BENCHMARK_COUNT);
+}
+
+int main(void)
+{
+    uint64_t state = 88172645463325252ULL;
+    uint64_t bits;
+    size_t index;
+    int row;
+
+    for(index = 0; index < EC_BENCHMARK_COUNT; index++)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        ec_benchmark_money[index] = (double)(state % 100000000) / 1000.0;
+        /* No infinities and NaNs. */
+        bits = state;
+        if(((bits >> 52) & 0x7FF) == 0x7FF)
+            bits ^= 1ULL << 62;
+        memcpy(&ec_benchmark_random[index], &bits, sizeof(bits));
+    }
+
+    ec_printf("eclibc: ec/benchmark/ftoa_throughput.c:\r\n");
+    ec_printf("ns per call, best of %llu runs, lower is better\r\n\r\n",
+              (uint64_t)EC_BENCHMARK_REPEAT);
+    ec_printf("%-22s %8s %8s\r\n", "", "money", "random");
+    for(row = 0; row < ec_benchmark_row_count; row++)
+    {
+        ec_printf("%-22s %8.1f %8.1f\r\n", ec_benchmark_names[row],
+                  ec_benchmark_run((ec_benchmark_row)row, ec_benchmark_money),
+                  ec_benchmark_run((ec_benchmark_row)row,
+                                   ec_benchmark_random));
+    }
+    return 0;
+}
@@ -0,0 +1,174 @@
+/* <itoa_widths.c> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+/*
+ * Standalone microbenchmark of the ec_itoa_<type> converters, one row per
+ * integer width and base, against snprintf. It is not a part of the library;
+ * configure with -DECLIBC_BUILD_BENCHMARKS=ON and run "ecBenchmarkItoa".
+ *
+ * "full" converts full range values of the type, "mixed" converts values of
+ * random lengths. The best of 5 runs is reported in ns per conversion.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <ec/io.h>
+#include <ec/internal/text_parse/itoa.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+#define EC_BENCHMARK_COUNT      4096
+#define EC_BENCHMARK_LOOPS      500
+#define EC_BENCHMARK_REPEAT     5
+
+static uint64_t ec_benchmark_full[EC_BENCHMARK_COUNT];
+static uint64_t ec_benchmark_mixed[EC_BENCHMARK_COUNT];
+static volatile char ec_benchmark_sink;
+
+static double ec_benchmark_now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+/* Runs "statement" for every value EC_BENCHMARK_LOOPS times and keeps the
+ * best run of EC_BENCHMARK_REPEAT in "best". */
+#define EC_BENCHMARK_TIME(best, statement)                                     \
+    for(repeat = 0; repeat < EC_BENCHMARK_REPEAT; repeat++)                    \
+    {                                                                          \
+        start = ec_benchmark_now();                                            \
+        for(loop = 0; loop < EC_BENCHMARK_LOOPS; loop++)                       \
+        {                                                                      \
+            for(index = 0; index < EC_BENCHMARK_COUNT; index++)                \
+            {                                                                  \
+                statement;                                                     \
+            }                                                                  \
+        }                                                                      \
+        elapsed = ec_benchmark_now() - start;                                  \
+        if(elapsed < best)                                                     \
+            best = elapsed;                                                    \
+    }
+
+/* Defines ec_benchmark_<type>_<base>, which returns the best time of one
+ * conversion in ns, for ec_itoa_<type> when "libc" is false and for
+ * snprintf with "format" otherwise. */
+#define EC_BENCHMARK_ITOA(type, base, cast, format)                            \
+    static double ec_benchmark_##type##_##base(const uint64_t *values,         \
+                                               bool libc)                      \
+    {                                                                          \
+        char buffer[80];                                                       \
+        double best = 1e18;                                                    \
+        double start;                                                          \
+        double elapsed;                                                        \
+        int repeat;                                                            \
+        int loop;                                                              \
+        int index;                                                             \
+        if(libc)                                                               \
+        {                                                                      \
+            EC_BENCHMARK_TIME(best,                                            \
+                snprintf(buffer, sizeof(buffer), format,                       \
+                         (cast)(type)values[index]);                           \
+                ec_benchmark_sink = buffer[0])                                 \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            EC_BENCHMARK_TIME(best,                                            \
+                ec_benchmark_sink =                                            \
+                    *ec_itoa_##type((type)values[index],                       \
+                                    buffer + sizeof(buffer) - 1, base, false)) \
+        }                                                                      \
+        return best / (EC_BENCHMARK_LOOPS * (double)EC_BENCHMARK_COUNT);       \
+    }
+
+EC_BENCHMARK_ITOA(int8_t,   10, long long,          "%lld")
+EC_BENCHMARK_ITOA(uint8_t,  10, unsigned long long, "%llu")
+EC_BENCHMARK_ITOA(int16_t,  10, long long,          "%lld")
+EC_BENCHMARK_ITOA(uint16_t, 10, unsigned long long, "%llu")
+EC_BENCHMARK_ITOA(int32_t,  10, long long,          "%lld")
+EC_BENCHMARK_ITOA(uint32_t, 10, unsigned long long, "%llu")
+EC_BENCHMARK_ITOA(int64_t,  10, long long,          "%lld")
+EC_BENCHMARK_ITOA(uint64_t, 10, unsigned long long, "%llu")
+EC_BENCHMARK_ITOA(uint32_t, 16, unsigned long long, "%llx")
+EC_BENCHMARK_ITOA(uint64_t, 16, unsigned long long, "%llx")
+EC_BENCHMARK_ITOA(uint32_t, 8,  unsigned long long, "%llo")
+
+typedef double (*ec_benchmark_itoa_t)(const uint64_t *values, bool libc);
+
+typedef struct
+{
+    const char *type;
+    const char *base;
+    ec_benchmark_itoa_t function;
+} ec_benchmark_row;
+
+static const ec_benchmark_row ec_benchmark_rows[] =
+{
+    {"int8",   "dec", ec_benchmark_int8_t_10},
+    {"uint8",  "dec", ec_benchmark_uint8_t_10},
+    {"int16",  "dec", ec_benchmark_int16_t_10},
+    {"uint16", "dec", ec_benchmark_uint16_t_10},
+    {"int32",  "dec", ec_benchmark_int32_t_10},
+    {"uint32", "dec", ec_benchmark_uint32_t_10},
+    {"int64",  "dec", ec_benchmark_int64_t_10},
+    {"uint64", "dec", ec_benchmark_uint64_t_10},
+    {"uint32", "hex", ec_benchmark_uint32_t_16},
+    {"uint64", "hex", ec_benchmark_uint64_t_16},
+    {"uint32", "oct", ec_benchmark_uint32_t_8}
+};
+
+int main(void)
+{
+    uint64_t state = 88172645463325252ULL;
+    const ec_benchmark_row *row;
+    size_t index;
+
+    for(index = 0; index < EC_BENCHMARK_COUNT; index++)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        ec_benchmark_full[index] = state;
+        ec_benchmark_mixed[index] = state >> (state % 64);
+    }
+
+    ec_printf("eclibc: ec/benchmark/itoa_widths.c:\r\n");
+    ec_printf("ns per conversion, best of %llu runs, lower is better\r\n\r\n",
+              (uint64_t)EC_BENCHMARK_REPEAT);
+    ec_printf("%-14s %17s %17s\r\n", "", "full", "mixed");
+    ec_printf("%-14s %8s %8s %8s %8s\r\n", "", "eclibc", "snprintf",
+              "eclibc", "snprintf");
+    for(index = 0; index < sizeof(ec_benchmark_rows) /
+                           sizeof(ec_benchmark_rows[0]); index++)
+    {
+        row = &ec_benchmark_rows[index];
+        ec_printf("%-7s%-7s %8.2f %8.2f %8.2f %8.2f\r\n", row->type, row->base,
+                  row->function(ec_benchmark_full, false),
+                  row->function(ec_benchmark_full, true),
+                  row->function(ec_benchmark_mixed, false),
+                  row->function(ec_benchmark_mixed, true));
+    }
+    return 0;
+}
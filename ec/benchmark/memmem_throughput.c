@@ -0,0 +1,147 @@
+/* <memmem_throughput.c> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+/*
+ * Standalone throughput benchmark of ec_memmem against the C library's
+ * memmem and strstr. It is not a part of the library; configure with
+ * -DECLIBC_BUILD_BENCHMARKS=ON and run "ecBenchmarkMemmem".
+ *
+ * The haystack is 64 KiB of random non-zero bytes and the only match of the
+ * needle is at its very end, so every search scans the whole haystack. The
+ * first byte of the needle does not occur anywhere else. The best of 5 runs
+ * is reported in GB/s and the three results are compared.
+ */
+
+#define _GNU_SOURCE
+
+#include <ec/io.h>
+#include <ec/string.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#define EC_BENCHMARK_HAYSTACK   (64 * 1024)
+#define EC_BENCHMARK_LOOPS      1000
+#define EC_BENCHMARK_REPEAT     5
+
+static char ec_benchmark_haystack[EC_BENCHMARK_HAYSTACK + 1];
+static char ec_benchmark_needle[65];
+/* The library calls are pure. The offset is always 0 and is read on every
+ * search, so they cannot be hoisted out of the loops, and every result is
+ * stored to the sink, so none of them is dropped. */
+static volatile size_t ec_benchmark_offset;
+static const char *volatile ec_benchmark_sink;
+
+static double ec_benchmark_now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+/* Runs "statement" EC_BENCHMARK_LOOPS times, keeping its last result in
+ * "found" and the best run of EC_BENCHMARK_REPEAT in "best". */
+#define EC_BENCHMARK_TIME(best, found, statement)                              \
+    for(repeat = 0; repeat < EC_BENCHMARK_REPEAT; repeat++)                    \
+    {                                                                          \
+        start = ec_benchmark_now();                                            \
+        for(loop = 0; loop < EC_BENCHMARK_LOOPS; loop++)                       \
+            ec_benchmark_sink = found = (statement);                           \
+        elapsed = ec_benchmark_now() - start;                                  \
+        if(elapsed < best)                                                     \
+            best = elapsed;                                                    \
+    }
+
+static void ec_benchmark_run(size_t needle_len)
+{
+    char *expected;
+    char saved;
+    const char *ec_found     = EC_NULL;
+    const char *memmem_found = EC_NULL;
+    const char *strstr_found = EC_NULL;
+    double ec_best     = 1e18;
+    double memmem_best = 1e18;
+    double strstr_best = 1e18;
+    double start;
+    double elapsed;
+    double bytes;
+    int repeat;
+    int loop;
+
+    expected = ec_benchmark_haystack + EC_BENCHMARK_HAYSTACK - needle_len;
+    saved = expected[0];
+    expected[0] = '\xFF';
+    memcpy(ec_benchmark_needle, expected, needle_len);
+    ec_benchmark_needle[needle_len] = '\0';
+
+    EC_BENCHMARK_TIME(ec_best, ec_found,
+        (const char *)ec_memmem(ec_benchmark_haystack + ec_benchmark_offset,
+                                EC_BENCHMARK_HAYSTACK,
+                                ec_benchmark_needle, needle_len))
+    EC_BENCHMARK_TIME(memmem_best, memmem_found,
+        (const char *)memmem(ec_benchmark_haystack + ec_benchmark_offset,
+                             EC_BENCHMARK_HAYSTACK,
+                             ec_benchmark_needle, needle_len))
+    EC_BENCHMARK_TIME(strstr_best, strstr_found,
+        strstr(ec_benchmark_haystack + ec_benchmark_offset,
+               ec_benchmark_needle))
+    /* Put the random byte back for the longer needles. */
+    expected[0] = saved;
+
+    bytes = (double)EC_BENCHMARK_HAYSTACK * EC_BENCHMARK_LOOPS;
+    ec_printf("%8llu %12.2f %12.2f %12.2f\r\n", (uint64_t)needle_len,
+              bytes / ec_best, bytes / memmem_best, bytes / strstr_best);
+    if(ec_found != expected || memmem_found != expected ||
+       strstr_found != expected)
+        ec_printf("The results differ for a needle of %llu bytes\r\n",
+                  (uint64_t)needle_len);
+}
+
+int main(void)
+{
+    static const size_t lengths[] = {1, 2, 3, 4, 6, 8, 12, 16, 24, 32, 48, 64};
+    uint64_t state = 88172645463325252ULL;
+    size_t index;
+
+    /* Random bytes from 1 to 254, so the 255 starting the needle is unique
+     * and strstr never stops at a NUL. */
+    for(index = 0; index < EC_BENCHMARK_HAYSTACK; index++)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        ec_benchmark_haystack[index] = (char)(1 + state % 254);
+    }
+
+    ec_printf("eclibc: ec/benchmark/memmem_throughput.c:\r\n");
+    ec_printf("GB/s over a %llu byte haystack, best of %llu runs, "
+              "higher is better\r\n\r\n", (uint64_t)EC_BENCHMARK_HAYSTACK,
+              (uint64_t)EC_BENCHMARK_REPEAT);
+    ec_printf("%8s %12s %12s %12s\r\n", "needle", "ec_memmem", "memmem",
+              "strstr");
+    for(index = 0; index < sizeof(lengths) / sizeof(lengths[0]); index++)
+        ec_benchmark_run(lengths[index]);
+    return 0;
+}
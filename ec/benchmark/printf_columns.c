@@ -0,0 +1,172 @@
+/* <printf_columns.c> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+/*
+ * Standalone benchmark of ec_fprintf against the C library's fprintf on
+ * padded table rows. It is not a part of the library; configure with
+ * -DECLIBC_BUILD_BENCHMARKS=ON and run "ecBenchmarkPrintfColumns".
+ *
+ * Every run writes 2M lines of "%-10d|%10s|%-12s|%8x|%6d\n" to /dev/null
+ * and the best of 7 runs is reported in ns per line. ec_fprintf is timed
+ * with a constant format, which uses the per call site format cache, and
+ * with a format the compiler cannot see, which is parsed on every call. The
+ * first lines of all three writers are compared byte by byte as well.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <ec/io.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#define EC_BENCHMARK_LINES      2000000
+#define EC_BENCHMARK_REPEAT     7
+#define EC_BENCHMARK_CHECKED    1000
+#define EC_BENCHMARK_FORMAT     "%-10d|%10s|%-12s|%8x|%6d\n"
+
+typedef void (*ec_benchmark_writer_t)(FILE *stream, int lines);
+
+/* A volatile read, so __builtin_constant_p never sees a literal. */
+static const char *volatile ec_benchmark_format = EC_BENCHMARK_FORMAT;
+
+static const char *const ec_benchmark_names[8] =
+{
+    "alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel"
+};
+
+static const char *const ec_benchmark_states[4] =
+{
+    "running", "sleeping", "stopped", "zombie"
+};
+
+static double ec_benchmark_now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+/* The arguments of line "line". Every integer stays below 32768, since a
+ * plain %d or %x of eclibc reads 16 bits. */
+#define EC_BENCHMARK_ARGUMENTS(line)                                           \
+    (line) % 32768, ec_benchmark_names[(line) % 8],                            \
+    ec_benchmark_states[((line) / 8) % 4], ((line) * 7) % 32768,               \
+    ((line) * 13) % 10000
+
+static void ec_benchmark_libc(FILE *stream, int lines)
+{
+    int line;
+    for(line = 0; line < lines; line++)
+        fprintf(stream, EC_BENCHMARK_FORMAT, EC_BENCHMARK_ARGUMENTS(line));
+}
+
+static void ec_benchmark_cached(FILE *stream, int lines)
+{
+    int line;
+    for(line = 0; line < lines; line++)
+        ec_fprintf(stream, EC_BENCHMARK_FORMAT, EC_BENCHMARK_ARGUMENTS(line));
+}
+
+static void ec_benchmark_parsed(FILE *stream, int lines)
+{
+    const char *format = ec_benchmark_format;
+    int line;
+    for(line = 0; line < lines; line++)
+        ec_fprintf(stream, format, EC_BENCHMARK_ARGUMENTS(line));
+}
+
+/* Returns the best time of one line in ns, or a negative value if /dev/null
+ * cannot be opened. */
+static double ec_benchmark_time(ec_benchmark_writer_t writer)
+{
+    double best = 1e18;
+    double start;
+    double elapsed;
+    FILE *stream;
+    int repeat;
+
+    stream = fopen("/dev/null", "w");
+    if(stream == EC_NULL)
+        return -1;
+    for(repeat = 0; repeat < EC_BENCHMARK_REPEAT; repeat++)
+    {
+        start = ec_benchmark_now();
+        writer(stream, EC_BENCHMARK_LINES);
+        fflush(stream);
+        elapsed = ec_benchmark_now() - start;
+        if(elapsed < best)
+            best = elapsed;
+    }
+    fclose(stream);
+    return best / EC_BENCHMARK_LINES;
+}
+
+/* Writes the first lines with "writer" into "buffer" and returns their
+ * length, or 0 on a failure. */
+static size_t ec_benchmark_sample(ec_benchmark_writer_t writer, char *buffer,
+                                  size_t size)
+{
+    size_t length;
+    FILE *stream;
+
+    stream = tmpfile();
+    if(stream == EC_NULL)
+        return 0;
+    writer(stream, EC_BENCHMARK_CHECKED);
+    rewind(stream);
+    length = fread(buffer, 1, size, stream);
+    fclose(stream);
+    return length;
+}
+
+int main(void)
+{
+    static char expected[EC_BENCHMARK_CHECKED * 64];
+    static char actual[EC_BENCHMARK_CHECKED * 64];
+    size_t length;
+
+    ec_printf("eclibc: ec/benchmark/printf_columns.c:\r\n");
+    length = ec_benchmark_sample(ec_benchmark_libc, expected,
+                                 sizeof(expected));
+    if(length == 0 ||
+       ec_benchmark_sample(ec_benchmark_cached, actual,
+                           sizeof(actual)) != length ||
+       memcmp(expected, actual, length) != 0 ||
+       ec_benchmark_sample(ec_benchmark_parsed, actual,
+                           sizeof(actual)) != length ||
+       memcmp(expected, actual, length) != 0)
+        ec_printf("The outputs of fprintf and ec_fprintf differ\r\n");
+
+    ec_printf("ns per line, %llu lines to /dev/null, best of %llu runs\r\n\r\n",
+              (uint64_t)EC_BENCHMARK_LINES, (uint64_t)EC_BENCHMARK_REPEAT);
+    ec_printf("%-28s %8.1f\r\n", "fprintf",
+              ec_benchmark_time(ec_benchmark_libc));
+    ec_printf("%-28s %8.1f\r\n", "ec_fprintf, constant format",
+              ec_benchmark_time(ec_benchmark_cached));
+    ec_printf("%-28s %8.1f\r\n", "ec_fprintf, parsed format",
+              ec_benchmark_time(ec_benchmark_parsed));
+    return 0;
+}
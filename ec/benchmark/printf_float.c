@@ -0,0 +1,177 @@
+/* <printf_float.c> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+/*
+ * Standalone microbenchmark of the %e, %g and %a conversions of ec_snprintf
+ * against snprintf. It is not a part of the library; configure with
+ * -DECLIBC_BUILD_BENCHMARKS=ON and run "ecBenchmarkPrintfFloat".
+ *
+ * "money" formats values with three decimals below 100000, "random" formats
+ * random finite bit patterns. The best of 5 runs over 4096 values is
+ * reported in ns per call, and the outputs of both are compared as well.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <ec/io.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#define EC_BENCHMARK_COUNT      4096
+#define EC_BENCHMARK_LOOPS      50
+#define EC_BENCHMARK_REPEAT     5
+
+static double ec_benchmark_money[EC_BENCHMARK_COUNT];
+static double ec_benchmark_random[EC_BENCHMARK_COUNT];
+static volatile char ec_benchmark_sink;
+
+static double ec_benchmark_now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+}
+
+/* Runs "statement" for every value EC_BENCHMARK_LOOPS times and keeps the
+ * best run of EC_BENCHMARK_REPEAT in "best". */
+#define EC_BENCHMARK_TIME(best, statement)                                     \
+    for(repeat = 0; repeat < EC_BENCHMARK_REPEAT; repeat++)                    \
+    {                                                                          \
+        start = ec_benchmark_now();                                            \
+        for(loop = 0; loop < EC_BENCHMARK_LOOPS; loop++)                       \
+        {                                                                      \
+            for(index = 0; index < EC_BENCHMARK_COUNT; index++)                \
+            {                                                                  \
+                statement;                                                     \
+            }                                                                  \
+        }                                                                      \
+        elapsed = ec_benchmark_now() - start;                                  \
+        if(elapsed < best)                                                     \
+            best = elapsed;                                                    \
+    }
+
+/* Defines ec_benchmark_<name>, which returns the best time of one call in
+ * ns, for ec_snprintf when "libc" is false and for snprintf otherwise. The
+ * snprintf run also counts the values the two format differently in
+ * "mismatches". */
+#define EC_BENCHMARK_PRINTF(name, format)                                      \
+    static double ec_benchmark_##name(const double *values, bool libc,         \
+                                      uint64_t *mismatches)                    \
+    {                                                                          \
+        char buffer[64];                                                       \
+        char expected[64];                                                     \
+        double best = 1e18;                                                    \
+        double start;                                                          \
+        double elapsed;                                                        \
+        int repeat;                                                            \
+        int loop;                                                              \
+        int index;                                                             \
+        if(libc)                                                               \
+        {                                                                      \
+            for(index = 0; index < EC_BENCHMARK_COUNT; index++)                \
+            {                                                                  \
+                snprintf(expected, sizeof(expected), format, values[index]);   \
+                ec_snprintf(buffer, sizeof(buffer), format, values[index]);    \
+                if(strcmp(buffer, expected) != 0)                              \
+                    (*mismatches)++;                                           \
+            }                                                                  \
+            EC_BENCHMARK_TIME(best,                                            \
+                snprintf(buffer, sizeof(buffer), format, values[index]);       \
+                ec_benchmark_sink = buffer[0])                                 \
+        }                                                                      \
+        else                                                                   \
+        {                                                                      \
+            EC_BENCHMARK_TIME(best,                                            \
+                ec_snprintf(buffer, sizeof(buffer), format, values[index]);    \
+                ec_benchmark_sink = buffer[0])                                 \
+        }                                                                      \
+        return best / (EC_BENCHMARK_LOOPS * (double)EC_BENCHMARK_COUNT);       \
+    }
+
+EC_BENCHMARK_PRINTF(e,   "%e")
+EC_BENCHMARK_PRINTF(g,   "%g")
+EC_BENCHMARK_PRINTF(g17, "%.17g")
+EC_BENCHMARK_PRINTF(a,   "%a")
+
+typedef double (*ec_benchmark_printf_t)(const double *values, bool libc,
+                                        uint64_t *mismatches);
+
+typedef struct
+{
+    const char *format;
+    ec_benchmark_printf_t function;
+} ec_benchmark_row;
+
+static const ec_benchmark_row ec_benchmark_rows[] =
+{
+    {"%e",    ec_benchmark_e},
+    {"%g",    ec_benchmark_g},
+    {"%.17g", ec_benchmark_g17},
+    {"%a",    ec_benchmark_a}
+};
+
+int main(void)
+{
+    uint64_t state = 88172645463325252ULL;
+    uint64_t mismatches = 0;
+    uint64_t bits;
+    const ec_benchmark_row *row;
+    size_t index;
+
+    for(index = 0; index < EC_BENCHMARK_COUNT; index++)
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        ec_benchmark_money[index] = (double)(state % 100000000) / 1000.0;
+        /* No infinities and NaNs. */
+        bits = state;
+        if(((bits >> 52) & 0x7FF) == 0x7FF)
+            bits ^= 1ULL << 62;
+        memcpy(&ec_benchmark_random[index], &bits, sizeof(bits));
+    }
+
+    ec_printf("eclibc: ec/benchmark/printf_float.c:\r\n");
+    ec_printf("ns per call, best of %llu runs, lower is better\r\n\r\n",
+              (uint64_t)EC_BENCHMARK_REPEAT);
+    ec_printf("%-7s %17s %17s\r\n", "", "money", "random");
+    ec_printf("%-7s %8s %8s %8s %8s\r\n", "", "eclibc", "snprintf",
+              "eclibc", "snprintf");
+    for(index = 0; index < sizeof(ec_benchmark_rows) /
+                           sizeof(ec_benchmark_rows[0]); index++)
+    {
+        row = &ec_benchmark_rows[index];
+        ec_printf("%-7s %8.1f %8.1f %8.1f %8.1f\r\n", row->format,
+                  row->function(ec_benchmark_money, false, &mismatches),
+                  row->function(ec_benchmark_money, true, &mismatches),
+                  row->function(ec_benchmark_random, false, &mismatches),
+                  row->function(ec_benchmark_random, true, &mismatches));
+    }
+    if(mismatches != 0)
+        ec_printf("\r\n%llu outputs of ec_snprintf and snprintf differ\r\n",
+                  mismatches);
+    return 0;
+}
@@ -0,0 +1,174 @@
+/* <strtod_throughput.c> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+/*
+ * Standalone throughput benchmark of ec_strtod against the C library's
+ * strtod. It is not a part of the library; configure with
+ * -DECLIBC_BUILD_BENCHMARKS=ON and run "ecBenchmarkStrtod".
+ *
+ * Each data set is parsed 10 times and the best run is reported, so run it
+ * on an otherwise idle machine. The results of both parsers are compared bit
+ * by bit as well.
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <ec/io.h>
+#include <ec/internal/text_parse/atof.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#define EC_BENCHMARK_COUNT      100000
+#define EC_BENCHMARK_REPEAT     10
+#define EC_BENCHMARK_MAX_LEN    32
+
+typedef double (*ec_benchmark_parser_t)(const char *str);
+
+static char ec_benchmark_data[EC_BENCHMARK_COUNT][EC_BENCHMARK_MAX_LEN];
+static double ec_benchmark_results[2][EC_BENCHMARK_COUNT];
+
+static uint64_t ec_benchmark_random(void)
+{
+    static uint64_t state = 88172645463325252ULL;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+}
+
+static double ec_benchmark_now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+static double ec_benchmark_libc(const char *str)
+{
+    return strtod(str, EC_NULL);
+}
+
+static double ec_benchmark_eclibc(const char *str)
+{
+    return ec_strtod(str, EC_NULL);
+}
+
+/* Fills the data set "kind": 0 for random bit patterns printed with %.17g,
+ * 1 for prices printed with %.2f and 2 for %.6f values around zero. */
+static void ec_benchmark_generate(int kind)
+{
+    uint64_t bits;
+    double value;
+    int index;
+    for(index = 0; index < EC_BENCHMARK_COUNT; index++)
+    {
+        bits = ec_benchmark_random();
+        if(kind == 0)
+        {
+            bits &= 0x7FEFFFFFFFFFFFFFULL;
+            memcpy(&value, &bits, sizeof(value));
+            snprintf(ec_benchmark_data[index], EC_BENCHMARK_MAX_LEN, "%.17g",
+                     value);
+        }
+        else
+        {
+            value = (double)(bits >> 11) / 9007199254740992.0 * 1000.0;
+            if(kind == 1)
+                snprintf(ec_benchmark_data[index], EC_BENCHMARK_MAX_LEN,
+                         "%.2f", value * 10.0);
+            else
+                snprintf(ec_benchmark_data[index], EC_BENCHMARK_MAX_LEN,
+                         "%.6f", value - 500.0);
+        }
+    }
+}
+
+/* Returns the best time of EC_BENCHMARK_REPEAT runs, in seconds. */
+static double ec_benchmark_run(ec_benchmark_parser_t parser, double *results)
+{
+    double best = 1e9;
+    double start;
+    double elapsed;
+    int repeat;
+    int index;
+    for(repeat = 0; repeat < EC_BENCHMARK_REPEAT; repeat++)
+    {
+        start = ec_benchmark_now();
+        for(index = 0; index < EC_BENCHMARK_COUNT; index++)
+            results[index] = parser(ec_benchmark_data[index]);
+        elapsed = ec_benchmark_now() - start;
+        if(elapsed < best)
+            best = elapsed;
+    }
+    return best;
+}
+
+int main(void)
+{
+    static const char *const kinds[] = {"random %.17g", "prices %.2f",
+                                        "values %.6f"};
+    static const char *const names[] = {"libc", "eclibc"};
+    ec_benchmark_parser_t parsers[2];
+    size_t bytes;
+    size_t mismatches;
+    double best;
+    int kind;
+    int parser;
+    int index;
+
+    parsers[0] = ec_benchmark_libc;
+    parsers[1] = ec_benchmark_eclibc;
+    ec_printf("eclibc: ec/benchmark/strtod_throughput.c:\r\n");
+    ec_printf("%llu numbers, best of %llu runs, lower ns is better\r\n\r\n",
+              (uint64_t)EC_BENCHMARK_COUNT, (uint64_t)EC_BENCHMARK_REPEAT);
+    for(kind = 0; kind < 3; kind++)
+    {
+        ec_benchmark_generate(kind);
+        bytes = 0;
+        for(index = 0; index < EC_BENCHMARK_COUNT; index++)
+            bytes += strlen(ec_benchmark_data[index]);
+        for(parser = 0; parser < 2; parser++)
+        {
+            best = ec_benchmark_run(parsers[parser],
+                                    ec_benchmark_results[parser]);
+            ec_printf("%-14s %-7s %7.1f ns/num %8.1f MB/s\r\n", kinds[kind],
+                      names[parser], best / EC_BENCHMARK_COUNT * 1e9,
+                      (double)bytes / best / 1e6);
+        }
+        mismatches = 0;
+        for(index = 0; index < EC_BENCHMARK_COUNT; index++)
+        {
+            if(memcmp(&ec_benchmark_results[0][index],
+                      &ec_benchmark_results[1][index], sizeof(double)) != 0)
+                mismatches++;
+        }
+        if(mismatches != 0)
+            ec_printf("%-14s %llu results differ from libc\r\n", kinds[kind],
+                      (uint64_t)mismatches);
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+/* <atoi.c> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ec/internal/text_parse/atoi.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Value of a digit character in the bases up to 36, or 36 and above if the
+ * character is not a digit. */
+static inline unsigned
+__attribute__ ((hot,always_inline))
+__ec_parse_digit_value(char ch)
+{
+    unsigned value = (unsigned)(unsigned char)ch - '0';
+    if(value < 10)
+        return value;
+    value = ((unsigned)(unsigned char)ch | 0x20U) - 'a';
+    return (value < 26) ? value + 10 : 36;
+}
+
+__attribute__((hot,noinline))
+ec_parse_status __ec_parse_digits(const char *ptr, size_t len, unsigned base,
+                                  uint64_t limit, uint64_t *value,
+                                  const char **end)
+{
+    const char *start = ptr;
+    const char *ptr_end = ptr + len;
+    uint64_t result = 0;
+    unsigned digit;
+    size_t digits = 0;
+    size_t safe_digits;
+    bool overflow = false;
+
+    *value = 0;
+    if(end != EC_NULL)
+        *end = ptr;
+    if(base < 2 || base > 36)
+        return EC_PARSE_INVALID_BASE;
+
+    /* Number of digits that can not overflow 64 bits, whatever they are. */
+    if(base == 10)
+    {
+        safe_digits = 19;
+        /* 8 digits per step, so up to 16 digits go through this loop. */
+        while(ptr_end - ptr >= 8 && digits + 8 <= safe_digits)
+        {
+            uint64_t chunk = __ec_parse_load8(ptr);
+            if(!__ec_parse_is_8_digits(chunk))
+                break;
+            result = result * 100000000U + __ec_parse_8_digits(chunk);
+            ptr += 8;
+            digits += 8;
+        }
+    }
+    else
+    {
+        unsigned bits = 1;
+        while((1U << bits) < base)
+            bits++;
+        safe_digits = 64 / bits - ((64 % bits == 0) ? 1 : 0);
+    }
+
+    for(; ptr < ptr_end; ptr++, digits++)
+    {
+        digit = __ec_parse_digit_value(*ptr);
+        if(digit >= base)
+            break;
+        if(digits >= safe_digits && !overflow)
+            overflow = (result > (UINT64_MAX - digit) / base);
+        if(!overflow)
+            result = result * base + digit;
+    }
+
+    if(end != EC_NULL)
+        *end = ptr;
+    if(ptr == start)
+        return EC_PARSE_NO_DIGITS;
+    if(overflow || result > limit)
+    {
+        *value = limit;
+        return EC_PARSE_OVERFLOW;
+    }
+    *value = result;
+    return EC_PARSE_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,230 @@
+/* <decimal.c> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ec/internal/decimal.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+void __ec_decimal_append(__ec_decimal *decimal, const char *ptr, size_t len,
+                         bool integer)
+{
+    for(; len > 0; ptr++, len--)
+    {
+        uint8_t digit = (uint8_t)(*ptr - '0');
+        if(decimal->count == 0 && digit == 0)
+        {
+            if(!integer)
+                decimal->point--;
+            continue;
+        }
+        if(decimal->count < __EC_DECIMAL_DIGITS)
+            decimal->digits[decimal->count++] = digit;
+        else if(digit != 0)
+            decimal->truncated = true;
+        if(integer)
+            decimal->point = decimal->count;
+    }
+}
+
+/* Divides the number by 2^shift. */
+static void
+__ec_decimal_right_shift(__ec_decimal *decimal, unsigned shift)
+{
+    const uint64_t mask = (1ULL << shift) - 1;
+    int read = 0;
+    int write = 0;
+    uint64_t number = 0;
+
+    for(; (number >> shift) == 0; read++)
+    {
+        if(read >= decimal->count)
+        {
+            if(number == 0)
+            {
+                decimal->count = 0;
+                return;
+            }
+            while((number >> shift) == 0)
+            {
+                number *= 10;
+                read++;
+            }
+            break;
+        }
+        number = number * 10 + decimal->digits[read];
+    }
+    decimal->point -= read - 1;
+
+    for(; read < decimal->count; read++)
+    {
+        decimal->digits[write++] = (uint8_t)(number >> shift);
+        number = (number & mask) * 10 + decimal->digits[read];
+    }
+    while(number > 0)
+    {
+        uint8_t digit = (uint8_t)(number >> shift);
+        if(write < __EC_DECIMAL_DIGITS)
+            decimal->digits[write++] = digit;
+        else if(digit > 0)
+            decimal->truncated = true;
+        number = (number & mask) * 10;
+    }
+    decimal->count = write;
+    __ec_decimal_trim(decimal);
+}
+
+/* Multiplies the number by 2^shift. */
+static void
+__ec_decimal_left_shift(__ec_decimal *decimal, unsigned shift)
+{
+    /* A shift of up to 60 bits adds at most 19 digits. */
+    uint8_t reversed[__EC_DECIMAL_DIGITS + 20];
+    int count = 0;
+    int read;
+    uint64_t number = 0;
+
+    for(read = decimal->count - 1; read >= 0; read--)
+    {
+        number += (uint64_t)decimal->digits[read] << shift;
+        reversed[count++] = (uint8_t)(number % 10);
+        number /= 10;
+    }
+    while(number > 0)
+    {
+        reversed[count++] = (uint8_t)(number % 10);
+        number /= 10;
+    }
+
+    decimal->point += count - decimal->count;
+    for(read = 0; read < count - __EC_DECIMAL_DIGITS; read++)
+    {
+        if(reversed[read] != 0)
+            decimal->truncated = true;
+    }
+    decimal->count = (count < __EC_DECIMAL_DIGITS) ? count :
+                                                     __EC_DECIMAL_DIGITS;
+    for(read = 0; read < decimal->count; read++)
+        decimal->digits[read] = reversed[count - 1 - read];
+    __ec_decimal_trim(decimal);
+}
+
+void __ec_decimal_shift(__ec_decimal *decimal, int shift)
+{
+    if(decimal->count == 0)
+        return;
+    for(; shift > __EC_DECIMAL_MAX_SHIFT; shift -= __EC_DECIMAL_MAX_SHIFT)
+        __ec_decimal_left_shift(decimal, __EC_DECIMAL_MAX_SHIFT);
+    for(; shift < -__EC_DECIMAL_MAX_SHIFT; shift += __EC_DECIMAL_MAX_SHIFT)
+        __ec_decimal_right_shift(decimal, __EC_DECIMAL_MAX_SHIFT);
+    if(shift > 0)
+        __ec_decimal_left_shift(decimal, (unsigned)shift);
+    else if(shift < 0)
+        __ec_decimal_right_shift(decimal, (unsigned)-shift);
+}
+
+uint64_t __ec_decimal_rounded_integer(const __ec_decimal *decimal)
+{
+    uint64_t result = 0;
+    int index;
+    bool round_up;
+
+    if(decimal->point > 20)
+        return UINT64_MAX;
+    for(index = 0; index < decimal->point && index < decimal->count; index++)
+        result = result * 10 + decimal->digits[index];
+    for(; index < decimal->point; index++)
+        result *= 10;
+
+    index = decimal->point;
+    if(index < 0 || index >= decimal->count)
+        round_up = false;
+    else if(decimal->digits[index] == 5 && index + 1 == decimal->count)
+        round_up = decimal->truncated ||
+                   (index > 0 && (decimal->digits[index - 1] & 1));
+    else
+        round_up = (decimal->digits[index] >= 5);
+    return result + (round_up ? 1 : 0);
+}
+
+void __ec_decimal_assign(__ec_decimal *decimal, uint64_t value)
+{
+    uint8_t reversed[20];
+    int count = 0;
+
+    while(value > 0)
+    {
+        reversed[count++] = (uint8_t)(value % 10);
+        value /= 10;
+    }
+    decimal->count = count;
+    decimal->point = count;
+    decimal->truncated = false;
+    for(int index = 0; index < count; index++)
+        decimal->digits[index] = reversed[count - 1 - index];
+    __ec_decimal_trim(decimal);
+}
+
+void __ec_decimal_round_up(__ec_decimal *decimal, int keep)
+{
+    int index;
+
+    if(keep <= 0)
+    {
+        /* Nothing is kept, so the result is the unit at that position. */
+        decimal->digits[0] = 1;
+        decimal->count = 1;
+        decimal->point = decimal->point - keep + 1;
+        return;
+    }
+    if(keep >= decimal->count)
+        return;
+
+    for(index = keep - 1; index >= 0 && decimal->digits[index] == 9; index--)
+        ;
+    if(index < 0)
+    {
+        /* 999 -> 1000 */
+        decimal->digits[0] = 1;
+        decimal->count = 1;
+        decimal->point++;
+        return;
+    }
+    decimal->digits[index]++;
+    decimal->count = index + 1;
+}
+
+void __ec_decimal_round_down(__ec_decimal *decimal, int keep)
+{
+    if(keep >= decimal->count)
+        return;
+    decimal->count = (keep > 0) ? keep : 0;
+    __ec_decimal_trim(decimal);
+}
+
+#ifdef __cplusplus
+}
+#endif
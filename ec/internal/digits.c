@@ -24,6 +24,13 @@
 
 /* Inclusion just to get compile messages for the inline functions inside the
  * file.                                                                      */
+#include <stdint.h>
+#include <ec/internal/text_parse/itoa.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 
 #ifdef __cplusplus
 extern "C"
@@ -42,6 +49,164 @@ const char __ec_lower_digits[36]
 const char __ec_upper_digits[36]
         = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
 
+/**
+ * @brief Decimal digit pairs "00" to "99".
+ */
+const char __ec_digit_pairs[200]
+        = "0001020304050607080910111213141516171819"
+          "2021222324252627282930313233343536373839"
+          "4041424344454647484950515253545556575859"
+          "6061626364656667686970717273747576777879"
+          "8081828384858687888990919293949596979899";
+
+/**
+ * @brief Lower-case hex digit pairs "00" to "ff".
+ */
+const char __ec_lower_hex_pairs[512]
+        = "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+          "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+          "404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+          "606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+          "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+          "a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+          "c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+          "e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+/**
+ * @brief Upper-case hex digit pairs "00" to "FF".
+ */
+const char __ec_upper_hex_pairs[512]
+        = "000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F"
+          "202122232425262728292A2B2C2D2E2F303132333435363738393A3B3C3D3E3F"
+          "404142434445464748494A4B4C4D4E4F505152535455565758595A5B5C5D5E5F"
+          "606162636465666768696A6B6C6D6E6F707172737475767778797A7B7C7D7E7F"
+          "808182838485868788898A8B8C8D8E8F909192939495969798999A9B9C9D9E9F"
+          "A0A1A2A3A4A5A6A7A8A9AAABACADAEAFB0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+          "C0C1C2C3C4C5C6C7C8C9CACBCCCDCECFD0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+          "E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEFF0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+
+/**
+ * @brief Powers of ten from 10^0 to 10^19.
+ */
+const uint64_t __ec_pow10_u64[20]
+        = {
+          UINT64_C(1),
+          UINT64_C(10),
+          UINT64_C(100),
+          UINT64_C(1000),
+          UINT64_C(10000),
+          UINT64_C(100000),
+          UINT64_C(1000000),
+          UINT64_C(10000000),
+          UINT64_C(100000000),
+          UINT64_C(1000000000),
+          UINT64_C(10000000000),
+          UINT64_C(100000000000),
+          UINT64_C(1000000000000),
+          UINT64_C(10000000000000),
+          UINT64_C(100000000000000),
+          UINT64_C(1000000000000000),
+          UINT64_C(10000000000000000),
+          UINT64_C(100000000000000000),
+          UINT64_C(1000000000000000000),
+          UINT64_C(10000000000000000000)
+          };
+
+#if defined(__SSE2__)
+/**
+ * @brief __ec_utoa10_8digits_sse2     Splits a value below 10^8 into its eight
+ *                                     decimal digits, one per 16 bit lane,
+ *                                     most significant first. The divisions
+ *                                     are done as multiplications by
+ *                                     reciprocals.
+ * @param [in]value     The value to be split.
+ * @return              The eight digits as 16 bit integers.
+ */
+static inline __m128i
+__attribute__ ((always_inline))
+__ec_utoa10_8digits_sse2 (uint32_t value)
+{
+    /* abcdefgh -> abcd, efgh: value / 10000 as (value * 0xd1b71759) >> 45. */
+    const __m128i div10000 = _mm_set1_epi32((int)0xd1b71759);
+    const __m128i mul10000 = _mm_set1_epi32(10000);
+    /* Reciprocals of 1000, 100, 10, 1 and the shifts that finish them. */
+    const __m128i div_powers = _mm_setr_epi16(8389, 5243, 13108,
+                                              (short)0x8000, 8389, 5243,
+                                              13108, (short)0x8000);
+    const __m128i shift_powers = _mm_setr_epi16(1 << 7, 1 << 11, 1 << 13,
+                                                (short)(1 << 15), 1 << 7,
+                                                1 << 11, 1 << 13,
+                                                (short)(1 << 15));
+    const __m128i ten = _mm_set1_epi16(10);
+
+    const __m128i abcdefgh = _mm_cvtsi32_si128((int)value);
+    const __m128i abcd = _mm_srli_epi64(_mm_mul_epu32(abcdefgh, div10000), 45);
+    const __m128i efgh = _mm_sub_epi32(abcdefgh, _mm_mul_epu32(abcd, mul10000));
+
+    /* Four copies of abcd * 4 and efgh * 4, one per digit position. */
+    const __m128i v1 = _mm_slli_epi64(_mm_unpacklo_epi16(abcd, efgh), 2);
+    const __m128i v2a = _mm_unpacklo_epi16(v1, v1);
+    const __m128i v2 = _mm_unpacklo_epi32(v2a, v2a);
+
+    /* a, ab, abc, abcd, e, ef, efg, efgh */
+    const __m128i v4 = _mm_mulhi_epu16(_mm_mulhi_epu16(v2, div_powers),
+                                       shift_powers);
+    /* 0, a0, ab0, abc0, 0, e0, ef0, efg0 */
+    const __m128i v6 = _mm_slli_epi64(_mm_mullo_epi16(v4, ten), 16);
+
+    return _mm_sub_epi16(v4, v6);
+}
+#endif
+
+void
+__ec_utoa10_u64_wide (uint64_t value, char *__restrict end, unsigned count)
+{
+#if defined(__SSE2__)
+    const __m128i zero_char = _mm_set1_epi8('0');
+    char temp[16];
+
+    if(count > 16)
+    {
+        /* Up to 4 leading digits, then two blocks of 8 written at once. */
+        uint64_t low = value % UINT64_C(10000000000000000);
+        uint32_t high = (uint32_t)(value / UINT64_C(10000000000000000));
+        __m128i upper = __ec_utoa10_8digits_sse2(
+                                     (uint32_t)(low / UINT64_C(100000000)));
+        __m128i lower = __ec_utoa10_8digits_sse2(
+                                     (uint32_t)(low % UINT64_C(100000000)));
+        __m128i digits = _mm_add_epi8(_mm_packus_epi16(upper, lower),
+                                      zero_char);
+
+        _mm_storeu_si128((__m128i *)(void *)(end - 16), digits);
+        __ec_utoa10_fill_u32(high, end - 16);
+        return;
+    }
+
+    /* 10 to 16 digits: convert all 16 positions, keep the significant ones. */
+    __m128i upper = __ec_utoa10_8digits_sse2(
+                                    (uint32_t)(value / UINT64_C(100000000)));
+    __m128i lower = __ec_utoa10_8digits_sse2(
+                                    (uint32_t)(value % UINT64_C(100000000)));
+    _mm_storeu_si128((__m128i *)(void *)temp,
+                     _mm_add_epi8(_mm_packus_epi16(upper, lower), zero_char));
+
+    end -= count;
+    for(unsigned i = 0; i < count; i++)
+        end[i] = temp[16 - count + i];
+#else
+    (void)count;
+    /* Two digits per step until the rest fits the 32 bit converter. */
+    while(value > UINT32_MAX)
+    {
+        uint32_t pair = (uint32_t)(value % 100) * 2;
+        value /= 100;
+        *--end = __ec_digit_pairs[pair + 1];
+        *--end = __ec_digit_pairs[pair];
+    }
+    __ec_utoa10_fill_u32((uint32_t)value, end);
+#endif
+}
+
 #ifdef __cplusplus
 }
 #endif
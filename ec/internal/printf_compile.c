@@ -0,0 +1,131 @@
+/* <printf_compile.c> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ec/internal/printf_compile.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+bool ec_printf_compile(ec_printf_format *compiled, const char *format)
+{
+    size_t length = strlen(format);
+    size_t count = 1;
+    const char *ptr = format;
+    const char *end = format + length;
+    char *copy;
+    __ec_printf_op *op;
+    /* Every '%' starts at most one specifier, so this is enough operations. */
+    while((ptr = (const char *)memchr(ptr, '%', (size_t)(end - ptr)))
+                                                                    != EC_NULL)
+    {
+        count++;
+        ptr++;
+    }
+    /* The operations and the copy of the format share a single allocation. */
+    op = (__ec_printf_op *)malloc(count * sizeof(__ec_printf_op) + length + 1);
+    if(op == EC_NULL)
+        return false;
+    copy = (char *)(op + count);
+    memcpy(copy, format, length + 1);
+    compiled->ops = op;
+    compiled->source = format;
+    compiled->handlers = __ec_printf_handlers_generation();
+    ptr = copy;
+    end = copy + length;
+    for(;;)
+    {
+        const char *spec = (const char *)memchr(ptr, '%', (size_t)(end - ptr));
+        op->literal = ptr;
+        if(spec == EC_NULL)
+        {
+            op->literal_len = (size_t)(end - ptr);
+            op->spec_len = 0;
+            op->spec = end;
+            op->handler = EC_NULL;
+            op->context = EC_NULL;
+            memset(&op->args, 0, sizeof(__ec_printf_args));
+            break;
+        }
+        op->literal_len = (size_t)(spec - ptr);
+        op->spec = spec;
+        ptr = __ec_printf_parse_format(spec, &op->args);
+        op->spec_len = (size_t)(ptr - spec);
+        op->handler = EC_NULL;
+        op->context = EC_NULL;
+        if(op->args.is_ec_format != 0)
+            op->handler = __ec_printf_find_handler(op->args.format_chr,
+                                                   &op->context);
+        op++;
+    }
+    compiled->count = (size_t)(op - compiled->ops) + 1;
+    return true;
+}
+
+void ec_printf_format_delete(ec_printf_format *compiled)
+{
+    free(compiled->ops);
+    compiled->ops = EC_NULL;
+    compiled->count = 0;
+}
+
+const ec_printf_format *__ec_printf_site_format(ec_printf_format **site,
+                                                        const char *format)
+{
+    ec_printf_format *compiled;
+#if !(defined(XC16) || defined(XC32))
+    ec_printf_format *expected = EC_NULL;
+    compiled = __atomic_load_n(site, __ATOMIC_ACQUIRE);
+#else
+    compiled = *site;
+#endif
+    if(compiled != EC_NULL)
+        return (compiled->source == format) ? compiled : EC_NULL;
+    compiled = (ec_printf_format *)malloc(sizeof(ec_printf_format));
+    if(compiled == EC_NULL)
+        return EC_NULL;
+    if(!ec_printf_compile(compiled, format))
+    {
+        free(compiled);
+        return EC_NULL;
+    }
+#if !(defined(XC16) || defined(XC32))
+    /* Another thread may have compiled the same site in the meantime. */
+    if(!__atomic_compare_exchange_n(site, &expected, compiled, false,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+    {
+        ec_printf_format_delete(compiled);
+        free(compiled);
+        return (expected->source == format) ? expected : EC_NULL;
+    }
+#else
+    *site = compiled;
+#endif
+    return compiled;
+}
+
+#ifdef __cplusplus
+}
+#endif
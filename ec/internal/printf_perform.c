@@ -0,0 +1,928 @@
+/* <printf_perform.c> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ec/internal/text_parse/printf_format.h>
+#include <ec/internal/text_parse/itoa.h>
+#include <ec/internal/text_parse/ftoa.h>
+#include <ec/internal/print_format_table.h>
+#include <ec/internal/printf_perform.h>
+#include <ec/internal/pad_string.h>
+#include <ec/internal/spad_string.h>
+#include <ec/internal/urlpad_string.h>
+#include <ec/strbuf.h>
+#include <ec/types.h>
+#include <ec/utf8.h>
+#include <ec/time.h>
+#include <errno.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* The values are printed using these. The URL variant percent-encodes them
+ * and ignores the field widths. The separators of the eclibc formats, e.g.
+ * the ':' of a MAC address, are appended as they are by both. */
+#define __ec_pad_string(__s, _pad, _padChar, _start, _end)                     \
+    do                                                                         \
+    {                                                                          \
+        if(__url)                                                              \
+            ec_urlpad_string(__s, _start, _end);                               \
+        else                                                                   \
+            ec_sfpad_string(__s, _pad, _padChar, _start, _end);                \
+    } while(0)
+
+#define __ec_pad_lenstr(__s, _pad, _padChar, _str, _len)                       \
+    do                                                                         \
+    {                                                                          \
+        if(__url)                                                              \
+            ec_urlpad_string(__s, _str, _str + strlen(_str));                  \
+        else                                                                   \
+            ec_spad_len_str(__s, _pad, _padChar, _str, _len);                  \
+    } while(0)
+
+#define __ec_pad_char(__s, _pad, _padChar, _chr)                               \
+    do                                                                         \
+    {                                                                          \
+        if(__url)                                                              \
+            ec_urlpad_character(__s, _chr);                                    \
+        else                                                                   \
+            ec_spad_character(__s, _pad, _padChar, _chr);                      \
+    } while(0)
+
+#define __ec_pad_number(__s, _pad, _padChar, _start, _split, _end, _zeros)     \
+    do                                                                         \
+    {                                                                          \
+        if(__url)                                                              \
+        {                                                                      \
+            ec_urlpad_string(__s, _start, _split);                             \
+            ec_strbuf_append_repeat(__s, '0', _zeros);                         \
+            ec_urlpad_string(__s, _split, _end);                               \
+        }                                                                      \
+        else                                                                   \
+            ec_sfpad_number(__s, _pad, _padChar, _start, _split, _end, _zeros);\
+    } while(0)
+
+#define __ec_printf_int(_type, _base, _upperCase)                              \
+    {                                                                          \
+        __ec_printf_numBuffer = ec_itoa_##_type (EC_SCRATCH_1(_type),          \
+                        __ec_printf_numBuffer_End, _base, _upperCase);         \
+        __ec_printf_numBuffer = ec_pad_num_string(                             \
+                                              __ec_args->NumberRight,          \
+                    __ec_printf_numBuffer, __ec_printf_numBuffer_End);         \
+        __ec_pad_string(__s, __ec_args->NumberLeft, ' ',                   \
+                    __ec_printf_numBuffer, __ec_printf_numBuffer_End);         \
+    }
+
+#define __ec_printf_string()                                                   \
+    {                                                                          \
+        size_t __temp = strlen(EC_SCRATCH_1(char *));                          \
+        if(__ec_args->NumberRight == 0 ||                                      \
+                                     (size_t)__ec_args->NumberRight > __temp)  \
+            __ec_args->NumberRight = (int)__temp;                              \
+        __ec_pad_string(__s, __ec_args->NumberLeft, ' ',                   \
+                                                      EC_SCRATCH_1(char *),    \
+                             (EC_SCRATCH_1(char *) + __ec_args->NumberRight)); \
+    }
+
+#define __ec_printf_double()                                                   \
+    {                                                                          \
+        char __ec_ftoa_storage[EC_FTOA_FIXED_SIZE(EC_FTOA_MAX_PRECISION)];     \
+        char *__ec_ftoa_end = __ec_ftoa_storage +                              \
+                                    EC_FTOA_FIXED_SIZE(EC_FTOA_MAX_PRECISION); \
+        char *__ec_ftoa_split = EC_NULL;                                       \
+        int __ec_ftoa_zeros = 0;                                               \
+        if(__ec_args->NumberRight > EC_FTOA_MAX_PRECISION)                     \
+        {                                                                      \
+            __ec_ftoa_zeros = __ec_args->NumberRight - EC_FTOA_MAX_PRECISION;  \
+            __ec_args->NumberRight = EC_FTOA_MAX_PRECISION;                    \
+        }                                                                      \
+        __ec_printf_numBuffer = ec_double_to_printf(EC_SCRATCH_1(double),      \
+                                         __ec_ftoa_end, __ec_args->NumberRight,\
+                                                      __ec_args->format_chr);  \
+        if(__ec_ftoa_zeros != 0)                                               \
+            __ec_ftoa_split = ec_ftoa_fraction_end(__ec_printf_numBuffer,      \
+                                       __ec_ftoa_end, __ec_args->format_chr);  \
+        if(__ec_ftoa_split == EC_NULL)                                         \
+        {                                                                      \
+            __ec_ftoa_split = __ec_ftoa_end;                                   \
+            __ec_ftoa_zeros = 0;                                               \
+        }                                                                      \
+        __ec_pad_number(__s, __ec_args->NumberLeft, ' ',                       \
+                        __ec_printf_numBuffer, __ec_ftoa_split,                \
+                        __ec_ftoa_end, (size_t)__ec_ftoa_zeros);               \
+    }
+
+#define __ec_printf_digits(value, digitsCount)                                 \
+    {                                                                          \
+        __ec_printf_numBuffer = ec_itoa_uint64_t ((uint64_t)value,             \
+                        __ec_printf_numBuffer_End, 10, 0);                     \
+        __ec_printf_numBuffer = ec_pad_num_string(digitsCount,                 \
+                    __ec_printf_numBuffer, __ec_printf_numBuffer_End);         \
+        __ec_pad_string(__s, 0, ' ', __ec_printf_numBuffer,                \
+                                                   __ec_printf_numBuffer_End); \
+    }
+
+/* The handlers of the "%!" specifiers, indexed by their character. */
+typedef struct
+{
+    ec_printf_handler_t handler;
+    void               *context;
+} __ec_printf_handler_entry;
+
+static __ec_printf_handler_entry __ec_printf_handlers[256];
+
+/* Counts the changes of the table, see __ec_printf_handlers_generation. */
+static unsigned __ec_printf_handlers_changes;
+
+bool ec_printf_register(char specifier, ec_printf_handler_t handler,
+                                                                void *context)
+{
+    if(specifier == '\0' || strchr("%^+-*.0123456789hlLq", specifier))
+        return false;
+    __ec_printf_handlers[(uint8_t)specifier].context = context;
+    __ec_printf_handlers[(uint8_t)specifier].handler = handler;
+    __ec_printf_handlers_changes++;
+    return true;
+}
+
+ec_printf_handler_t __ec_printf_find_handler(char specifier, void **context)
+{
+    *context = __ec_printf_handlers[(uint8_t)specifier].context;
+    return __ec_printf_handlers[(uint8_t)specifier].handler;
+}
+
+unsigned __ec_printf_handlers_generation(void)
+{
+    return __ec_printf_handlers_changes;
+}
+
+/* Hands the URL engine's output of a handler to the encoder. */
+static bool __ec_printf_url_sink(void *context, const char *data, size_t len)
+{
+    return ec_strbuf_append_url_encoded((ec_strbuf *)context, data, len,
+                                                            EC_URL_COMPONENT);
+}
+
+/* Prints the "%!x", "%!X" and "%!e" buffers. */
+static void
+__ec_printf_bytes(ec_strbuf *__restrict __s,
+                  const __ec_printf_args *__restrict __ec_args,
+                  const void *bytes, size_t len)
+{
+    if(__ec_args->format_chr == eclibc_printf_hex)
+        ec_strbuf_append_hex(__s, bytes, len, __ec_args->alternateForm);
+    else if(__ec_args->format_chr == eclibc_printf_hexdump)
+        ec_strbuf_append_hexdump(__s, bytes, len, __ec_args->alternateForm
+                                    ? EC_HEXDUMP_CLASSIC : EC_HEXDUMP_SPACED);
+    else
+        ec_strbuf_append_base64(__s, bytes, len, __ec_args->alternateForm
+                                    ? EC_BASE64_URL : EC_BASE64_STANDARD);
+}
+
+static bool
+__ec_printf_call_handler(ec_strbuf *__restrict __s,
+                         __ec_printf_args *__restrict __ec_args,
+                         va_list *__arg, const bool __url)
+{
+    const __ec_printf_handler_entry *entry =
+                    &__ec_printf_handlers[(uint8_t)__ec_args->format_chr];
+    char storage[64];
+    ec_strbuf encoder;
+    bool result;
+    if(!__url)
+        return entry->handler(__s, __ec_args, __arg, entry->context);
+    ec_strbuf_init_sink(&encoder, storage, sizeof(storage),
+                                                    __ec_printf_url_sink, __s);
+    result = entry->handler(&encoder, __ec_args, __arg, entry->context);
+    ec_strbuf_flush(&encoder);
+    return result;
+}
+
+static inline bool
+__attribute__ ((hot,always_inline))
+__ec_printf_perform_internal(ec_strbuf *__restrict __s,
+                          __ec_printf_args *__restrict __ec_args,
+                          va_list *__arg, const bool __url,
+                          const bool __handlers)
+{
+    /* as much to satisfy a 64 bit binary and more */
+    char NumBuffer_Storage[81];
+    struct tm __ec_scratch_memory;
+    char * __restrict __ec_printf_numBuffer_End = NumBuffer_Storage + 80;
+    char * __restrict __ec_printf_numBuffer;
+    *__ec_printf_numBuffer_End = '\0';
+    #define EC_SCRATCH_1(type) *((type *)(&__ec_scratch_memory))
+    /*
+    #define EC_SCRATCH_2(type) *((type *)((&__ec_scratch_memory) + 8))
+    */
+    if(__ec_args->is_ec_format == 0)
+    {
+        switch(__ec_args->format_chr)
+        {
+            case glibc_printf_form_float_E:
+            case glibc_printf_form_float_e:
+            case glibc_printf_form_float_F:
+            case glibc_printf_form_float_f:
+            case glibc_printf_form_float_G:
+            case glibc_printf_form_float_g:
+            case glibc_printf_form_floathex_Cap:
+            case glibc_printf_form_float_hex_Lower:
+            {
+                /* ec_double_to_printf picks the default precision */
+                if((__ec_args->NumSeen & 2) == 0)
+                    __ec_args->NumberRight = -1;
+                EC_SCRATCH_1(double) = va_arg(*__arg, double);
+                __ec_printf_double();
+                return true;
+            }
+
+            case glibc_printf_form_percent:
+                __ec_pad_char(__s, 0, ' ', '%');
+                return true;
+
+            case glibc_printf_form_character:
+            {
+                __ec_pad_char(__s, __ec_args->NumberLeft, ' ',
+                                                   (char)(va_arg(*__arg, int)));
+                return true;
+            }
+
+            case glibc_printf_form_strerror:
+            {
+                EC_SCRATCH_1(char *) = strerror(errno);
+                __ec_printf_string();
+                return true;
+            }
+
+            case glibc_printf_form_string_1:
+            case glibc_printf_form_string_2:
+            {
+                EC_SCRATCH_1(char *) = va_arg(*__arg, char *);
+                __ec_printf_string();
+                return true;
+            }
+
+            case glibc_printf_form_integer_1:
+            case glibc_printf_form_integer_2:
+            {
+                switch(__ec_args->Size)
+                {
+                    case 0:
+                        EC_SCRATCH_1(int8_t) = (int8_t)va_arg(*__arg, int);
+                        __ec_printf_int(int8_t, 10, 0);
+                        return true;
+                    case 1:
+                        EC_SCRATCH_1(int16_t)
+                                          = (int16_t)va_arg(*__arg, int);
+                        __ec_printf_int(int16_t, 10, 0);
+                        return true;
+                    case 2:
+                        EC_SCRATCH_1(int32_t) = va_arg(*__arg, int32_t);
+                        __ec_printf_int(int32_t, 10, 0);
+                        return true;
+                    default:
+                        EC_SCRATCH_1(int64_t) = va_arg(*__arg, int64_t);
+                        __ec_printf_int(int64_t, 10, 0);
+                        return true;
+                };
+                return true;
+            }
+
+            case glibc_printf_form_size_t_1:
+            case glibc_printf_form_size_t_2:
+            case glibc_printf_form_pointer:
+            case glibc_printf_mod_ptrdiff_t:
+            {
+                EC_SCRATCH_1(uint64_t) = va_arg(*__arg, uint64_t);
+                if(EC_SCRATCH_1(int) == 0)
+                    __ec_pad_lenstr(__s, __ec_args->NumberLeft,
+                                                            ' ', "False", 5);
+                else
+                    __ec_pad_lenstr(__s, __ec_args->NumberLeft,
+                                                            ' ', "True", 4);
+                return true;
+            }
+
+            case glibc_printf_form_unsigned:
+            {
+                switch(__ec_args->Size)
+                {
+                    case 0:
+                        EC_SCRATCH_1(uint8_t) = (uint8_t)va_arg(*__arg, int);
+                        __ec_printf_int(uint8_t, 10, 0);
+                        return true;
+                    case 1:
+                        EC_SCRATCH_1(uint16_t)
+                                          = (uint16_t)va_arg(*__arg, int);
+                        __ec_printf_int(uint16_t, 10, 0);
+                        return true;
+                    case 2:
+                        EC_SCRATCH_1(uint32_t) = va_arg(*__arg, uint32_t);
+                        __ec_printf_int(uint32_t, 10, 0);
+                        return true;
+                    default:
+                        EC_SCRATCH_1(uint64_t) = va_arg(*__arg, uint64_t);
+                        __ec_printf_int(uint64_t, 10, 0);
+                        return true;
+                };
+                return true;
+            }
+
+            case glibc_printf_form_octal:
+            {
+                switch(__ec_args->Size)
+                {
+                    case 0:
+                        EC_SCRATCH_1(uint8_t) = (uint8_t)va_arg(*__arg, int);
+                        __ec_printf_int(uint8_t, 8, 0);
+                        return true;
+                    case 1:
+                        EC_SCRATCH_1(uint16_t)
+                                          = (uint16_t)va_arg(*__arg, int);
+                        __ec_printf_int(uint16_t, 8, 0);
+                        return true;
+                    case 2:
+                        EC_SCRATCH_1(uint32_t) = va_arg(*__arg, uint32_t);
+                        __ec_printf_int(uint32_t, 8, 0);
+                        return true;
+                    default:
+                        EC_SCRATCH_1(uint64_t) = va_arg(*__arg, uint64_t);
+                        __ec_printf_int(uint64_t, 8, 0);
+                        return true;
+                };
+                return true;
+            }
+
+            case glibc_printf_form_hexa_Cap:
+            case glibc_printf_form_hexa_Lower:
+            {
+                switch(__ec_args->Size)
+                {
+                    case 0:
+                        EC_SCRATCH_1(uint8_t) = (uint8_t)va_arg(*__arg, int);
+                        __ec_printf_int(uint8_t, 16, (__ec_args->format_chr
+                                        == glibc_printf_form_hexa_Cap) ? 1 : 0);
+                        return true;
+                    case 1:
+                        EC_SCRATCH_1(uint16_t)
+                                          = (uint16_t)va_arg(*__arg, int);
+                        __ec_printf_int(uint16_t, 16, (__ec_args->format_chr
+                                        == glibc_printf_form_hexa_Cap) ? 1 : 0);
+                        return true;
+                    case 2:
+                        EC_SCRATCH_1(uint32_t) = va_arg(*__arg, uint32_t);
+                        __ec_printf_int(uint32_t, 16, (__ec_args->format_chr
+                                        == glibc_printf_form_hexa_Cap) ? 1 : 0);
+                        return true;
+                    default:
+                        EC_SCRATCH_1(uint64_t) = va_arg(*__arg, uint64_t);
+                        __ec_printf_int(uint64_t, 16, (__ec_args->format_chr
+                                        == glibc_printf_form_hexa_Cap) ? 1 : 0);
+                        return true;
+                };
+                return true;
+            }
+
+
+            default:
+                return false;
+        };
+    }
+    else
+    {
+        if(__handlers &&
+           __ec_printf_handlers[(uint8_t)__ec_args->format_chr].handler
+                                                                    != EC_NULL)
+            return __ec_printf_call_handler(__s, __ec_args, __arg, __url);
+        switch(__ec_args->format_chr)
+        {
+            case glibc_printf_form_percent:
+                ec_strbuf_append_char(__s, '%');
+                return true;
+
+            case eclibc_printf_bool:
+            {
+                EC_SCRATCH_1(int) = va_arg(*__arg, int);
+                if(EC_SCRATCH_1(int) == 0)
+                    __ec_pad_lenstr(__s, __ec_args->NumberLeft,
+                                                            ' ', "False", 5);
+                else
+                    __ec_pad_lenstr(__s, __ec_args->NumberLeft,
+                                                            ' ', "True", 4);
+                return true;
+            }
+
+            case eclibc_printf_double_shortest:
+            {
+                char tempDouble[EC_FTOA_SHORTEST_SIZE];
+                char *__restrict double_head = tempDouble +
+                                                        EC_FTOA_SHORTEST_SIZE;
+                if(__ec_args->Size == 0)
+                    double_head = ec_float_to_shortest(
+                                      (float)va_arg(*__arg, double),
+                                      double_head, __ec_args->alternateForm);
+                else
+                    double_head = ec_double_to_shortest(va_arg(*__arg, double),
+                                      double_head, __ec_args->alternateForm);
+                __ec_pad_string(__s, __ec_args->NumberLeft, ' ', double_head,
+                                          tempDouble + EC_FTOA_SHORTEST_SIZE);
+                return true;
+            }
+
+            case eclibc_printf_hex:
+            case eclibc_printf_hexdump:
+            case eclibc_printf_base64:
+            {
+                const void *bytes = va_arg(*__arg, const void *);
+                size_t len = va_arg(*__arg, size_t);
+                char storage[64];
+                ec_strbuf encoder;
+                if((__ec_args->NumSeen & 2) && __ec_args->NumberRight >= 0 &&
+                                        (size_t)__ec_args->NumberRight < len)
+                    len = (size_t)__ec_args->NumberRight;
+                if(!__url)
+                {
+                    __ec_printf_bytes(__s, __ec_args, bytes, len);
+                    return true;
+                }
+                ec_strbuf_init_sink(&encoder, storage, sizeof(storage),
+                                                    __ec_printf_url_sink, __s);
+                __ec_printf_bytes(&encoder, __ec_args, bytes, len);
+                ec_strbuf_flush(&encoder);
+                return true;
+            }
+
+            case eclibc_printf_utf8:
+            {
+                char UTF8_temp[5];
+                EC_SCRATCH_1(ec_utf8_t) = va_arg(*__arg, ec_utf8_t);
+                ea_utf8_decode(EC_SCRATCH_1(ec_utf8_t), UTF8_temp);
+                __ec_pad_lenstr(__s, __ec_args->NumberLeft,
+                                                            ' ', UTF8_temp, 1);
+                return true;
+            }
+
+            case eclibc_printf_phone_number:
+            {
+                char tempPhone[20];
+                char *__restrict phoneHead = tempPhone + 19;
+                if(__ec_args->NumberLeft < 1)
+                    __ec_args->NumberLeft = 12;
+                else if(__ec_args->NumberLeft > 19)
+                    __ec_args->NumberLeft = 19;
+                tempPhone[19] = '\0';
+                EC_SCRATCH_1(uint64_t) = va_arg(*__arg, uint64_t);
+                phoneHead = ec_itoa_uint64_t(EC_SCRATCH_1(uint64_t),
+                                                              phoneHead, 10, 1);
+                if(phoneHead < (tempPhone + 19 - __ec_args->NumberLeft))
+                    phoneHead = (tempPhone + 19 - __ec_args->NumberLeft);
+                ec_strbuf_append_char(__s, '+');
+                __ec_pad_string(__s, __ec_args->NumberLeft, '0',
+                                                phoneHead, (tempPhone + 19));
+                return true;
+            }
+
+            case eclibc_printf_IPv4_Address:
+            {
+                char tempIP[17];
+                char *__restrict IP_head = tempIP + 16;
+                if(__ec_args->alternateForm)
+                    (EC_SCRATCH_1(ec_ipv4_t)).IP = va_arg(*__arg, uint32_t);
+                else
+                    (EC_SCRATCH_1(ec_ipv4_t))    = va_arg(*__arg, ec_ipv4_t);
+                tempIP[16] = '\0';
+                #define __EC_PRINTF_READ_NUM(INDEX)                            \
+                IP_head = ec_itoa_uint8_t(                                     \
+                        (EC_SCRATCH_1(ec_ipv4_t)).display_string.byte##INDEX , \
+                                IP_head, 10, 1);
+                __EC_PRINTF_READ_NUM(4);
+                *--IP_head = '.';
+                __EC_PRINTF_READ_NUM(3);
+                *--IP_head = '.';
+                __EC_PRINTF_READ_NUM(2);
+                *--IP_head = '.';
+                __EC_PRINTF_READ_NUM(1);
+                #undef __EC_PRINTF_READ_NUM
+                __ec_pad_string(__s, __ec_args->NumberLeft, ' ',
+                                IP_head, tempIP + 16);
+                return true;
+            }
+
+            case eclibc_printf_IPv6_Address:
+            {
+                char tempIP[41];
+                char *__restrict IP_head = tempIP + 40;
+                (EC_SCRATCH_1(ec_ipv6_t)) = va_arg(*__arg, ec_ipv6_t);
+                tempIP[40] = '\0';
+                #define __EC_PRINTF_READ_NUM(INDEX)                            \
+                IP_head = ec_itoa_uint16_t(                                    \
+                        (EC_SCRATCH_1(ec_ipv6_t)).display_string.byte##INDEX , \
+                                IP_head, 16, __ec_args->alternateForm);
+                __EC_PRINTF_READ_NUM(8); *--IP_head = ':';
+                __EC_PRINTF_READ_NUM(7); *--IP_head = ':';
+                __EC_PRINTF_READ_NUM(6); *--IP_head = ':';
+                __EC_PRINTF_READ_NUM(5); *--IP_head = ':';
+                __EC_PRINTF_READ_NUM(4); *--IP_head = ':';
+                __EC_PRINTF_READ_NUM(3); *--IP_head = ':';
+                __EC_PRINTF_READ_NUM(2); *--IP_head = ':';
+                __EC_PRINTF_READ_NUM(1);
+                #undef __EC_PRINTF_READ_NUM
+                __ec_pad_string(__s, __ec_args->NumberLeft, ' ',
+                                IP_head, tempIP + 40);
+                return true;
+            }
+
+            case eclibc_printf_MAC_PC_Version:
+            case eclibc_printf_MAC_PC_Version_caps:
+            {
+                char tempMAC[3];
+                char *__restrict MAC_head;
+                if(__ec_args->alternateForm)
+                    (EC_SCRATCH_1(ec_mac_t)).MAC = va_arg(*__arg, uint64_t);
+                else
+                    (EC_SCRATCH_1(ec_mac_t))     = va_arg(*__arg, ec_mac_t);
+                tempMAC[2] = '\0';
+                #define __EC_PRINTF_PRINT_NUM(INDEX)                           \
+                MAC_head = tempMAC + 2;                                        \
+                MAC_head = ec_itoa_uint8_t(                                    \
+                        (EC_SCRATCH_1(ec_mac_t)).display_string.byte##INDEX ,  \
+                                MAC_head, 16, ((__ec_args->format_chr ==       \
+                                 eclibc_printf_MAC_PC_Version_caps) ? 1 : 0)); \
+                __ec_pad_string(__s, 2, ' ', MAC_head, tempMAC + 2);
+
+                __EC_PRINTF_PRINT_NUM(1);
+                ec_strbuf_append_char(__s, ':');
+                __EC_PRINTF_PRINT_NUM(2);
+                ec_strbuf_append_char(__s, ':');
+                __EC_PRINTF_PRINT_NUM(3);
+                ec_strbuf_append_char(__s, ':');
+                __EC_PRINTF_PRINT_NUM(4);
+                ec_strbuf_append_char(__s, ':');
+                __EC_PRINTF_PRINT_NUM(5);
+                ec_strbuf_append_char(__s, ':');
+                __EC_PRINTF_PRINT_NUM(6);
+
+                #undef __EC_PRINTF_PRINT_NUM
+                return true;
+            }
+
+            case eclibc_printf_MAC_CISCO:
+            case eclibc_printf_MAC_CISCO_caps:
+            {
+                char tempMAC[5];
+                char *__restrict MAC_head;
+                if(__ec_args->alternateForm)
+                    (EC_SCRATCH_1(ec_mac_t)).MAC = va_arg(*__arg, uint64_t);
+                else
+                    (EC_SCRATCH_1(ec_mac_t))     = va_arg(*__arg, ec_mac_t);
+                tempMAC[4] = '\0';
+                #define __EC_PRINTF_PRINT_NUM(INDEX)                           \
+                MAC_head = tempMAC + 4;                                        \
+                MAC_head = ec_itoa_uint16_t(                                   \
+                        (EC_SCRATCH_1(ec_mac_t)).cisco_string.byte##INDEX ,    \
+                                MAC_head, 16, ((__ec_args->format_chr ==       \
+                                      eclibc_printf_MAC_CISCO_caps) ? 1 : 0)); \
+                __ec_pad_string(__s, 3, ' ', MAC_head, tempMAC + 4);
+
+                __EC_PRINTF_PRINT_NUM(1);
+                ec_strbuf_append_char(__s, '.');
+                __EC_PRINTF_PRINT_NUM(2);
+                ec_strbuf_append_char(__s, '.');
+                __EC_PRINTF_PRINT_NUM(3);
+
+                #undef __EC_PRINTF_PRINT_NUM
+                return true;
+            }
+
+            case eclibc_printf_base_2:
+            {
+                switch(__ec_args->Size)
+                {
+                    case 0:
+                        EC_SCRATCH_1(uint8_t) = (uint8_t)va_arg(*__arg, int);
+                        __ec_printf_int(uint8_t, 2, 0);
+                        return true;
+                    case 1:
+                        EC_SCRATCH_1(uint16_t)
+                                          = (uint16_t)va_arg(*__arg, int);
+                        __ec_printf_int(uint16_t, 2, 0);
+                        return true;
+                    case 2:
+                        EC_SCRATCH_1(uint32_t) = va_arg(*__arg, uint32_t);
+                        __ec_printf_int(uint32_t, 2, 0);
+                        return true;
+                    default:
+                        EC_SCRATCH_1(uint64_t) = va_arg(*__arg, uint64_t);
+                        __ec_printf_int(uint64_t, 2, 0);
+                        return true;
+                };
+                return true;
+            }
+
+            case eclibc_printf_base_8:
+            {
+                switch(__ec_args->Size)
+                {
+                    case 0:
+                        EC_SCRATCH_1(uint8_t) = (uint8_t)va_arg(*__arg, int);
+                        __ec_printf_int(uint8_t, 8, 0);
+                        return true;
+                    case 1:
+                        EC_SCRATCH_1(uint16_t)
+                                          = (uint16_t)va_arg(*__arg, int);
+                        __ec_printf_int(uint16_t, 8, 0);
+                        return true;
+                    case 2:
+                        EC_SCRATCH_1(uint32_t) = va_arg(*__arg, uint32_t);
+                        __ec_printf_int(uint32_t, 8, 0);
+                        return true;
+                    default:
+                        EC_SCRATCH_1(uint64_t) = va_arg(*__arg, uint64_t);
+                        __ec_printf_int(uint64_t, 8, 0);
+                        return true;
+                };
+                return true;
+            }
+
+            case eclibc_printf_base_16:
+            {
+                switch(__ec_args->Size)
+                {
+                    case 0:
+                        EC_SCRATCH_1(uint8_t) = (uint8_t)va_arg(*__arg, int);
+                        __ec_printf_int(uint8_t, 16,
+                                       (__ec_args->alternateForm == 1) ? 1 : 0);
+                        return true;
+                    case 1:
+                        EC_SCRATCH_1(uint16_t)
+                                          = (uint16_t)va_arg(*__arg, int);
+                        __ec_printf_int(uint16_t, 16,
+                                       (__ec_args->alternateForm == 1) ? 1 : 0);
+                        return true;
+                    case 2:
+                        EC_SCRATCH_1(uint32_t) = va_arg(*__arg, uint32_t);
+                        __ec_printf_int(uint32_t, 16,
+                                       (__ec_args->alternateForm == 1) ? 1 : 0);
+                        return true;
+                    default:
+                        EC_SCRATCH_1(uint64_t) = va_arg(*__arg, uint64_t);
+                        __ec_printf_int(uint64_t, 16,
+                                       (__ec_args->alternateForm == 1) ? 1 : 0);
+                        return true;
+                };
+                return true;
+            }
+
+            case eclibc_printf_Time_struct_tm:
+            case eclibc_printf_time_struct_tm_short:
+            {
+                char mode[4] = "";
+                __ec_scratch_memory = va_arg(*__arg, struct tm);
+                if(__ec_args->alternateForm == 1)
+                {
+                    mode[0] = ' ';
+                    mode[2] = 'M';
+                    mode[3] = '\0';
+                    if(__ec_scratch_memory.tm_hour > 12)
+                    {
+                        __ec_scratch_memory.tm_hour -= 12;
+                        mode[1] = 'P';
+                    }
+                    else
+                        mode[1] = 'A';
+                }
+                __ec_printf_digits(__ec_scratch_memory.tm_hour, 2);
+                ec_strbuf_append_char(__s, ':');
+                __ec_printf_digits(__ec_scratch_memory.tm_min, 2);
+                if(__ec_args->format_chr == eclibc_printf_Time_struct_tm)
+                {
+                    ec_strbuf_append_char(__s, ':');
+                    __ec_printf_digits(__ec_scratch_memory.tm_sec, 2);
+                }
+                ec_strbuf_append(__s, mode);
+                return true;
+            }
+
+            case eclibc_printf_time_seconds:
+            case eclibc_printf_time_seconds_short:
+            {
+                char mode[4] = "";
+                uint32_t tempInt = va_arg(*__arg, uint32_t);
+                __ec_scratch_memory.tm_hour = (int)(tempInt / 3600);
+                __ec_scratch_memory.tm_min  = (int)((tempInt % 3600) / 60);
+                __ec_scratch_memory.tm_sec  = (int)(tempInt % 60);
+                if(__ec_args->alternateForm == 1)
+                {
+                    mode[0] = ' ';
+                    mode[2] = 'M';
+                    mode[3] = '\0';
+                    if(__ec_scratch_memory.tm_hour > 12)
+                    {
+                        __ec_scratch_memory.tm_hour -= 12;
+                        mode[1] = 'P';
+                    }
+                    else
+                        mode[1] = 'A';
+                }
+                __ec_printf_digits(__ec_scratch_memory.tm_hour, 2);
+                ec_strbuf_append_char(__s, ':');
+                __ec_printf_digits(__ec_scratch_memory.tm_min, 2);
+                if(__ec_args->format_chr == eclibc_printf_time_seconds)
+                {
+                    ec_strbuf_append_char(__s, ':');
+                    __ec_printf_digits(__ec_scratch_memory.tm_sec, 2);
+                }
+                ec_strbuf_append(__s, mode);
+                return true;
+            }
+
+            case eclibc_printf_date_2digit:
+            case eclibc_printf_date_4digit:
+            {
+                __ec_scratch_memory = va_arg(*__arg, struct tm);
+                __ec_scratch_memory.tm_year += 1900;
+                if(__ec_args->alternateForm == 1)
+                {
+                    ec_strbuf_append(__s,
+                                    ec_month_name_str[__ec_scratch_memory.tm_mon]);
+                    ec_strbuf_append_char(__s, ' ');
+                    __ec_printf_digits(__ec_scratch_memory.tm_mday, 2);
+                    if(__ec_scratch_memory.tm_mday > 3 &&
+                            __ec_scratch_memory.tm_mday <= 20)
+                        ec_strbuf_append_n(__s, "th ", 3);
+                    else if(__ec_scratch_memory.tm_mday % 10 == 1)
+                        ec_strbuf_append_n(__s, "st ", 3);
+                    else if(__ec_scratch_memory.tm_mday % 10 == 2)
+                        ec_strbuf_append_n(__s, "nd ", 3);
+                    else
+                        ec_strbuf_append_n(__s, "th ", 3);
+                    __ec_printf_digits(__ec_scratch_memory.tm_year,
+                                         ((__ec_args->format_chr ==
+                                               eclibc_printf_date_4digit)
+                                                                      ? 4 : 2));
+                }
+                else
+                {
+                    __ec_printf_digits(__ec_scratch_memory.tm_mday, 2);
+                    ec_strbuf_append_char(__s, '/');
+                    __ec_printf_digits((__ec_scratch_memory.tm_mon + 1), 2);
+                    ec_strbuf_append_char(__s, '/');
+                    __ec_printf_digits(__ec_scratch_memory.tm_year,
+                                         ((__ec_args->format_chr ==
+                                               eclibc_printf_date_4digit)
+                                                                      ? 4 : 2));
+                }
+                return true;
+            }
+
+            case eclibc_printf_utc_time:
+            {
+                __ec_scratch_memory = va_arg(*__arg, struct tm);
+                __ec_scratch_memory.tm_year += 1900;
+                __ec_printf_digits(__ec_scratch_memory.tm_year, 4);
+                ec_strbuf_append_char(__s, '-');
+                __ec_printf_digits(__ec_scratch_memory.tm_mon, 2);
+                ec_strbuf_append_char(__s, '-');
+                __ec_printf_digits(__ec_scratch_memory.tm_mday, 2);
+                ec_strbuf_append_char(__s, 'T');
+                __ec_printf_digits(__ec_scratch_memory.tm_hour, 2);
+                ec_strbuf_append_char(__s, ':');
+                __ec_printf_digits(__ec_scratch_memory.tm_min, 2);
+                ec_strbuf_append_char(__s, ':');
+                __ec_printf_digits(__ec_scratch_memory.tm_sec, 2);
+                ec_strbuf_append_char(__s, 'Z');
+                return true;
+            }
+
+            default:
+                return false;
+        }
+    }
+    #undef EC_SCRATCH_1
+    #undef EC_SCRATCH_2
+    return false;
+}
+
+__attribute__((hot,noinline))
+bool
+__ec_printf_perform(ec_strbuf *__restrict __s,
+                    __ec_printf_args *__restrict __ec_args, va_list *__arg)
+{
+    return __ec_printf_perform_internal(__s, __ec_args, __arg, false, true);
+}
+
+__attribute__((hot,noinline))
+bool
+__ec_printf_perform_builtin(ec_strbuf *__restrict __s,
+                       __ec_printf_args *__restrict __ec_args, va_list *__arg)
+{
+    return __ec_printf_perform_internal(__s, __ec_args, __arg, false, false);
+}
+
+__attribute__((hot,noinline))
+bool
+__ec_urlprintf_perform(ec_strbuf *__restrict __s,
+                       __ec_printf_args *__restrict __ec_args, va_list *__arg)
+{
+    return __ec_printf_perform_internal(__s, __ec_args, __arg, true, true);
+}
+
+/* Copies the literal parts of the format and prints the specifiers between
+ * them. Unknown specifiers are copied as they are. */
+static inline bool
+__attribute__ ((hot,always_inline))
+__ec_printf_format(ec_strbuf *__restrict buf, const char *__restrict format,
+                                            va_list *__arg, const bool __url)
+{
+    const char *__restrict __ec_printf_temp_buffer_tail = format;
+    const char *__restrict __ec_printf_temp_buffer;
+    const char *__restrict __ec_printf_temp_buffer_temp;
+    const char *__restrict __ec_printf_temp_buffer_end =
+                                                    format + strlen(format);
+    __ec_printf_args __ec_args;
+    bool performed;
+    while(__ec_printf_temp_buffer_tail < __ec_printf_temp_buffer_end)
+    {
+        #ifdef __EC_VPRINTF_USE_STRCHR
+        __ec_printf_temp_buffer = strchr(__ec_printf_temp_buffer_tail, '%');
+        #else
+        __ec_printf_temp_buffer = (const char *)memchr(
+                            (const void*)__ec_printf_temp_buffer_tail, (int)'%',
+                                     (size_t)(__ec_printf_temp_buffer_end -
+                                              __ec_printf_temp_buffer_tail) );
+        #endif
+        /* No formatting were found */
+        if(__ec_printf_temp_buffer == EC_NULL)
+        {
+            ec_strbuf_append_n(buf, __ec_printf_temp_buffer_tail, (size_t)
+                 (__ec_printf_temp_buffer_end - __ec_printf_temp_buffer_tail));
+            break;
+        }
+        ec_strbuf_append_n(buf, __ec_printf_temp_buffer_tail, (size_t)
+                      (__ec_printf_temp_buffer - __ec_printf_temp_buffer_tail));
+
+        __ec_printf_temp_buffer_temp =
+                  __ec_printf_extract_format (__ec_printf_temp_buffer,
+                                                         &__ec_args, __arg);
+
+        if(__url)
+            performed = __ec_urlprintf_perform(buf, &__ec_args, __arg);
+        else
+            performed = __ec_printf_perform(buf, &__ec_args, __arg);
+        if(performed == false)
+            ec_strbuf_append_n(buf, __ec_printf_temp_buffer, (size_t)
+                  (__ec_printf_temp_buffer_temp - __ec_printf_temp_buffer));
+
+        __ec_printf_temp_buffer_tail = __ec_printf_temp_buffer_temp;
+    }
+    return ((buf->flags & EC_STRBUF_FAILED) == 0);
+}
+
+__attribute__((hot,noinline))
+bool
+ec_strbuf_append_vfmt(ec_strbuf *buf, const char *format, va_list __arg)
+{
+    bool result;
+    va_list argptr;
+    va_copy(argptr, __arg);
+    result = __ec_printf_format(buf, format, &argptr, false);
+    va_end(argptr);
+    return result;
+}
+
+bool __ec_strbuf_append_url_vfmt(ec_strbuf *buf, const char *format,
+                                                                va_list __arg)
+{
+    bool result;
+    va_list argptr;
+    va_copy(argptr, __arg);
+    result = __ec_printf_format(buf, format, &argptr, true);
+    va_end(argptr);
+    return result;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -22,618 +22,108 @@
  ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
  **/
 
+/* flockfile and fwrite_unlocked are not part of C99. */
+#define _DEFAULT_SOURCE
 #include <ec/internal/text_parse/printf_format.h>
-#include <ec/internal/text_parse/itoa.h>
-#include <ec/internal/text_parse/ftoa.h>
 #include <ec/internal/print_format_table.h>
+#include <ec/internal/printf_perform.h>
 #include <ec/internal/vprintf_internal.h>
-#include <ec/internal/pad_string.h>
-#include <ec/types.h>
-#include <ec/utf8.h>
-#include <ec/time.h>
+#include <ec/strbuf.h>
+#include <ec/print.h>
 #include <errno.h>
+#if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+#include <sys/uio.h>
+#include <limits.h>
+#endif
 
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
-#define __ec_printf_int(_type, _base, _upperCase)                              \
-    {                                                                          \
-        __ec_printf_numBuffer = ec_itoa_##_type (EC_SCRATCH_1(_type),          \
-                        __ec_printf_numBuffer_End, _base, _upperCase);         \
-        __ec_printf_numBuffer = ec_pad_num_string(                             \
-                                              __ec_args->NumberRight,          \
-                    __ec_printf_numBuffer, __ec_printf_numBuffer_End);         \
-        ec_fpad_string(__stream, __ec_args->NumberLeft, ' ',                   \
-                    __ec_printf_numBuffer, __ec_printf_numBuffer_End);         \
-    }
+/* ec_vfprintf locks the stream once per call, so the output of a call is
+ * never interleaved with other threads' even when it is written in several
+ * chunks, and the chunks themselves are written without locking again. */
+#if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+#define __ec_flockfile(_fp)                     flockfile(_fp)
+#define __ec_funlockfile(_fp)                   funlockfile(_fp)
+#elif defined(_WIN32)
+#define __ec_flockfile(_fp)                     _lock_file(_fp)
+#define __ec_funlockfile(_fp)                   _unlock_file(_fp)
+#else
+#define __ec_flockfile(_fp)
+#define __ec_funlockfile(_fp)
+#endif
 
-#define __ec_printf_string()                                                   \
-    {                                                                          \
-        size_t __temp = strlen(EC_SCRATCH_1(char *));                          \
-        if(__ec_args->NumberRight == 0 ||                                      \
-                                     (size_t)__ec_args->NumberRight > __temp)  \
-            __ec_args->NumberRight = (int)__temp;                              \
-        ec_fpad_string(__stream, __ec_args->NumberLeft, ' ',                   \
-                                                      EC_SCRATCH_1(char *),    \
-                             (EC_SCRATCH_1(char *) + __ec_args->NumberRight)); \
-    }
+#ifdef __GLIBC__
+#define __ec_fwrite_unlocked(_ptr, _len, _fp)                                  \
+        fwrite_unlocked(_ptr, 1, _len, _fp)
+#else
+/* The stream is already owned by this thread, so taking the lock again only
+ * costs a counter increment. */
+#define __ec_fwrite_unlocked(_ptr, _len, _fp)                                  \
+        fwrite(_ptr, 1, _len, _fp)
+#endif
 
-#define __ec_printf_double()                                                   \
-    {                                                                          \
-        __ec_printf_numBuffer = ec_ftoa(EC_SCRATCH_1(double),                  \
-                                         __ec_printf_numBuffer_End,            \
-                                                     __ec_args->NumberRight);  \
-        ec_fpad_string(__stream, __ec_args->NumberLeft, ' ',                   \
-                                     __ec_printf_numBuffer,                    \
-                                              __ec_printf_numBuffer_End);      \
-    }
+/* Hands a full formatting buffer to the stream. The caller owns the lock. */
+static bool
+__ec_vfprintf_sink(void *__stream, const char *data, size_t len)
+{
+    return (__ec_fwrite_unlocked(data, len, (FILE *)__stream) == len);
+}
 
-#define __ec_printf_digits(value, digitsCount)                                 \
-    {                                                                          \
-        __ec_printf_numBuffer = ec_itoa_uint64_t ((uint64_t)value,             \
-                        __ec_printf_numBuffer_End, 10, 0);                     \
-        __ec_printf_numBuffer = ec_pad_num_string(digitsCount,                 \
-                    __ec_printf_numBuffer, __ec_printf_numBuffer_End);         \
-        ec_fpad_string(__stream, 0, ' ', __ec_printf_numBuffer,                \
-                                                   __ec_printf_numBuffer_End); \
-    }
+static inline void
+__attribute__ ((hot,always_inline))
+__ec_vfprintf_unlocked_internal(FILE *__restrict __stream,
+                           const char *__restrict __format, va_list __arg)
+{
+    /* The output is collected here and written to the stream only when the
+     * storage is full or the formatting is done, so a typical call ends up
+     * as a single fwrite. */
+    char storage[EC_VFPRINTF_BUFFER_SIZE];
+    ec_strbuf buf;
+    ec_strbuf_init_sink(&buf, storage, sizeof(storage),
+                                        __ec_vfprintf_sink, (void *)__stream);
+    ec_strbuf_append_vfmt(&buf, __format, __arg);
+    ec_strbuf_flush(&buf);
+}
 
-static inline bool
-__attribute__ ((hot,unused,always_inline))
-__ec_printf_perform(FILE *__restrict __stream,
-                          __ec_printf_args *__restrict __ec_args, va_list __arg)
+static inline void
+__attribute__ ((hot,always_inline))
+__ec_vfprintf_compiled_internal(FILE *__restrict __stream,
+            const ec_printf_format *__restrict __compiled, va_list *__arg)
 {
-    /* as much to satisfy a 64 bit binary and more */
-    char NumBuffer_Storage[81];
-    struct tm __ec_scratch_memory;
-    char * __restrict __ec_printf_numBuffer_End = NumBuffer_Storage + 80;
-    char * __restrict __ec_printf_numBuffer;
-    *__ec_printf_numBuffer_End = '\0';
-    #define EC_SCRATCH_1(type) *((type *)(&__ec_scratch_memory))
-    /*
-    #define EC_SCRATCH_2(type) *((type *)((&__ec_scratch_memory) + 8))
-    */
-    if(__ec_args->is_ec_format == 0)
-    {
-        switch(__ec_args->format_chr)
-        {
-            case glibc_printf_form_float_E:
-            case glibc_printf_form_float_e:
-            case glibc_printf_form_float_F:
-            case glibc_printf_form_float_f:
-            case glibc_printf_form_float_G:
-            case glibc_printf_form_float_g:
-            {
-                if((__ec_args->NumSeen & 2) == 0)
-                    __ec_args->NumberRight = 6;
-                EC_SCRATCH_1(double) = va_arg(__arg, double);
-                __ec_printf_double();
-                return true;
-            }
-
-            case glibc_printf_form_percent:
-                ec_fputc('%', __stream);
-                return true;
-
-            case glibc_printf_form_character:
-            {
-                ec_fpad_character(__stream, __ec_args->NumberLeft, ' ',
-                                                    (char)(va_arg(__arg, int)));
-                return true;
-            }
-
-            case glibc_printf_form_strerror:
-            {
-                EC_SCRATCH_1(char *) = strerror(errno);
-                __ec_printf_string();
-                return true;
-            }
-
-            case glibc_printf_form_string_1:
-            case glibc_printf_form_string_2:
-            {
-                EC_SCRATCH_1(char *) = va_arg(__arg, char *);
-                __ec_printf_string();
-                return true;
-            }
-
-            case glibc_printf_form_integer_1:
-            case glibc_printf_form_integer_2:
-            {
-                switch(__ec_args->Size)
-                {
-                    case 0:
-                        EC_SCRATCH_1(int8_t) = (int8_t)va_arg(__arg, int);
-                        __ec_printf_int(int8_t, 10, 0);
-                        return true;
-                    case 1:
-                        EC_SCRATCH_1(int16_t)
-                                          = (int16_t)va_arg(__arg, int);
-                        __ec_printf_int(int16_t, 10, 0);
-                        return true;
-                    case 2:
-                        EC_SCRATCH_1(int32_t) = va_arg(__arg, int32_t);
-                        __ec_printf_int(int32_t, 10, 0);
-                        return true;
-                    default:
-                        EC_SCRATCH_1(int64_t) = va_arg(__arg, int64_t);
-                        __ec_printf_int(int64_t, 10, 0);
-                        return true;
-                };
-                return true;
-            }
-
-            case glibc_printf_form_size_t_1:
-            case glibc_printf_form_size_t_2:
-            case glibc_printf_form_pointer:
-            case glibc_printf_mod_ptrdiff_t:
-            {
-                EC_SCRATCH_1(uint64_t) = va_arg(__arg, uint64_t);
-                if(EC_SCRATCH_1(int) == 0)
-                    ec_fpad_len_str(__stream, __ec_args->NumberLeft,
-                                                            ' ', "False", 5);
-                else
-                    ec_fpad_len_str(__stream, __ec_args->NumberLeft,
-                                                            ' ', "True", 4);
-                return true;
-            }
-
-            case glibc_printf_form_unsigned:
-            {
-                switch(__ec_args->Size)
-                {
-                    case 0:
-                        EC_SCRATCH_1(uint8_t) = (uint8_t)va_arg(__arg, int);
-                        __ec_printf_int(uint8_t, 10, 0);
-                        return true;
-                    case 1:
-                        EC_SCRATCH_1(uint16_t)
-                                          = (uint16_t)va_arg(__arg, int);
-                        __ec_printf_int(uint16_t, 10, 0);
-                        return true;
-                    case 2:
-                        EC_SCRATCH_1(uint32_t) = va_arg(__arg, uint32_t);
-                        __ec_printf_int(uint32_t, 10, 0);
-                        return true;
-                    default:
-                        EC_SCRATCH_1(uint64_t) = va_arg(__arg, uint64_t);
-                        __ec_printf_int(uint64_t, 10, 0);
-                        return true;
-                };
-                return true;
-            }
-
-            case glibc_printf_form_octal:
-            {
-                switch(__ec_args->Size)
-                {
-                    case 0:
-                        EC_SCRATCH_1(uint8_t) = (uint8_t)va_arg(__arg, int);
-                        __ec_printf_int(uint8_t, 8, 0);
-                        return true;
-                    case 1:
-                        EC_SCRATCH_1(uint16_t)
-                                          = (uint16_t)va_arg(__arg, int);
-                        __ec_printf_int(uint16_t, 8, 0);
-                        return true;
-                    case 2:
-                        EC_SCRATCH_1(uint32_t) = va_arg(__arg, uint32_t);
-                        __ec_printf_int(uint32_t, 8, 0);
-                        return true;
-                    default:
-                        EC_SCRATCH_1(uint64_t) = va_arg(__arg, uint64_t);
-                        __ec_printf_int(uint64_t, 8, 0);
-                        return true;
-                };
-                return true;
-            }
-
-            case glibc_printf_form_hexa_Cap:
-            case glibc_printf_form_hexa_Lower:
-            {
-                switch(__ec_args->Size)
-                {
-                    case 0:
-                        EC_SCRATCH_1(uint8_t) = (uint8_t)va_arg(__arg, int);
-                        __ec_printf_int(uint8_t, 16, (__ec_args->format_chr
-                                        == glibc_printf_form_hexa_Cap) ? 1 : 0);
-                        return true;
-                    case 1:
-                        EC_SCRATCH_1(uint16_t)
-                                          = (uint16_t)va_arg(__arg, int);
-                        __ec_printf_int(uint16_t, 16, (__ec_args->format_chr
-                                        == glibc_printf_form_hexa_Cap) ? 1 : 0);
-                        return true;
-                    case 2:
-                        EC_SCRATCH_1(uint32_t) = va_arg(__arg, uint32_t);
-                        __ec_printf_int(uint32_t, 16, (__ec_args->format_chr
-                                        == glibc_printf_form_hexa_Cap) ? 1 : 0);
-                        return true;
-                    default:
-                        EC_SCRATCH_1(uint64_t) = va_arg(__arg, uint64_t);
-                        __ec_printf_int(uint64_t, 16, (__ec_args->format_chr
-                                        == glibc_printf_form_hexa_Cap) ? 1 : 0);
-                        return true;
-                };
-                return true;
-            }
-
-
-            default:
-                return false;
-        };
-    }
-    else
+    const __ec_printf_op *__restrict op = __compiled->ops;
+    const __ec_printf_op *__restrict end = op + __compiled->count;
+    /* The handlers of the operations are used as they are, unless one was
+     * registered after the format was compiled. */
+    const bool resolved = (__compiled->handlers ==
+                                        __ec_printf_handlers_generation());
+    __ec_printf_args __ec_args;
+    bool performed;
+    char storage[EC_VFPRINTF_BUFFER_SIZE];
+    ec_strbuf buf;
+    ec_strbuf_init_sink(&buf, storage, sizeof(storage),
+                                        __ec_vfprintf_sink, (void *)__stream);
+    for(; op < end; op++)
     {
-        switch(__ec_args->format_chr)
-        {
-            case glibc_printf_form_percent:
-                ec_fputc('%', __stream);
-                return true;
-
-            case eclibc_printf_bool:
-            {
-                EC_SCRATCH_1(int) = va_arg(__arg, int);
-                if(EC_SCRATCH_1(int) == 0)
-                    ec_fpad_len_str(__stream, __ec_args->NumberLeft,
-                                                            ' ', "False", 5);
-                else
-                    ec_fpad_len_str(__stream, __ec_args->NumberLeft,
-                                                            ' ', "True", 4);
-                return true;
-            }
-
-            case eclibc_printf_utf8:
-            {
-                char UTF8_temp[5];
-                EC_SCRATCH_1(ec_utf8_t) = va_arg(__arg, ec_utf8_t);
-                ea_utf8_decode(EC_SCRATCH_1(ec_utf8_t), UTF8_temp);
-                ec_fpad_len_str(__stream, __ec_args->NumberLeft,
-                                                            ' ', UTF8_temp, 1);
-                return true;
-            }
-
-            case eclibc_printf_phone_number:
-            {
-                char tempPhone[20];
-                char *__restrict phoneHead = tempPhone + 19;
-                if(__ec_args->NumberLeft < 1)
-                    __ec_args->NumberLeft = 12;
-                else if(__ec_args->NumberLeft > 19)
-                    __ec_args->NumberLeft = 19;
-                tempPhone[19] = '\0';
-                EC_SCRATCH_1(uint64_t) = va_arg(__arg, uint64_t);
-                phoneHead = ec_itoa_uint64_t(EC_SCRATCH_1(uint64_t),
-                                                              phoneHead, 10, 1);
-                if(phoneHead < (tempPhone + 19 - __ec_args->NumberLeft))
-                    phoneHead = (tempPhone + 19 - __ec_args->NumberLeft);
-                ec_fputc('+', __stream);
-                ec_fpad_string(__stream, __ec_args->NumberLeft, '0',
-                                                phoneHead, (tempPhone + 19));
-                return true;
-            }
-
-            case eclibc_printf_IPv4_Address:
-            {
-                char tempIP[17];
-                char *__restrict IP_head = tempIP + 16;
-                if(__ec_args->alternateForm)
-                    (EC_SCRATCH_1(ec_ipv4_t)).IP = va_arg(__arg, uint32_t);
-                else
-                    (EC_SCRATCH_1(ec_ipv4_t))    = va_arg(__arg, ec_ipv4_t);
-                tempIP[16] = '\0';
-                #define __EC_PRINTF_READ_NUM(INDEX)                            \
-                IP_head = ec_itoa_uint8_t(                                     \
-                        (EC_SCRATCH_1(ec_ipv4_t)).display_string.byte##INDEX , \
-                                IP_head, 10, 1);
-                __EC_PRINTF_READ_NUM(4);
-                *--IP_head = '.';
-                __EC_PRINTF_READ_NUM(3);
-                *--IP_head = '.';
-                __EC_PRINTF_READ_NUM(2);
-                *--IP_head = '.';
-                __EC_PRINTF_READ_NUM(1);
-                #undef __EC_PRINTF_READ_NUM
-                ec_fpad_string(__stream, __ec_args->NumberLeft, ' ',
-                                IP_head, tempIP + 16);
-                return true;
-            }
-
-            case eclibc_printf_IPv6_Address:
-            {
-                char tempIP[41];
-                char *__restrict IP_head = tempIP + 40;
-                (EC_SCRATCH_1(ec_ipv6_t)) = va_arg(__arg, ec_ipv6_t);
-                tempIP[40] = '\0';
-                #define __EC_PRINTF_READ_NUM(INDEX)                            \
-                IP_head = ec_itoa_uint16_t(                                    \
-                        (EC_SCRATCH_1(ec_ipv6_t)).display_string.byte##INDEX , \
-                                IP_head, 16, __ec_args->alternateForm);
-                __EC_PRINTF_READ_NUM(8); *--IP_head = ':';
-                __EC_PRINTF_READ_NUM(7); *--IP_head = ':';
-                __EC_PRINTF_READ_NUM(6); *--IP_head = ':';
-                __EC_PRINTF_READ_NUM(5); *--IP_head = ':';
-                __EC_PRINTF_READ_NUM(4); *--IP_head = ':';
-                __EC_PRINTF_READ_NUM(3); *--IP_head = ':';
-                __EC_PRINTF_READ_NUM(2); *--IP_head = ':';
-                __EC_PRINTF_READ_NUM(1);
-                #undef __EC_PRINTF_READ_NUM
-                ec_fpad_string(__stream, __ec_args->NumberLeft, ' ',
-                                IP_head, tempIP + 40);
-                return true;
-            }
-
-            case eclibc_printf_MAC_PC_Version:
-            case eclibc_printf_MAC_PC_Version_caps:
-            {
-                char tempMAC[3];
-                char *__restrict MAC_head;
-                if(__ec_args->alternateForm)
-                    (EC_SCRATCH_1(ec_mac_t)).MAC = va_arg(__arg, uint64_t);
-                else
-                    (EC_SCRATCH_1(ec_mac_t))     = va_arg(__arg, ec_mac_t);
-                tempMAC[2] = '\0';
-                #define __EC_PRINTF_PRINT_NUM(INDEX)                           \
-                MAC_head = tempMAC + 2;                                        \
-                MAC_head = ec_itoa_uint8_t(                                    \
-                        (EC_SCRATCH_1(ec_mac_t)).display_string.byte##INDEX ,  \
-                                MAC_head, 16, ((__ec_args->format_chr ==       \
-                                 eclibc_printf_MAC_PC_Version_caps) ? 1 : 0)); \
-                ec_fpad_string(__stream, 2, ' ', MAC_head, tempMAC + 2);
-
-                __EC_PRINTF_PRINT_NUM(1);
-                ec_fputc(':', __stream);
-                __EC_PRINTF_PRINT_NUM(2);
-                ec_fputc(':', __stream);
-                __EC_PRINTF_PRINT_NUM(3);
-                ec_fputc(':', __stream);
-                __EC_PRINTF_PRINT_NUM(4);
-                ec_fputc(':', __stream);
-                __EC_PRINTF_PRINT_NUM(5);
-                ec_fputc(':', __stream);
-                __EC_PRINTF_PRINT_NUM(6);
-
-                #undef __EC_PRINTF_PRINT_NUM
-                return true;
-            }
-
-            case eclibc_printf_MAC_CISCO:
-            case eclibc_printf_MAC_CISCO_caps:
-            {
-                char tempMAC[4];
-                char *__restrict MAC_head;
-                if(__ec_args->alternateForm)
-                    (EC_SCRATCH_1(ec_mac_t)).MAC = va_arg(__arg, uint64_t);
-                else
-                    (EC_SCRATCH_1(ec_mac_t))     = va_arg(__arg, ec_mac_t);
-                tempMAC[3] = '\0';
-                #define __EC_PRINTF_PRINT_NUM(INDEX)                           \
-                MAC_head = tempMAC + 3;                                        \
-                MAC_head = ec_itoa_uint16_t(                                   \
-                        (EC_SCRATCH_1(ec_mac_t)).cisco_string.byte##INDEX ,    \
-                                MAC_head, 16, ((__ec_args->format_chr ==       \
-                                      eclibc_printf_MAC_CISCO_caps) ? 1 : 0)); \
-                ec_fpad_string(__stream, 3, ' ', MAC_head, tempMAC + 3);
-
-                __EC_PRINTF_PRINT_NUM(1);
-                ec_fputc('.', __stream);
-                __EC_PRINTF_PRINT_NUM(2);
-                ec_fputc('.', __stream);
-                __EC_PRINTF_PRINT_NUM(3);
-
-                #undef __EC_PRINTF_PRINT_NUM
-                return true;
-            }
-
-            case eclibc_printf_base_2:
-            {
-                switch(__ec_args->Size)
-                {
-                    case 0:
-                        EC_SCRATCH_1(uint8_t) = (uint8_t)va_arg(__arg, int);
-                        __ec_printf_int(uint8_t, 2, 0);
-                        return true;
-                    case 1:
-                        EC_SCRATCH_1(uint16_t)
-                                          = (uint16_t)va_arg(__arg, int);
-                        __ec_printf_int(uint16_t, 2, 0);
-                        return true;
-                    case 2:
-                        EC_SCRATCH_1(uint32_t) = va_arg(__arg, uint32_t);
-                        __ec_printf_int(uint32_t, 2, 0);
-                        return true;
-                    default:
-                        EC_SCRATCH_1(uint64_t) = va_arg(__arg, uint64_t);
-                        __ec_printf_int(uint64_t, 2, 0);
-                        return true;
-                };
-                return true;
-            }
-
-            case eclibc_printf_base_8:
-            {
-                switch(__ec_args->Size)
-                {
-                    case 0:
-                        EC_SCRATCH_1(uint8_t) = (uint8_t)va_arg(__arg, int);
-                        __ec_printf_int(uint8_t, 8, 0);
-                        return true;
-                    case 1:
-                        EC_SCRATCH_1(uint16_t)
-                                          = (uint16_t)va_arg(__arg, int);
-                        __ec_printf_int(uint16_t, 8, 0);
-                        return true;
-                    case 2:
-                        EC_SCRATCH_1(uint32_t) = va_arg(__arg, uint32_t);
-                        __ec_printf_int(uint32_t, 8, 0);
-                        return true;
-                    default:
-                        EC_SCRATCH_1(uint64_t) = va_arg(__arg, uint64_t);
-                        __ec_printf_int(uint64_t, 8, 0);
-                        return true;
-                };
-                return true;
-            }
-
-            case eclibc_printf_base_16:
-            {
-                switch(__ec_args->Size)
-                {
-                    case 0:
-                        EC_SCRATCH_1(uint8_t) = (uint8_t)va_arg(__arg, int);
-                        __ec_printf_int(uint8_t, 16,
-                                       (__ec_args->alternateForm == 1) ? 1 : 0);
-                        return true;
-                    case 1:
-                        EC_SCRATCH_1(uint16_t)
-                                          = (uint16_t)va_arg(__arg, int);
-                        __ec_printf_int(uint16_t, 16,
-                                       (__ec_args->alternateForm == 1) ? 1 : 0);
-                        return true;
-                    case 2:
-                        EC_SCRATCH_1(uint32_t) = va_arg(__arg, uint32_t);
-                        __ec_printf_int(uint32_t, 16,
-                                       (__ec_args->alternateForm == 1) ? 1 : 0);
-                        return true;
-                    default:
-                        EC_SCRATCH_1(uint64_t) = va_arg(__arg, uint64_t);
-                        __ec_printf_int(uint64_t, 16,
-                                       (__ec_args->alternateForm == 1) ? 1 : 0);
-                        return true;
-                };
-                return true;
-            }
-
-            case eclibc_printf_Time_struct_tm:
-            case eclibc_printf_time_struct_tm_short:
-            {
-                char mode[4] = "";
-                __ec_scratch_memory = va_arg(__arg, struct tm);
-                if(__ec_args->alternateForm == 1)
-                {
-                    mode[0] = ' ';
-                    mode[2] = 'M';
-                    mode[3] = '\0';
-                    if(__ec_scratch_memory.tm_hour > 12)
-                    {
-                        __ec_scratch_memory.tm_hour -= 12;
-                        mode[1] = 'P';
-                    }
-                    else
-                        mode[1] = 'A';
-                }
-                __ec_printf_digits(__ec_scratch_memory.tm_hour, 2);
-                ec_fputc(':', __stream);
-                __ec_printf_digits(__ec_scratch_memory.tm_min, 2);
-                if(__ec_args->format_chr == eclibc_printf_Time_struct_tm)
-                {
-                    ec_fputc(':', __stream);
-                    __ec_printf_digits(__ec_scratch_memory.tm_sec, 2);
-                }
-                ec_fputs(mode, __stream);
-                return true;
-            }
-
-            case eclibc_printf_time_seconds:
-            case eclibc_printf_time_seconds_short:
-            {
-                char mode[4] = "";
-                uint32_t tempInt = va_arg(__arg, uint32_t);
-                __ec_scratch_memory.tm_hour = (int)(tempInt / 3600);
-                __ec_scratch_memory.tm_min  = (int)((tempInt % 3600) / 60);
-                __ec_scratch_memory.tm_sec  = (int)(tempInt % 60);
-                if(__ec_args->alternateForm == 1)
-                {
-                    mode[0] = ' ';
-                    mode[2] = 'M';
-                    mode[3] = '\0';
-                    if(__ec_scratch_memory.tm_hour > 12)
-                    {
-                        __ec_scratch_memory.tm_hour -= 12;
-                        mode[1] = 'P';
-                    }
-                    else
-                        mode[1] = 'A';
-                }
-                __ec_printf_digits(__ec_scratch_memory.tm_hour, 2);
-                ec_fputc(':', __stream);
-                __ec_printf_digits(__ec_scratch_memory.tm_min, 2);
-                if(__ec_args->format_chr == eclibc_printf_time_seconds)
-                {
-                    ec_fputc(':', __stream);
-                    __ec_printf_digits(__ec_scratch_memory.tm_sec, 2);
-                }
-                ec_fputs(mode, __stream);
-                return true;
-            }
-
-            case eclibc_printf_date_2digit:
-            case eclibc_printf_date_4digit:
-            {
-                __ec_scratch_memory = va_arg(__arg, struct tm);
-                __ec_scratch_memory.tm_year += 1900;
-                if(__ec_args->alternateForm == 1)
-                {
-                    ec_fputs(ec_month_name_str[
-                                         __ec_scratch_memory.tm_mon], __stream);
-                    ec_fputc(' ', __stream);
-                    __ec_printf_digits(__ec_scratch_memory.tm_mday, 2);
-                    if(__ec_scratch_memory.tm_mday > 3 &&
-                            __ec_scratch_memory.tm_mday <= 20)
-                        ec_fputs("th ", __stream);
-                    else if(__ec_scratch_memory.tm_mday % 10 == 1)
-                        ec_fputs("st ", __stream);
-                    else if(__ec_scratch_memory.tm_mday % 10 == 2)
-                        ec_fputs("nd ", __stream);
-                    else
-                        ec_fputs("th ", __stream);
-                    __ec_printf_digits(__ec_scratch_memory.tm_year,
-                                         ((__ec_args->format_chr ==
-                                               eclibc_printf_date_4digit)
-                                                                      ? 4 : 2));
-                }
-                else
-                {
-                    __ec_printf_digits(__ec_scratch_memory.tm_mday, 2);
-                    ec_fputc('/', __stream);
-                    __ec_printf_digits((__ec_scratch_memory.tm_mon + 1), 2);
-                    ec_fputc('/', __stream);
-                    __ec_printf_digits(__ec_scratch_memory.tm_year,
-                                         ((__ec_args->format_chr ==
-                                               eclibc_printf_date_4digit)
-                                                                      ? 4 : 2));
-                }
-                return true;
-            }
-
-            case eclibc_printf_utc_time:
-            {
-                __ec_scratch_memory = va_arg(__arg, struct tm);
-                __ec_scratch_memory.tm_year += 1900;
-                __ec_printf_digits(__ec_scratch_memory.tm_year, 4);
-                ec_fputc('-', __stream);
-                __ec_printf_digits(__ec_scratch_memory.tm_mon, 2);
-                ec_fputc('-', __stream);
-                __ec_printf_digits(__ec_scratch_memory.tm_mday, 2);
-                ec_fputc('T', __stream);
-                __ec_printf_digits(__ec_scratch_memory.tm_hour, 2);
-                ec_fputc(':', __stream);
-                __ec_printf_digits(__ec_scratch_memory.tm_min, 2);
-                ec_fputc(':', __stream);
-                __ec_printf_digits(__ec_scratch_memory.tm_sec, 2);
-                ec_fputc('Z', __stream);
-                return true;
-            }
-
-            default:
-                return false;
-        }
+        ec_strbuf_append_n(&buf, op->literal, op->literal_len);
+        if(op->spec_len == 0)
+            continue;
+        /* The engine adjusts the arguments while printing. */
+        __ec_args = op->args;
+        if(__ec_args.Star != 0)
+            __ec_printf_resolve_star(&__ec_args, __arg);
+        if(!resolved)
+            performed = __ec_printf_perform(&buf, &__ec_args, __arg);
+        else if(op->handler != EC_NULL)
+            performed = op->handler(&buf, &__ec_args, __arg, op->context);
+        else
+            performed = __ec_printf_perform_builtin(&buf, &__ec_args, __arg);
+        if(performed == false)
+            ec_strbuf_append_n(&buf, op->spec, op->spec_len);
     }
-    #undef EC_SCRATCH_1
-    #undef EC_SCRATCH_2
-    return false;
+    ec_strbuf_flush(&buf);
 }
 
 __attribute__((hot,noinline))
@@ -641,44 +131,19 @@ void
 ec_vfprintf(FILE *__restrict __stream,
                            const char *__restrict __format, va_list __arg)
 {
-    const char *__restrict __ec_printf_temp_buffer_tail = __format;
-    const char *__restrict __ec_printf_temp_buffer;
-    const char *__restrict __ec_printf_temp_buffer_temp;
-    const char *__restrict __ec_printf_temp_buffer_end =
-                                                    __format + strlen(__format);
-    __ec_printf_args __ec_args;
-    while(*__ec_printf_temp_buffer_tail != '\0')
-    {
-        #ifdef __EC_VPRINTF_USE_STRCHR
-        __ec_printf_temp_buffer = strchr(__ec_printf_temp_buffer_tail, '%');
-        #else
-        __ec_printf_temp_buffer = memchr(
-                            (const void*)__ec_printf_temp_buffer_tail, (int)'%',
-                                     (size_t)(__ec_printf_temp_buffer_end -
-                                              __ec_printf_temp_buffer_tail) );
-        #endif
-        /* No formatting were found */
-        if(__ec_printf_temp_buffer == EC_NULL ||
-                __ec_printf_temp_buffer_end <= __ec_printf_temp_buffer)
-        {
-            fputs(__ec_printf_temp_buffer_tail, __stream);
-            return;
-        }
-        else
-        {
-            ec_fwrite_str(__ec_printf_temp_buffer_tail,
-                                            __ec_printf_temp_buffer, __stream);
-            __ec_printf_temp_buffer_temp =
-                      __ec_printf_extract_format (__ec_printf_temp_buffer,
-                                                             &__ec_args, __arg);
-
-            if(__ec_printf_perform(__stream, &__ec_args, __arg) == false)
-                ec_fwrite_str(__ec_printf_temp_buffer,
-                                        __ec_printf_temp_buffer_temp, __stream);
-            __ec_printf_temp_buffer_tail = __ec_printf_temp_buffer_temp;
-        }
-    }
+    __ec_flockfile(__stream);
+    __ec_vfprintf_unlocked_internal(__stream, __format, __arg);
+    __ec_funlockfile(__stream);
+}
+
+__attribute__((hot,noinline))
+void
+ec_vfprintf_unlocked(FILE *__restrict __stream,
+                           const char *__restrict __format, va_list __arg)
+{
+    __ec_vfprintf_unlocked_internal(__stream, __format, __arg);
 }
+
 /*
 __attribute__((hot,noinline))
 void
@@ -689,7 +154,8 @@ ec_fprintf(FILE *__restrict __stream, const char *__restrict __format)
 */
 __attribute__((hot,noinline))
 void
-ec_fprintf(FILE *__restrict __stream, const char *__restrict __format, ...)
+__ec_fprintf_uncached(FILE *__restrict __stream,
+                                        const char *__restrict __format, ...)
 {
     va_list argptr;
     va_start(argptr, __format);
@@ -713,7 +179,7 @@ ec_printf(const char *__restrict __format)
 */
 __attribute__((hot,noinline))
 void
-ec_printf(const char *__restrict __format, ...)
+__ec_printf_uncached(const char *__restrict __format, ...)
 {
     va_list argptr;
     va_start(argptr, __format);
@@ -721,6 +187,303 @@ ec_printf(const char *__restrict __format, ...)
     va_end(argptr);
 }
 
+__attribute__((hot,noinline))
+void
+ec_fprintf_unlocked(FILE *__restrict __stream,
+                                        const char *__restrict __format, ...)
+{
+    va_list argptr;
+    va_start(argptr, __format);
+    ec_vfprintf_unlocked(__stream, __format, argptr);
+    va_end(argptr);
+}
+
+__attribute__((hot,noinline))
+void
+ec_vprintf_unlocked(const char *__restrict __format, va_list __arg)
+{
+    ec_vfprintf_unlocked(stdout, __format, __arg);
+}
+
+__attribute__((hot,noinline))
+void
+ec_printf_unlocked(const char *__restrict __format, ...)
+{
+    va_list argptr;
+    va_start(argptr, __format);
+    ec_vfprintf_unlocked(stdout, __format, argptr);
+    va_end(argptr);
+}
+
+__attribute__((hot,noinline))
+void
+ec_vfprintf_compiled(FILE *__restrict __stream,
+            const ec_printf_format *__restrict __compiled, va_list __arg)
+{
+    va_list argptr;
+    va_copy(argptr, __arg);
+    __ec_flockfile(__stream);
+    __ec_vfprintf_compiled_internal(__stream, __compiled, &argptr);
+    __ec_funlockfile(__stream);
+    va_end(argptr);
+}
+
+__attribute__((hot,noinline))
+void
+ec_fprintf_compiled(FILE *__restrict __stream,
+                            const ec_printf_format *__restrict __compiled, ...)
+{
+    va_list argptr;
+    va_start(argptr, __compiled);
+    ec_vfprintf_compiled(__stream, __compiled, argptr);
+    va_end(argptr);
+}
+
+__attribute__((hot,noinline))
+void
+ec_printf_compiled(const ec_printf_format *__restrict __compiled, ...)
+{
+    va_list argptr;
+    va_start(argptr, __compiled);
+    ec_vfprintf_compiled(stdout, __compiled, argptr);
+    va_end(argptr);
+}
+
+void __ec_print_begin(ec_strbuf *buf, char *storage, size_t size,
+                                                                FILE *stream)
+{
+    __ec_flockfile(stream);
+    ec_strbuf_init_sink(buf, storage, size, __ec_vfprintf_sink, (void *)stream);
+}
+
+void __ec_print_end(ec_strbuf *buf)
+{
+    ec_strbuf_flush(buf);
+    __ec_funlockfile((FILE *)buf->context);
+}
+
+__attribute__((hot,noinline))
+void
+__ec_fprintf_cached(ec_printf_format **__site, FILE *__restrict __stream,
+                                        const char *__restrict __format, ...)
+{
+    const ec_printf_format *compiled = __ec_printf_site_format(__site,
+                                                                    __format);
+    va_list argptr;
+    va_start(argptr, __format);
+    /* Out of memory, or the call site was compiled for another format, e.g.
+     * in a function inlined into several callers. The format is parsed on
+     * the fly instead. */
+    if(compiled == EC_NULL)
+        ec_vfprintf(__stream, __format, argptr);
+    else
+        ec_vfprintf_compiled(__stream, compiled, argptr);
+    va_end(argptr);
+}
+
+#if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+
+/* The output of an ec_vdprintf call, as the pieces of a writev. The pieces
+ * point to the format, to the "%s" arguments and to the scratch builder,
+ * whose characters before "mark" are already covered by a piece. */
+typedef struct
+{
+    struct iovec  vectors[EC_DPRINTF_IOVEC_COUNT];
+    ec_strbuf     scratch;
+    size_t        mark;
+    size_t        written;
+    int           count;
+    int           fd;
+    bool          failed;
+    char          storage[EC_DPRINTF_SCRATCH_SIZE];
+} __ec_dprintf_gather;
+
+/* Writes the pieces, retrying after partial writes and interruptions. */
+static bool
+__ec_dprintf_writev(__ec_dprintf_gather *__restrict g)
+{
+    struct iovec *vector = g->vectors;
+    int count = g->count;
+    ssize_t done;
+    size_t left;
+    g->count = 0;
+    g->mark  = 0;
+    while(count > 0 && !g->failed)
+    {
+        done = writev(g->fd, vector, count);
+        if(done < 0)
+        {
+            if(errno != EINTR)
+                g->failed = true;
+            continue;
+        }
+        left = (size_t)done;
+        g->written += left;
+        while(count > 0 && left >= vector->iov_len)
+        {
+            left -= vector->iov_len;
+            vector++;
+            count--;
+        }
+        if(count > 0)
+        {
+            vector->iov_base = (char *)vector->iov_base + left;
+            vector->iov_len -= left;
+        }
+    }
+    return !g->failed;
+}
+
+/* Adds a piece. The scratch characters must all be covered already, as they
+ * are reused once the pieces are written. */
+static inline void
+__attribute__ ((hot,always_inline))
+__ec_dprintf_push(__ec_dprintf_gather *__restrict g, const char *ptr,
+                                                                    size_t len)
+{
+    g->vectors[g->count].iov_base = (void *)(uintptr_t)ptr;
+    g->vectors[g->count].iov_len  = len;
+    if(++g->count == EC_DPRINTF_IOVEC_COUNT)
+    {
+        __ec_dprintf_writev(g);
+        ec_strbuf_clear(&g->scratch);
+    }
+}
+
+/* Covers the scratch characters added since the last piece. */
+static inline void
+__attribute__ ((hot,always_inline))
+__ec_dprintf_close(__ec_dprintf_gather *__restrict g)
+{
+    size_t mark = g->mark;
+    if(g->scratch.len > mark)
+    {
+        g->mark = g->scratch.len;
+        __ec_dprintf_push(g, g->scratch.data + mark, g->scratch.len - mark);
+    }
+}
+
+/* Called when the scratch builder is full, or with a text too long for it. */
+static bool
+__ec_dprintf_sink(void *context, const char *data, size_t len)
+{
+    __ec_dprintf_gather *g = (__ec_dprintf_gather *)context;
+    if(data == g->storage)
+        __ec_dprintf_close(g);
+    else
+        __ec_dprintf_push(g, data, len);
+    return __ec_dprintf_writev(g);
+}
+
+/* Adds text which stays where it is until the call returns. */
+static inline void
+__attribute__ ((hot,always_inline))
+__ec_dprintf_text(__ec_dprintf_gather *__restrict g, const char *ptr,
+                                                                    size_t len)
+{
+    if(len < EC_DPRINTF_REFERENCE_SIZE)
+    {
+        ec_strbuf_append_n(&g->scratch, ptr, len);
+        return;
+    }
+    __ec_dprintf_close(g);
+    __ec_dprintf_push(g, ptr, len);
+}
+
+__attribute__((hot,noinline))
+int
+ec_vdprintf(int __fd, const char *__restrict __format, va_list __arg)
+{
+    const char *__restrict __ec_printf_temp_buffer_tail = __format;
+    const char *__restrict __ec_printf_temp_buffer;
+    const char *__restrict __ec_printf_temp_buffer_temp;
+    const char *__restrict __ec_printf_temp_buffer_end =
+                                                    __format + strlen(__format);
+    const char *string;
+    size_t length;
+    __ec_printf_args __ec_args;
+    __ec_dprintf_gather g;
+    va_list argptr;
+    g.mark    = 0;
+    g.written = 0;
+    g.count   = 0;
+    g.fd      = __fd;
+    g.failed  = false;
+    ec_strbuf_init_sink(&g.scratch, g.storage, sizeof(g.storage),
+                                                    __ec_dprintf_sink, &g);
+    va_copy(argptr, __arg);
+    while(__ec_printf_temp_buffer_tail < __ec_printf_temp_buffer_end)
+    {
+        __ec_printf_temp_buffer = memchr(
+                            (const void*)__ec_printf_temp_buffer_tail, (int)'%',
+                                     (size_t)(__ec_printf_temp_buffer_end -
+                                              __ec_printf_temp_buffer_tail) );
+        /* No formatting were found */
+        if(__ec_printf_temp_buffer == EC_NULL)
+        {
+            __ec_dprintf_text(&g, __ec_printf_temp_buffer_tail, (size_t)
+                 (__ec_printf_temp_buffer_end - __ec_printf_temp_buffer_tail));
+            break;
+        }
+        __ec_dprintf_text(&g, __ec_printf_temp_buffer_tail, (size_t)
+                      (__ec_printf_temp_buffer - __ec_printf_temp_buffer_tail));
+
+        __ec_printf_temp_buffer_temp =
+                  __ec_printf_extract_format (__ec_printf_temp_buffer,
+                                                         &__ec_args, &argptr);
+
+        /* Strings are referenced instead of copied, only the padding goes
+         * to the scratch builder. */
+        if(__ec_args.is_ec_format == 0 &&
+                    (__ec_args.format_chr == glibc_printf_form_string_1 ||
+                     __ec_args.format_chr == glibc_printf_form_string_2))
+        {
+            string = va_arg(argptr, const char *);
+            length = strlen(string);
+            if(__ec_args.NumberRight != 0 &&
+                                    (size_t)__ec_args.NumberRight < length)
+                length = (size_t)__ec_args.NumberRight;
+            if(__ec_args.NumberLeft > 0 &&
+                                    (size_t)__ec_args.NumberLeft > length)
+                ec_strbuf_append_repeat(&g.scratch, ' ',
+                                    (size_t)__ec_args.NumberLeft - length);
+            __ec_dprintf_text(&g, string, length);
+            if(__ec_args.NumberLeft < 0 &&
+                            (size_t)(-(long)__ec_args.NumberLeft) > length)
+                ec_strbuf_append_repeat(&g.scratch, ' ',
+                            (size_t)(-(long)__ec_args.NumberLeft) - length);
+        }
+        else if(__ec_printf_perform(&g.scratch, &__ec_args, &argptr) == false)
+            __ec_dprintf_text(&g, __ec_printf_temp_buffer, (size_t)
+                  (__ec_printf_temp_buffer_temp - __ec_printf_temp_buffer));
+
+        __ec_printf_temp_buffer_tail = __ec_printf_temp_buffer_temp;
+    }
+    va_end(argptr);
+    __ec_dprintf_close(&g);
+    if(!__ec_dprintf_writev(&g))
+        return -1;
+    if(g.written > INT_MAX)
+    {
+        errno = EOVERFLOW;
+        return -1;
+    }
+    return (int)g.written;
+}
+
+__attribute__((hot,noinline))
+int
+ec_dprintf(int __fd, const char *__restrict __format, ...)
+{
+    int result;
+    va_list argptr;
+    va_start(argptr, __format);
+    result = ec_vdprintf(__fd, __format, argptr);
+    va_end(argptr);
+    return result;
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
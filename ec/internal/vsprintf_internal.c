@@ -22,16 +22,9 @@
  ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
  **/
 
-#include <ec/internal/text_parse/printf_format.h>
-#include <ec/internal/text_parse/itoa.h>
-#include <ec/internal/text_parse/ftoa.h>
-#include <ec/internal/print_format_table.h>
 #include <ec/internal/vsprintf_internal.h>
-#include <ec/internal/spad_string.h>
-#include <ec/internal/pad_string.h>
-#include <ec/types.h>
-#include <ec/utf8.h>
-#include <ec/time.h>
+#include <ec/strbuf.h>
+#include <stdlib.h>
 #include <errno.h>
 
 #ifdef __cplusplus
@@ -39,659 +32,173 @@ extern "C"
 {
 #endif
 
-#define __ec_sprintf_int(_type, _base, _upperCase)                             \
-    {                                                                          \
-        __ec_printf_numBuffer = ec_itoa_##_type (EC_SCRATCH_1(_type),          \
-                        __ec_printf_numBuffer_End, _base, _upperCase);         \
-        __ec_printf_numBuffer = ec_pad_num_string(                             \
-                                              __ec_args->NumberRight,          \
-                    __ec_printf_numBuffer, __ec_printf_numBuffer_End);         \
-        ec_sfpad_string(__s, __ec_args->NumberLeft, ' ',                       \
-                    __ec_printf_numBuffer, __ec_printf_numBuffer_End);         \
-    }
-
-#define __ec_sprintf_string()                                                  \
-    {                                                                          \
-        size_t __temp = strlen(EC_SCRATCH_1(char *));                          \
-        if(__ec_args->NumberRight == 0 ||                                      \
-                                     (size_t)__ec_args->NumberRight > __temp)  \
-            __ec_args->NumberRight = (int)__temp;                              \
-        ec_sfpad_string(__s, __ec_args->NumberLeft, ' ',                       \
-                                                      EC_SCRATCH_1(char *),    \
-                             (EC_SCRATCH_1(char *) + __ec_args->NumberRight)); \
-    }
-
-#define __ec_sprintf_double()                                                  \
-    {                                                                          \
-        __ec_printf_numBuffer = ec_ftoa(EC_SCRATCH_1(double),                  \
-                                         __ec_printf_numBuffer_End,            \
-                                                     __ec_args->NumberRight);  \
-        ec_sfpad_string(__s, __ec_args->NumberLeft, ' ',                       \
-                                     __ec_printf_numBuffer,                    \
-                                              __ec_printf_numBuffer_End);      \
-    }
-
-#define __ec_sprintf_digits(value, digitsCount)                                \
-    {                                                                          \
-        __ec_printf_numBuffer = ec_itoa_uint64_t ((uint64_t)value,             \
-                        __ec_printf_numBuffer_End, 10, 0);                     \
-        __ec_printf_numBuffer = ec_pad_num_string(digitsCount,                 \
-                    __ec_printf_numBuffer, __ec_printf_numBuffer_End);         \
-        ec_sfpad_string(__s, 0, ' ', __ec_printf_numBuffer,                    \
-                                                   __ec_printf_numBuffer_End); \
-    }
-
-static inline bool
-__attribute__ ((hot,unused,always_inline))
-__ec_sprintf_perform(char *__restrict __s,
-                          __ec_printf_args *__restrict __ec_args, va_list __arg)
+__attribute__((hot,noinline))
+int
+ec_vsprintf(char *__restrict __dst, const char *__restrict __src,
+                                                                 va_list __arg)
 {
-    /* as much to satisfy a 64 bit binary and more */
-    char NumBuffer_Storage[81];
-    struct tm __ec_scratch_memory;
-    char * __restrict __ec_printf_numBuffer_End = NumBuffer_Storage + 80;
-    char * __restrict __ec_printf_numBuffer;
-    *__ec_printf_numBuffer_End = '\0';
-    #define EC_SCRATCH_1(type) *((type *)(&__ec_scratch_memory))
-    /*
-    #define EC_SCRATCH_2(type) *((type *)((&__ec_scratch_memory) + 8))
-    */
-    if(__ec_args->is_ec_format == 0)
-    {
-        switch(__ec_args->format_chr)
-        {
-            case glibc_printf_form_float_E:
-            case glibc_printf_form_float_e:
-            case glibc_printf_form_float_F:
-            case glibc_printf_form_float_f:
-            case glibc_printf_form_float_G:
-            case glibc_printf_form_float_g:
-            {
-                if((__ec_args->NumSeen & 2) == 0)
-                    __ec_args->NumberRight = 6;
-                EC_SCRATCH_1(double) = va_arg(__arg, double);
-                __ec_sprintf_double();
-                return true;
-            }
-
-            case glibc_printf_form_percent:
-                strcat(__s, "%");
-                return true;
-
-            case glibc_printf_form_character:
-            {
-                ec_spad_character(__s, __ec_args->NumberLeft, ' ',
-                                                    (char)(va_arg(__arg, int)));
-                return true;
-            }
-
-            case glibc_printf_form_strerror:
-            {
-                EC_SCRATCH_1(char *) = strerror(errno);
-                __ec_sprintf_string();
-                return true;
-            }
-
-            case glibc_printf_form_string_1:
-            case glibc_printf_form_string_2:
-            {
-                EC_SCRATCH_1(char *) = va_arg(__arg, char *);
-                __ec_sprintf_string();
-                return true;
-            }
-
-            case glibc_printf_form_integer_1:
-            case glibc_printf_form_integer_2:
-            {
-                switch(__ec_args->Size)
-                {
-                    case 0:
-                        EC_SCRATCH_1(int8_t) = (int8_t)va_arg(__arg, int);
-                        __ec_sprintf_int(int8_t, 10, 0);
-                        return true;
-                    case 1:
-                        EC_SCRATCH_1(int16_t)
-                                          = (int16_t)va_arg(__arg, int);
-                        __ec_sprintf_int(int16_t, 10, 0);
-                        return true;
-                    case 2:
-                        EC_SCRATCH_1(int32_t) = va_arg(__arg, int32_t);
-                        __ec_sprintf_int(int32_t, 10, 0);
-                        return true;
-                    default:
-                        EC_SCRATCH_1(int64_t) = va_arg(__arg, int64_t);
-                        __ec_sprintf_int(int64_t, 10, 0);
-                        return true;
-                };
-                return true;
-            }
-
-            case glibc_printf_form_size_t_1:
-            case glibc_printf_form_size_t_2:
-            case glibc_printf_form_pointer:
-            case glibc_printf_mod_ptrdiff_t:
-            {
-                EC_SCRATCH_1(uint64_t) = va_arg(__arg, uint64_t);
-                if(EC_SCRATCH_1(int) == 0)
-                    ec_spad_len_str(__s, __ec_args->NumberLeft,
-                                                            ' ', "False", 5);
-                else
-                    ec_spad_len_str(__s, __ec_args->NumberLeft,
-                                                            ' ', "True", 4);
-                return true;
-            }
-
-            case glibc_printf_form_unsigned:
-            {
-                switch(__ec_args->Size)
-                {
-                    case 0:
-                        EC_SCRATCH_1(uint8_t) = (uint8_t)va_arg(__arg, int);
-                        __ec_sprintf_int(uint8_t, 10, 0);
-                        return true;
-                    case 1:
-                        EC_SCRATCH_1(uint16_t)
-                                          = (uint16_t)va_arg(__arg, int);
-                        __ec_sprintf_int(uint16_t, 10, 0);
-                        return true;
-                    case 2:
-                        EC_SCRATCH_1(uint32_t) = va_arg(__arg, uint32_t);
-                        __ec_sprintf_int(uint32_t, 10, 0);
-                        return true;
-                    default:
-                        EC_SCRATCH_1(uint64_t) = va_arg(__arg, uint64_t);
-                        __ec_sprintf_int(uint64_t, 10, 0);
-                        return true;
-                };
-                return true;
-            }
-
-            case glibc_printf_form_octal:
-            {
-                switch(__ec_args->Size)
-                {
-                    case 0:
-                        EC_SCRATCH_1(uint8_t) = (uint8_t)va_arg(__arg, int);
-                        __ec_sprintf_int(uint8_t, 8, 0);
-                        return true;
-                    case 1:
-                        EC_SCRATCH_1(uint16_t)
-                                          = (uint16_t)va_arg(__arg, int);
-                        __ec_sprintf_int(uint16_t, 8, 0);
-                        return true;
-                    case 2:
-                        EC_SCRATCH_1(uint32_t) = va_arg(__arg, uint32_t);
-                        __ec_sprintf_int(uint32_t, 8, 0);
-                        return true;
-                    default:
-                        EC_SCRATCH_1(uint64_t) = va_arg(__arg, uint64_t);
-                        __ec_sprintf_int(uint64_t, 8, 0);
-                        return true;
-                };
-                return true;
-            }
-
-            case glibc_printf_form_hexa_Cap:
-            case glibc_printf_form_hexa_Lower:
-            {
-                switch(__ec_args->Size)
-                {
-                    case 0:
-                        EC_SCRATCH_1(uint8_t) = (uint8_t)va_arg(__arg, int);
-                        __ec_sprintf_int(uint8_t, 16, (__ec_args->format_chr
-                                        == glibc_printf_form_hexa_Cap) ? 1 : 0);
-                        return true;
-                    case 1:
-                        EC_SCRATCH_1(uint16_t)
-                                          = (uint16_t)va_arg(__arg, int);
-                        __ec_sprintf_int(uint16_t, 16, (__ec_args->format_chr
-                                        == glibc_printf_form_hexa_Cap) ? 1 : 0);
-                        return true;
-                    case 2:
-                        EC_SCRATCH_1(uint32_t) = va_arg(__arg, uint32_t);
-                        __ec_sprintf_int(uint32_t, 16, (__ec_args->format_chr
-                                        == glibc_printf_form_hexa_Cap) ? 1 : 0);
-                        return true;
-                    default:
-                        EC_SCRATCH_1(uint64_t) = va_arg(__arg, uint64_t);
-                        __ec_sprintf_int(uint64_t, 16, (__ec_args->format_chr
-                                        == glibc_printf_form_hexa_Cap) ? 1 : 0);
-                        return true;
-                };
-                return true;
-            }
+    ec_strbuf buf;
+    /* The legacy interface has no size, so the destination is trusted to be
+     * large enough, exactly like sprintf. */
+    ec_strbuf_init_fixed(&buf, __dst, (size_t)-1);
+    ec_strbuf_append_vfmt(&buf, __src, __arg);
+    return (int)buf.len;
+}
 
+__attribute__((hot,noinline))
+int
+ec_sprintf(char *__restrict __dst, const char *__restrict __src, ...)
+{
+    int result;
+    va_list argptr;
+    va_start(argptr, __src);
+    result = ec_vsprintf(__dst, __src, argptr);
+    va_end(argptr);
+    return result;
+}
 
-            default:
-                return false;
-        };
-    }
+__attribute__((hot,noinline))
+int
+ec_vsnprintf(char *__restrict __dst, size_t __size,
+                               const char *__restrict __src, va_list __arg)
+{
+    ec_strbuf buf;
+    char empty;
+    /* Nothing is written when the size is 0, but the length is still
+     * computed. */
+    if(__size == 0)
+        ec_strbuf_init_fixed(&buf, &empty, 1);
     else
-    {
-        switch(__ec_args->format_chr)
-        {
-            case glibc_printf_form_percent:
-                strcat(__s, "%");
-                return true;
-
-            case eclibc_printf_bool:
-            {
-                EC_SCRATCH_1(int) = va_arg(__arg, int);
-                if(EC_SCRATCH_1(int) == 0)
-                    ec_spad_len_str(__s, __ec_args->NumberLeft,
-                                                            ' ', "False", 5);
-                else
-                    ec_spad_len_str(__s, __ec_args->NumberLeft,
-                                                            ' ', "True", 4);
-                return true;
-            }
-
-            case eclibc_printf_utf8:
-            {
-                char UTF8_temp[5];
-                EC_SCRATCH_1(ec_utf8_t) = va_arg(__arg, ec_utf8_t);
-                ea_utf8_decode(EC_SCRATCH_1(ec_utf8_t), UTF8_temp);
-                ec_spad_len_str(__s, __ec_args->NumberLeft,
-                                                            ' ', UTF8_temp, 1);
-                return true;
-            }
-
-            case eclibc_printf_phone_number:
-            {
-                char tempPhone[20];
-                char *__restrict phoneHead = tempPhone + 19;
-                if(__ec_args->NumberLeft < 1)
-                    __ec_args->NumberLeft = 12;
-                else if(__ec_args->NumberLeft > 19)
-                    __ec_args->NumberLeft = 19;
-                tempPhone[19] = '\0';
-                EC_SCRATCH_1(uint64_t) = va_arg(__arg, uint64_t);
-                phoneHead = ec_itoa_uint64_t(EC_SCRATCH_1(uint64_t),
-                                                              phoneHead, 10, 1);
-                if(phoneHead < (tempPhone + 19 - __ec_args->NumberLeft))
-                    phoneHead = (tempPhone + 19 - __ec_args->NumberLeft);
-                strcat(__s, "+");
-                ec_sfpad_string(__s, __ec_args->NumberLeft, '0',
-                                                phoneHead, (tempPhone + 19));
-                return true;
-            }
-
-            case eclibc_printf_IPv4_Address:
-            {
-                char tempIP[17];
-                char *__restrict IP_head = tempIP + 16;
-                if(__ec_args->alternateForm)
-                    (EC_SCRATCH_1(ec_ipv4_t)).IP = va_arg(__arg, uint32_t);
-                else
-                    (EC_SCRATCH_1(ec_ipv4_t))    = va_arg(__arg, ec_ipv4_t);
-                tempIP[16] = '\0';
-                #define __EC_PRINTF_READ_NUM(INDEX)                            \
-                IP_head = ec_itoa_uint8_t(                                     \
-                        (EC_SCRATCH_1(ec_ipv4_t)).display_string.byte##INDEX , \
-                                IP_head, 10, 1);
-                __EC_PRINTF_READ_NUM(4);
-                *--IP_head = '.';
-                __EC_PRINTF_READ_NUM(3);
-                *--IP_head = '.';
-                __EC_PRINTF_READ_NUM(2);
-                *--IP_head = '.';
-                __EC_PRINTF_READ_NUM(1);
-                #undef __EC_PRINTF_READ_NUM
-                ec_sfpad_string(__s, __ec_args->NumberLeft, ' ',
-                                IP_head, tempIP + 16);
-                return true;
-            }
-
-            case eclibc_printf_IPv6_Address:
-            {
-                char tempIP[41];
-                char *__restrict IP_head = tempIP + 40;
-                (EC_SCRATCH_1(ec_ipv6_t)) = va_arg(__arg, ec_ipv6_t);
-                tempIP[40] = '\0';
-                #define __EC_PRINTF_READ_NUM(INDEX)                            \
-                IP_head = ec_itoa_uint16_t(                                    \
-                        (EC_SCRATCH_1(ec_ipv6_t)).display_string.byte##INDEX , \
-                                IP_head, 16, __ec_args->alternateForm);
-                __EC_PRINTF_READ_NUM(8); *--IP_head = ':';
-                __EC_PRINTF_READ_NUM(7); *--IP_head = ':';
-                __EC_PRINTF_READ_NUM(6); *--IP_head = ':';
-                __EC_PRINTF_READ_NUM(5); *--IP_head = ':';
-                __EC_PRINTF_READ_NUM(4); *--IP_head = ':';
-                __EC_PRINTF_READ_NUM(3); *--IP_head = ':';
-                __EC_PRINTF_READ_NUM(2); *--IP_head = ':';
-                __EC_PRINTF_READ_NUM(1);
-                #undef __EC_PRINTF_READ_NUM
-                ec_sfpad_string(__s, __ec_args->NumberLeft, ' ',
-                                IP_head, tempIP + 40);
-                return true;
-            }
-
-            case eclibc_printf_MAC_PC_Version:
-            case eclibc_printf_MAC_PC_Version_caps:
-            {
-                char tempMAC[3];
-                char *__restrict MAC_head;
-                if(__ec_args->alternateForm)
-                    (EC_SCRATCH_1(ec_mac_t)).MAC = va_arg(__arg, uint64_t);
-                else
-                    (EC_SCRATCH_1(ec_mac_t))     = va_arg(__arg, ec_mac_t);
-                tempMAC[2] = '\0';
-                #define __EC_PRINTF_PRINT_NUM(INDEX)                           \
-                MAC_head = tempMAC + 2;                                        \
-                MAC_head = ec_itoa_uint8_t(                                    \
-                        (EC_SCRATCH_1(ec_mac_t)).display_string.byte##INDEX ,  \
-                                MAC_head, 16, ((__ec_args->format_chr ==       \
-                                 eclibc_printf_MAC_PC_Version_caps) ? 1 : 0)); \
-                ec_sfpad_string(__s, 2, ' ', MAC_head, tempMAC + 2);
-
-                __EC_PRINTF_PRINT_NUM(1);
-                strcat(__s, ":");
-                __EC_PRINTF_PRINT_NUM(2);
-                strcat(__s, ":");
-                __EC_PRINTF_PRINT_NUM(3);
-                strcat(__s, ":");
-                __EC_PRINTF_PRINT_NUM(4);
-                strcat(__s, ":");
-                __EC_PRINTF_PRINT_NUM(5);
-                strcat(__s, ":");
-                __EC_PRINTF_PRINT_NUM(6);
-
-                #undef __EC_PRINTF_PRINT_NUM
-                return true;
-            }
-
-            case eclibc_printf_MAC_CISCO:
-            case eclibc_printf_MAC_CISCO_caps:
-            {
-                char tempMAC[4];
-                char *__restrict MAC_head;
-                if(__ec_args->alternateForm)
-                    (EC_SCRATCH_1(ec_mac_t)).MAC = va_arg(__arg, uint64_t);
-                else
-                    (EC_SCRATCH_1(ec_mac_t))     = va_arg(__arg, ec_mac_t);
-                tempMAC[3] = '\0';
-                #define __EC_PRINTF_PRINT_NUM(INDEX)                           \
-                MAC_head = tempMAC + 3;                                        \
-                MAC_head = ec_itoa_uint16_t(                                   \
-                        (EC_SCRATCH_1(ec_mac_t)).cisco_string.byte##INDEX ,    \
-                                MAC_head, 16, ((__ec_args->format_chr ==       \
-                                      eclibc_printf_MAC_CISCO_caps) ? 1 : 0)); \
-                ec_sfpad_string(__s, 3, ' ', MAC_head, tempMAC + 3);
-
-                __EC_PRINTF_PRINT_NUM(1);
-                strcat(__s, ".");
-                __EC_PRINTF_PRINT_NUM(2);
-                strcat(__s, ".");
-                __EC_PRINTF_PRINT_NUM(3);
-
-                #undef __EC_PRINTF_PRINT_NUM
-                return true;
-            }
-
-            case eclibc_printf_base_2:
-            {
-                switch(__ec_args->Size)
-                {
-                    case 0:
-                        EC_SCRATCH_1(uint8_t) = (uint8_t)va_arg(__arg, int);
-                        __ec_sprintf_int(uint8_t, 2, 0);
-                        return true;
-                    case 1:
-                        EC_SCRATCH_1(uint16_t)
-                                          = (uint16_t)va_arg(__arg, int);
-                        __ec_sprintf_int(uint16_t, 2, 0);
-                        return true;
-                    case 2:
-                        EC_SCRATCH_1(uint32_t) = va_arg(__arg, uint32_t);
-                        __ec_sprintf_int(uint32_t, 2, 0);
-                        return true;
-                    default:
-                        EC_SCRATCH_1(uint64_t) = va_arg(__arg, uint64_t);
-                        __ec_sprintf_int(uint64_t, 2, 0);
-                        return true;
-                };
-                return true;
-            }
-
-            case eclibc_printf_base_8:
-            {
-                switch(__ec_args->Size)
-                {
-                    case 0:
-                        EC_SCRATCH_1(uint8_t) = (uint8_t)va_arg(__arg, int);
-                        __ec_sprintf_int(uint8_t, 8, 0);
-                        return true;
-                    case 1:
-                        EC_SCRATCH_1(uint16_t)
-                                          = (uint16_t)va_arg(__arg, int);
-                        __ec_sprintf_int(uint16_t, 8, 0);
-                        return true;
-                    case 2:
-                        EC_SCRATCH_1(uint32_t) = va_arg(__arg, uint32_t);
-                        __ec_sprintf_int(uint32_t, 8, 0);
-                        return true;
-                    default:
-                        EC_SCRATCH_1(uint64_t) = va_arg(__arg, uint64_t);
-                        __ec_sprintf_int(uint64_t, 8, 0);
-                        return true;
-                };
-                return true;
-            }
-
-            case eclibc_printf_base_16:
-            {
-                switch(__ec_args->Size)
-                {
-                    case 0:
-                        EC_SCRATCH_1(uint8_t) = (uint8_t)va_arg(__arg, int);
-                        __ec_sprintf_int(uint8_t, 16,
-                                       (__ec_args->alternateForm == 1) ? 1 : 0);
-                        return true;
-                    case 1:
-                        EC_SCRATCH_1(uint16_t)
-                                          = (uint16_t)va_arg(__arg, int);
-                        __ec_sprintf_int(uint16_t, 16,
-                                       (__ec_args->alternateForm == 1) ? 1 : 0);
-                        return true;
-                    case 2:
-                        EC_SCRATCH_1(uint32_t) = va_arg(__arg, uint32_t);
-                        __ec_sprintf_int(uint32_t, 16,
-                                       (__ec_args->alternateForm == 1) ? 1 : 0);
-                        return true;
-                    default:
-                        EC_SCRATCH_1(uint64_t) = va_arg(__arg, uint64_t);
-                        __ec_sprintf_int(uint64_t, 16,
-                                       (__ec_args->alternateForm == 1) ? 1 : 0);
-                        return true;
-                };
-                return true;
-            }
-
-            case eclibc_printf_time_seconds:
-            case eclibc_printf_time_seconds_short:
-            {
-                char mode[4] = "";
-                __ec_scratch_memory = va_arg(__arg, struct tm);
-                if(__ec_args->alternateForm == 1)
-                {
-                    mode[0] = ' ';
-                    mode[2] = 'M';
-                    mode[3] = '\0';
-                    if(__ec_scratch_memory.tm_hour > 12)
-                    {
-                        __ec_scratch_memory.tm_hour -= 12;
-                        mode[1] = 'P';
-                    }
-                    else
-                        mode[1] = 'A';
-                }
-                __ec_sprintf_digits(__ec_scratch_memory.tm_hour, 2);
-                strcat(__s, ":");
-                __ec_sprintf_digits(__ec_scratch_memory.tm_min, 2);
-                if(__ec_args->format_chr == eclibc_printf_time_seconds)
-                {
-                    strcat(__s, ":");
-                    __ec_sprintf_digits(__ec_scratch_memory.tm_sec, 2);
-                }
-                strcat(__s, mode);
-                return true;
-            }
+        ec_strbuf_init_fixed(&buf, __dst, __size);
+    ec_strbuf_append_vfmt(&buf, __src, __arg);
+    return (int)(buf.len + buf.dropped);
+}
 
-            case eclibc_printf_Time_struct_tm:
-            case eclibc_printf_time_struct_tm_short:
-            {
-                char mode[4] = "";
-                uint32_t tempInt = va_arg(__arg, uint32_t);
-                __ec_scratch_memory.tm_hour = (int)(tempInt / 3600);
-                __ec_scratch_memory.tm_min  = (int)((tempInt % 3600) / 60);
-                __ec_scratch_memory.tm_sec  = (int)(tempInt % 60);
-                if(__ec_args->alternateForm == 1)
-                {
-                    mode[0] = ' ';
-                    mode[2] = 'M';
-                    mode[3] = '\0';
-                    if(__ec_scratch_memory.tm_hour > 12)
-                    {
-                        __ec_scratch_memory.tm_hour -= 12;
-                        mode[1] = 'P';
-                    }
-                    else
-                        mode[1] = 'A';
-                }
-                __ec_sprintf_digits(__ec_scratch_memory.tm_hour, 2);
-                strcat(__s, ":");
-                __ec_sprintf_digits(__ec_scratch_memory.tm_min, 2);
-                if(__ec_args->format_chr == eclibc_printf_Time_struct_tm)
-                {
-                    strcat(__s, ":");
-                    __ec_sprintf_digits(__ec_scratch_memory.tm_sec, 2);
-                }
-                strcat(__s, mode);
-                return true;
-            }
+__attribute__((hot,noinline))
+int
+ec_snprintf(char *__restrict __dst, size_t __size,
+                                        const char *__restrict __src, ...)
+{
+    int result;
+    va_list argptr;
+    va_start(argptr, __src);
+    result = ec_vsnprintf(__dst, __size, __src, argptr);
+    va_end(argptr);
+    return result;
+}
 
-            case eclibc_printf_date_2digit:
-            case eclibc_printf_date_4digit:
-            {
-                __ec_scratch_memory = va_arg(__arg, struct tm);
-                __ec_scratch_memory.tm_year += 1900;
-                if(__ec_args->alternateForm == 1)
-                {
-                    strcat(__s, ec_month_name_str[__ec_scratch_memory.tm_mon]);
-                    strcat(__s, " ");
-                    __ec_sprintf_digits(__ec_scratch_memory.tm_mday, 2);
-                    if(__ec_scratch_memory.tm_mday > 3 &&
-                            __ec_scratch_memory.tm_mday <= 20)
-                        strcat(__s, "th ");
-                    else if(__ec_scratch_memory.tm_mday % 10 == 1)
-                        strcat(__s, "st ");
-                    else if(__ec_scratch_memory.tm_mday % 10 == 2)
-                        strcat(__s, "nd ");
-                    else
-                        strcat(__s, "th ");
-                    __ec_sprintf_digits(__ec_scratch_memory.tm_year,
-                                         ((__ec_args->format_chr ==
-                                               eclibc_printf_date_4digit)
-                                                                      ? 4 : 2));
-                }
-                else
-                {
-                    __ec_sprintf_digits(__ec_scratch_memory.tm_mday, 2);
-                    strcat(__s, "/");
-                    __ec_sprintf_digits((__ec_scratch_memory.tm_mon + 1), 2);
-                    strcat(__s, "/");
-                    __ec_sprintf_digits(__ec_scratch_memory.tm_year,
-                                         ((__ec_args->format_chr ==
-                                               eclibc_printf_date_4digit)
-                                                                      ? 4 : 2));
-                }
-                return true;
-            }
+/* Only counts the characters, the storage is just reused. */
+static bool
+__ec_printf_len_sink(void *__count, const char *data, size_t len)
+{
+    (void)data;
+    *(size_t *)__count += len;
+    return true;
+}
 
-            case eclibc_printf_utc_time:
-            {
-                __ec_scratch_memory = va_arg(__arg, struct tm);
-                __ec_scratch_memory.tm_year += 1900;
-                __ec_sprintf_digits(__ec_scratch_memory.tm_year, 4);
-                strcat(__s, "-");
-                __ec_sprintf_digits(__ec_scratch_memory.tm_mon, 2);
-                strcat(__s, "-");
-                __ec_sprintf_digits(__ec_scratch_memory.tm_mday, 2);
-                strcat(__s, "T");
-                __ec_sprintf_digits(__ec_scratch_memory.tm_hour, 2);
-                strcat(__s, ":");
-                __ec_sprintf_digits(__ec_scratch_memory.tm_min, 2);
-                strcat(__s, ":");
-                __ec_sprintf_digits(__ec_scratch_memory.tm_sec, 2);
-                strcat(__s, "Z");
-                return true;
-            }
+__attribute__((hot,noinline))
+size_t
+ec_vprintf_len(const char *__restrict __src, va_list __arg)
+{
+    char storage[128];
+    size_t count = 0;
+    ec_strbuf buf;
+    ec_strbuf_init_sink(&buf, storage, sizeof(storage),
+                                            __ec_printf_len_sink, &count);
+    ec_strbuf_append_vfmt(&buf, __src, __arg);
+    return count + buf.len;
+}
 
-            default:
-                return false;
-        }
-    }
-    #undef EC_SCRATCH_1
-    #undef EC_SCRATCH_2
-    return false;
+__attribute__((hot,noinline))
+size_t
+ec_printf_len(const char *__restrict __src, ...)
+{
+    size_t result;
+    va_list argptr;
+    va_start(argptr, __src);
+    result = ec_vprintf_len(__src, argptr);
+    va_end(argptr);
+    return result;
 }
 
 __attribute__((hot,noinline))
-int
-ec_vsprintf(char *__restrict __dst, const char *__restrict __src,
-                                                                 va_list __arg)
+char *
+ec_vasprintf_alloc(ec_printf_alloc_t __alloc, void *__context, size_t *__len,
+                               const char *__restrict __src, va_list __arg)
 {
-    const char *__restrict __ec_printf_temp_buffer_tail = __src;
-    const char *__restrict __ec_printf_temp_buffer;
-    __attribute__((unused)) const char *__restrict __ec_printf_temp_buffer_temp;
-    const char *__restrict __ec_printf_temp_buffer_end =
-                                                    __src + strlen(__src);
-    __ec_printf_args __ec_args;
-    __dst[0] = '\0';
-    while(*__ec_printf_temp_buffer_tail != '\0')
+    char storage[EC_ASPRINTF_BUFFER_SIZE];
+    char *result;
+    size_t len;
+    /* "%m" must see the same errno in both passes. */
+    int error = errno;
+    ec_strbuf buf;
+    va_list again;
+    va_copy(again, __arg);
+    /* Short outputs are formatted once, to the stack, and copied. The longer
+     * ones only get their length there, and are formatted again right into
+     * their allocation. */
+    ec_strbuf_init_fixed(&buf, storage, sizeof(storage));
+    ec_strbuf_append_vfmt(&buf, __src, __arg);
+    len = buf.len + buf.dropped;
+    result = (char *)__alloc(__context, len + 1);
+    if(result != EC_NULL)
     {
-        #ifdef __EC_VPRINTF_USE_STRCHR
-        __ec_printf_temp_buffer = strchr(__ec_printf_temp_buffer_tail, '%');
-        #else
-        __ec_printf_temp_buffer = memchr(
-                            (const void*)__ec_printf_temp_buffer_tail, (int)'%',
-                                     (size_t)(__ec_printf_temp_buffer_end -
-                                              __ec_printf_temp_buffer_tail) );
-        #endif
-        /* No formatting were found */
-        if(__ec_printf_temp_buffer == EC_NULL ||
-                __ec_printf_temp_buffer_end <= __ec_printf_temp_buffer)
-        {
-            strcat(__dst, __ec_printf_temp_buffer_tail);
-            return ((int)(strlen(__dst)));
-        }
+        if(buf.dropped == 0)
+            memcpy(result, storage, len + 1);
         else
         {
-            strncat (__dst, __ec_printf_temp_buffer_tail, (size_t)
-                      (__ec_printf_temp_buffer - __ec_printf_temp_buffer_tail));
+            errno = error;
+            ec_strbuf_init_fixed(&buf, result, len + 1);
+            ec_strbuf_append_vfmt(&buf, __src, again);
+            len = buf.len;
+        }
+        if(__len != EC_NULL)
+            *__len = len;
+    }
+    va_end(again);
+    return result;
+}
 
-            __ec_printf_temp_buffer_temp =
-                      __ec_printf_extract_format (__ec_printf_temp_buffer,
-                                                             &__ec_args, __arg);
+__attribute__((hot,noinline))
+char *
+ec_asprintf_alloc(ec_printf_alloc_t __alloc, void *__context, size_t *__len,
+                                        const char *__restrict __src, ...)
+{
+    char *result;
+    va_list argptr;
+    va_start(argptr, __src);
+    result = ec_vasprintf_alloc(__alloc, __context, __len, __src, argptr);
+    va_end(argptr);
+    return result;
+}
 
-            if(__ec_sprintf_perform(__dst, &__ec_args, __arg) == false)
-                strncat (__dst, __ec_printf_temp_buffer, (size_t)
-                      (__ec_printf_temp_buffer_temp - __ec_printf_temp_buffer));
+static void *
+__ec_asprintf_malloc(void *__context, size_t size)
+{
+    (void)__context;
+    return malloc(size);
+}
 
-            __ec_printf_temp_buffer_tail = __ec_printf_temp_buffer_temp;
-        }
-    }
-    return ((int)(strlen(__dst)));
+__attribute__((hot,noinline))
+int
+ec_vasprintf(char **__strp, const char *__restrict __src, va_list __arg)
+{
+    size_t len;
+    *__strp = ec_vasprintf_alloc(__ec_asprintf_malloc, EC_NULL, &len,
+                                                               __src, __arg);
+    if(*__strp == EC_NULL)
+        return -1;
+    return (int)len;
 }
 
 __attribute__((hot,noinline))
 int
-ec_sprintf(char *__restrict __dst, const char *__restrict __src, ...)
+ec_asprintf(char **__strp, const char *__restrict __src, ...)
 {
     int result;
     va_list argptr;
     va_start(argptr, __src);
-    result = ec_vsprintf(__dst, __src, argptr);
+    result = ec_vasprintf(__strp, __src, argptr);
     va_end(argptr);
     return result;
 }
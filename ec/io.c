@@ -27,6 +27,8 @@
 #endif
 
 #include <ec/string.h>
+#include <ec/internal/text_parse/atoi.h>
+#include <ec/internal/text_parse/atof.h>
 
 #include <ec/io.h>
 #include <ec/vector.h>
@@ -162,13 +164,52 @@ void ec_popen(char *command, char *respond, size_t respond_size)
     pclose(fp);
 }
 
+/**
+ * @brief ec_popen_sstring     A wrapper around standard popen function. It runs
+ *                             the given command and stores the first line of
+ *                             the response, whatever its length, inside the
+ *                             given string. Short responses don't allocate.
+ * @param [in]command          The command to be run.
+ * @param [out]respond         The string to hold the response. It must be
+ *                             initialized.
+ * @return                     false if the command could not be run or the
+ *                             allocation failed.
+ */
+bool ec_popen_sstring(char *command, ec_sstring *respond)
+{
+    char chunk[128];
+    size_t len;
+    bool result = true;
+    FILE *fp;
+
+    ec_sstring_clear(respond);
+    fp = popen(command, "r");
+    if(fp == EC_NULL)
+        return false;
+
+    while(fgets(chunk, sizeof(chunk), fp) != EC_NULL)
+    {
+        len = strlen(chunk);
+        if(!ec_sstring_append(respond, chunk, len))
+        {
+            result = false;
+            break;
+        }
+        if(len > 0 && chunk[len - 1] == '\n')
+            break;
+    }
+
+    pclose(fp);
+    return result;
+}
+
 /**
  * @brief ec_int_popen          A wrapper around standard popen function. It
  *                              runs the given command that is supposed to only
  *                              return an integer value. Then converts the
  *                              given respond to integer and returns the value.
- *                              If the respond is not an integer, the builtin
- *                              atoi function's behaviour is returning 0.
+ *                              If the respond is not an integer, 0 is
+ *                              returned. Out of range values are saturated.
  * @param command               The command to be run.
  * @return                      The respond converted to integer.
  */
@@ -177,8 +218,14 @@ int ec_int_popen(char *command)
     /* max uint64 = 0xFFFFFFFFFFFFFFFF = 18446744073709551615 */
     /* A 64bit unsigned integer can take up to 21 characters  */
     char temp[25];
+    const char *ptr = temp;
+    int result;
+    temp[0] = '\0';
     ec_popen(command, temp, sizeof(temp));
-    return atoi(temp);
+    while(*ptr == ' ' || *ptr == '\t')
+        ptr++;
+    ec_parse_int(ptr, strlen(ptr), 10, &result, EC_NULL);
+    return result;
 }
 
 /**
@@ -187,8 +234,9 @@ int ec_int_popen(char *command)
  *                              return an integer value or a double value. Then
  *                              converts the given respond to double and
  *                              returns the value.
- *                              If the respond is not a valid number, the
- *                              builtin atof function's behavior is returning 0.
+ *                              If the respond is not a valid number, 0 is
+ *                              returned. The conversion doesn't depend on the
+ *                              current locale.
  * @param command               The command to be run.
  * @return                      The respond converted to double.
  */
@@ -198,8 +246,9 @@ double ec_double_popen(char *command)
     /* A 64bit double can hold a 18 characters long integer. roughly
      * it can hold a 20~22 characters long floating value. */
     char temp[25];
+    temp[0] = '\0';
     ec_popen(command, temp, sizeof(temp));
-    return atof(temp);
+    return ec_strtod(temp, EC_NULL);
 }
 
 /**
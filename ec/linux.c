@@ -29,6 +29,7 @@
 #include <ec/io.h>
 #include <ec/linux.h>
 #include <ec/string.h>
+#include <ec/internal/text_parse/atoi.h>
 
 #ifdef __linux__
 
@@ -245,22 +246,26 @@ bool
 ec_net_interface_name(char *ptr, int ifIndex)
 {
     FILE *f;
-    char line[100] , *p , *c;
+    char line[100];
+    ec_tokenizer tokenizer;
+    ec_strview name, destination;
 
     f = fopen("/proc/net/route" , "r");
 
     while(fgets(line , 100 , f))
     {
-        p = strtok(line , " \t");
-        c = strtok(NULL , " \t");
+        ec_tokenizer_init(&tokenizer, ec_strview_from_cstr(line),
+                          EC_TOKENIZE_WHITESPACE, EC_NULL);
 
-        if(p != NULL && c != NULL)
+        if(ec_tokenizer_next(&tokenizer, &name) &&
+           ec_tokenizer_next(&tokenizer, &destination))
         {
-            if(strcmp(c , "00000000") == 0)
+            if(ec_strview_equals(destination, ec_strview_literal("00000000")))
             {
                 if(ifIndex-- == 0)
                 {
-                    strcpy(ptr, p);
+                    memcpy(ptr, name.ptr, name.len);
+                    ptr[name.len] = '\0';
                     fclose(f);
                     return true;
                 }
@@ -284,7 +289,9 @@ ec_ipv4_t ec_net_get_interface_ipv4(char *ifName)
     struct ifaddrs *ifaddr, *ifa;
     int family , s;
     char host[NI_MAXHOST];
-    char *ptr;
+    ec_tokenizer tokenizer;
+    ec_strview token;
+    uint8_t byte;
     ec_ipv4_t result;
     result.IP = 0;
 
@@ -313,10 +320,14 @@ ec_ipv4_t ec_net_get_interface_ipv4(char *ifName)
                 if (s != 0)
                     break;
 
+                /* A missing field leaves "token" empty, which reads as 0. */
+                ec_tokenizer_init(&tokenizer, ec_strview_from_cstr(host),
+                                  EC_TOKENIZE_CHAR, ".");
                 #define __readToken(index)                                     \
-                ptr = strtok(((index == 1) ? host : EC_NULL) , ".");           \
-                result.display_string.byte##index =                            \
-                                            (unsigned int)atoi(ptr) & 0xFF;
+                if(!ec_tokenizer_next(&tokenizer, &token))                     \
+                    token = ec_strview_literal("");                            \
+                ec_parse_uint8_t(token.ptr, token.len, 10, &byte, EC_NULL);    \
+                result.display_string.byte##index = byte;
                 __readToken(1);
                 __readToken(2);
                 __readToken(3);
@@ -343,7 +354,9 @@ ec_ipv6_t ec_net_get_interface_ipv6(char *ifName, int ipIndex)
     struct ifaddrs *ifaddr, *ifa;
     int family , s;
     char host[NI_MAXHOST];
-    char *ptr;
+    ec_tokenizer tokenizer;
+    ec_strview token;
+    uint16_t word;
     ec_ipv6_t result;
     result._64bit.part1 = 0;
     result._64bit.part2 = 0;
@@ -375,10 +388,13 @@ ec_ipv6_t ec_net_get_interface_ipv6(char *ifName, int ipIndex)
                 if(strchr(host, '%') != EC_NULL)
                     continue;
 
+                ec_tokenizer_init(&tokenizer, ec_strview_from_cstr(host),
+                                  EC_TOKENIZE_CHAR, ":");
                 #define __readToken(index)                                     \
-                ptr = strtok(((index == 1) ? host : EC_NULL) , ":");           \
-                result.display_string.byte##index =                            \
-                        (unsigned int)strtol(ptr, EC_NULL, 16) & 0xFFFF;
+                if(!ec_tokenizer_next(&tokenizer, &token))                     \
+                    token = ec_strview_literal("");                            \
+                ec_parse_uint16_t(token.ptr, token.len, 16, &word, EC_NULL);   \
+                result.display_string.byte##index = word;
                 __readToken(1);
                 __readToken(2);
                 __readToken(3);
@@ -22,6 +22,7 @@
  ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
  **/
 
+#include <stdlib.h>
 #include <ec/map.h>
 
 #ifdef __cplusplus
@@ -29,9 +30,128 @@ extern "C"
 {
 #endif
 
-typedef int DUMMY_TYPEDEF_TO_AVOID_PEDANTIC_ERROR;
+/* Number of keys sharing a single cache line. Prefetching the node
+ * "k * EC_FLATMAP_KEYS_PER_LINE" brings in all the 8 great-great-children of
+ * the node "k", which is three levels ahead of the search loop. */
+#define EC_FLATMAP_KEYS_PER_LINE    8
+#define EC_FLATMAP_CACHE_LINE       64
 
-#ifdef __cplusplus
+#if defined(__GNUC__) || defined(__clang__)
+#define __ec_flatmap_prefetch(_ptr)  __builtin_prefetch(_ptr)
+#else
+#define __ec_flatmap_prefetch(_ptr)  ((void)(_ptr))
+#endif
+
+static size_t __ec_flatmap_fill(ec_flatmap *map, const uint64_t *keys,
+                                void *const *values, size_t index, size_t k)
+{
+    if(k <= map->size)
+    {
+        index = __ec_flatmap_fill(map, keys, values, index, 2 * k);
+        map->keys[k] = keys[index];
+        if(values != EC_NULL)
+            map->values[k] = values[index];
+        index++;
+        index = __ec_flatmap_fill(map, keys, values, index, 2 * k + 1);
+    }
+    return index;
 }
+
+/* Returns the Eytzinger index of the lower bound of the key, 0 if there is
+ * none. */
+static inline size_t
+__attribute__ ((hot,always_inline))
+__ec_flatmap_search(const ec_flatmap *map, uint64_t key)
+{
+    const uint64_t *keys = map->keys;
+    size_t k = 1;
+    while(k <= map->size)
+    {
+        __ec_flatmap_prefetch(keys + k * EC_FLATMAP_KEYS_PER_LINE);
+        k = 2 * k + (size_t)(keys[k] < key);
+    }
+    /* The path went right on every "keys[k] < key" step and the lower bound is
+     * the last node where it went left. Drop the trailing right turns and that
+     * left turn itself. */
+#if defined(__GNUC__) || defined(__clang__)
+    k >>= (unsigned)__builtin_ctzll(~(unsigned long long)k) + 1U;
+#else
+    while(k & 1)
+        k >>= 1;
+    k >>= 1;
 #endif
+    return k;
+}
+
+bool ec_flatmap_build(ec_flatmap *map, const uint64_t *keys,
+                      void *const *values, size_t count)
+{
+    size_t index;
+    map->keys      = EC_NULL;
+    map->values    = EC_NULL;
+    map->size      = 0;
+    map->__storage = EC_NULL;
+    for(index = 1; index < count; index++)
+    {
+        if(keys[index - 1] > keys[index])
+            return false;
+    }
+    map->__storage = malloc((count + 1) * sizeof(uint64_t) +
+                            EC_FLATMAP_CACHE_LINE);
+    if(map->__storage == EC_NULL)
+        return false;
+    map->keys = (uint64_t *)(void *)
+        (((uintptr_t)map->__storage + EC_FLATMAP_CACHE_LINE - 1) &
+         ~(uintptr_t)(EC_FLATMAP_CACHE_LINE - 1));
+    if(values != EC_NULL)
+    {
+        map->values = (void **)malloc((count + 1) * sizeof(void *));
+        if(map->values == EC_NULL)
+        {
+            free(map->__storage);
+            map->__storage = EC_NULL;
+            map->keys = EC_NULL;
+            return false;
+        }
+    }
+    map->size = count;
+    __ec_flatmap_fill(map, keys, values, 0, 1);
+    return true;
+}
+
+void ec_flatmap_delete(ec_flatmap *map)
+{
+    free(map->__storage);
+    free((void *)map->values);
+    map->keys      = EC_NULL;
+    map->values    = EC_NULL;
+    map->size      = 0;
+    map->__storage = EC_NULL;
+}
+
+bool ec_flatmap_find(const ec_flatmap *map, uint64_t key, void **value)
+{
+    size_t k = __ec_flatmap_search(map, key);
+    if(k == 0 || map->keys[k] != key)
+        return false;
+    if(value != EC_NULL)
+        *value = (map->values != EC_NULL) ? map->values[k] : EC_NULL;
+    return true;
+}
 
+bool ec_flatmap_lower_bound(const ec_flatmap *map, uint64_t key,
+                            uint64_t *found_key, void **value)
+{
+    size_t k = __ec_flatmap_search(map, key);
+    if(k == 0)
+        return false;
+    if(found_key != EC_NULL)
+        *found_key = map->keys[k];
+    if(value != EC_NULL)
+        *value = (map->values != EC_NULL) ? map->values[k] : EC_NULL;
+    return true;
+}
+
+#ifdef __cplusplus
+}
+#endif
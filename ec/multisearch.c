@@ -0,0 +1,445 @@
+/* <multisearch.c> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <stdlib.h>
+#include <ec/multisearch.h>
+#include <ec/internal/simd.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#define __EC_MULTISEARCH_NONE   UINT32_MAX
+
+static inline uint8_t
+__attribute__ ((always_inline))
+__ec_multisearch_fold(uint8_t byte, unsigned flags)
+{
+    if((flags & EC_MULTISEARCH_IGNORE_CASE) && byte >= 'A' && byte <= 'Z')
+        return (uint8_t)(byte | 0x20);
+    return byte;
+}
+
+bool ec_multisearch_build(ec_multisearch *search,
+                          const char *const *patterns, const size_t *lengths,
+                          size_t count, unsigned flags)
+{
+    /* Temporary automaton, numbered in the trie creation order. */
+    uint32_t *trie = EC_NULL;
+    uint32_t *fail = EC_NULL;
+    uint32_t *dict = EC_NULL;
+    uint32_t *queue = EC_NULL;
+    uint32_t *terminal = EC_NULL;
+    uint32_t *pattern_next = EC_NULL;
+    uint32_t *pattern_state = EC_NULL;
+    uint32_t *renumber = EC_NULL;
+    uint32_t *original = EC_NULL;
+    uint32_t *match_count = EC_NULL;
+    bool used[256];
+    size_t total = 0, match_total = 0, matching = 0;
+    size_t index, state_count, class_count, max_states, head, tail;
+    uint32_t state, next, link, klass;
+    bool result = false;
+    char *storage;
+
+    memset(search, 0, sizeof(ec_multisearch));
+    memset(used, 0, sizeof(used));
+    for(index = 0; index < count; index++)
+    {
+        size_t len = (lengths != EC_NULL) ? lengths[index] :
+                                            strlen(patterns[index]);
+        const uint8_t *pattern = (const uint8_t *)patterns[index];
+        size_t position;
+        if(len == 0)
+            return false;
+        total += len;
+        for(position = 0; position < len; position++)
+            used[__ec_multisearch_fold(pattern[position], flags)] = true;
+    }
+
+    /* Byte classes: each byte used by the patterns gets its own column of
+     * the table, all the other bytes share column 0. If every byte is used,
+     * the bytes are the classes. */
+    class_count = 0;
+    for(index = 0; index < 256; index++)
+        class_count += used[index] ? 1 : 0;
+    if(class_count == 256)
+    {
+        for(index = 0; index < 256; index++)
+            search->classes[index] = (uint8_t)index;
+    }
+    else
+    {
+        class_count = 1;
+        for(index = 0; index < 256; index++)
+            search->classes[index] = used[index] ? (uint8_t)class_count++ : 0;
+    }
+    if(flags & EC_MULTISEARCH_IGNORE_CASE)
+    {
+        for(index = 'A'; index <= 'Z'; index++)
+            search->classes[index] = search->classes[index | 0x20];
+    }
+
+    max_states = total + 1;
+    if(max_states > UINT32_MAX / class_count || count >= UINT32_MAX)
+        return false;
+
+    trie          = (uint32_t *)calloc(max_states * class_count,
+                                       sizeof(uint32_t));
+    fail          = (uint32_t *)malloc(max_states * sizeof(uint32_t));
+    dict          = (uint32_t *)malloc(max_states * sizeof(uint32_t));
+    queue         = (uint32_t *)malloc(max_states * sizeof(uint32_t));
+    terminal      = (uint32_t *)malloc(max_states * sizeof(uint32_t));
+    renumber      = (uint32_t *)malloc(max_states * sizeof(uint32_t));
+    original      = (uint32_t *)malloc(max_states * sizeof(uint32_t));
+    match_count   = (uint32_t *)calloc(max_states, sizeof(uint32_t));
+    pattern_next  = (uint32_t *)malloc((count + 1) * sizeof(uint32_t));
+    pattern_state = (uint32_t *)malloc((count + 1) * sizeof(uint32_t));
+    if(trie == EC_NULL || fail == EC_NULL || dict == EC_NULL ||
+       queue == EC_NULL || terminal == EC_NULL || renumber == EC_NULL ||
+       original == EC_NULL || match_count == EC_NULL ||
+       pattern_next == EC_NULL || pattern_state == EC_NULL)
+        goto __ec_multisearch_build_exit;
+
+    /* The trie */
+    state_count = 1;
+    for(index = 0; index < count; index++)
+    {
+        size_t len = (lengths != EC_NULL) ? lengths[index] :
+                                            strlen(patterns[index]);
+        const uint8_t *pattern = (const uint8_t *)patterns[index];
+        size_t position;
+        state = 0;
+        for(position = 0; position < len; position++)
+        {
+            klass = search->classes[pattern[position]];
+            if(trie[state * class_count + klass] == 0)
+                trie[state * class_count + klass] = (uint32_t)state_count++;
+            state = trie[state * class_count + klass];
+        }
+        pattern_state[index] = state;
+    }
+    for(index = 0; index < state_count; index++)
+        terminal[index] = __EC_MULTISEARCH_NONE;
+    /* Linked backwards, so the lists end up in ascending ID order. */
+    for(index = count; index-- > 0;)
+    {
+        pattern_next[index] = terminal[pattern_state[index]];
+        terminal[pattern_state[index]] = (uint32_t)index;
+    }
+
+    /* Failure links in breadth first order. The missing transitions of a
+     * state are copied from its failure state, which is shallower and
+     * therefore already complete, turning the trie into a DFA. "dict" links
+     * each state to the closest state in its failure chain which ends a
+     * pattern. */
+    head = tail = 0;
+    fail[0] = 0;
+    dict[0] = __EC_MULTISEARCH_NONE;
+    for(klass = 0; klass < class_count; klass++)
+    {
+        next = trie[klass];
+        if(next != 0)
+        {
+            fail[next] = 0;
+            dict[next] = __EC_MULTISEARCH_NONE;
+            queue[tail++] = next;
+        }
+    }
+    while(head < tail)
+    {
+        state = queue[head++];
+        for(klass = 0; klass < class_count; klass++)
+        {
+            uint32_t *cell = &trie[state * class_count + klass];
+            uint32_t fallback = trie[fail[state] * class_count + klass];
+            if(*cell == 0)
+            {
+                *cell = fallback;
+                continue;
+            }
+            next = *cell;
+            fail[next] = fallback;
+            dict[next] = (terminal[fallback] != __EC_MULTISEARCH_NONE) ?
+                                                    fallback : dict[fallback];
+            queue[tail++] = next;
+        }
+    }
+
+    /* The matches of each state: its own patterns (the longest ones) and
+     * then the ones along the dict chain. */
+    for(index = 0; index < state_count; index++)
+    {
+        for(link = (uint32_t)index; link != __EC_MULTISEARCH_NONE;
+            link = dict[link])
+        {
+            uint32_t pattern;
+            for(pattern = terminal[link]; pattern != __EC_MULTISEARCH_NONE;
+                pattern = pattern_next[pattern])
+                match_count[index]++;
+        }
+        match_total += match_count[index];
+        if(match_count[index] != 0)
+            matching++;
+    }
+
+    /* Matching states are numbered last, so a single comparison per input
+     * byte tells if anything matched. The root stays 0. */
+    head = 0;
+    tail = state_count - matching;
+    for(index = 0; index < state_count; index++)
+    {
+        renumber[index] = (uint32_t)((match_count[index] != 0) ? tail++ :
+                                                                 head++);
+        original[renumber[index]] = (uint32_t)index;
+    }
+
+    search->__storage = malloc(state_count * class_count * sizeof(uint32_t) +
+                               (matching + 1) * sizeof(uint32_t) +
+                               match_total * sizeof(uint32_t) +
+                               count * sizeof(size_t));
+    if(search->__storage == EC_NULL)
+        goto __ec_multisearch_build_exit;
+    storage = (char *)search->__storage;
+    search->pattern_lengths = (size_t *)storage;
+    storage += count * sizeof(size_t);
+    search->transitions = (uint32_t *)storage;
+    storage += state_count * class_count * sizeof(uint32_t);
+    search->match_first = (uint32_t *)storage;
+    storage += (matching + 1) * sizeof(uint32_t);
+    search->match_ids = (uint32_t *)storage;
+
+    for(index = 0; index < count; index++)
+        search->pattern_lengths[index] = (lengths != EC_NULL) ?
+                                    lengths[index] : strlen(patterns[index]);
+    for(index = 0; index < state_count; index++)
+    {
+        uint32_t *row = &search->transitions[index * class_count];
+        const uint32_t *old_row = &trie[original[index] * class_count];
+        for(klass = 0; klass < class_count; klass++)
+            row[klass] = renumber[old_row[klass]] * (uint32_t)class_count;
+    }
+    match_total = 0;
+    for(index = state_count - matching; index < state_count; index++)
+    {
+        search->match_first[index - (state_count - matching)] =
+                                                        (uint32_t)match_total;
+        for(link = original[index]; link != __EC_MULTISEARCH_NONE;
+            link = dict[link])
+        {
+            uint32_t pattern;
+            for(pattern = terminal[link]; pattern != __EC_MULTISEARCH_NONE;
+                pattern = pattern_next[pattern])
+                search->match_ids[match_total++] = pattern;
+        }
+    }
+    search->match_first[matching] = (uint32_t)match_total;
+
+    search->match_threshold = (uint32_t)((state_count - matching) *
+                                         class_count);
+    search->class_count = (uint32_t)class_count;
+    search->state_count = state_count;
+    search->pattern_count = count;
+
+    search->start_count = 0;
+    for(index = 0; index < 256; index++)
+    {
+        if(search->transitions[search->classes[index]] == 0)
+            continue;
+        if(search->start_count == sizeof(search->start_bytes))
+        {
+            search->start_count = 0;
+            break;
+        }
+        search->start_bytes[search->start_count++] = (uint8_t)index;
+    }
+    result = true;
+
+    __ec_multisearch_build_exit:
+    free(trie);
+    free(fail);
+    free(dict);
+    free(queue);
+    free(terminal);
+    free(renumber);
+    free(original);
+    free(match_count);
+    free(pattern_next);
+    free(pattern_state);
+    return result;
+}
+
+void ec_multisearch_delete(ec_multisearch *search)
+{
+    free(search->__storage);
+    memset(search, 0, sizeof(ec_multisearch));
+}
+
+/* Skips to the next byte that leaves the root state, a vector at a time. */
+static inline const uint8_t *
+__attribute__ ((hot,always_inline))
+__ec_multisearch_skip(const ec_multisearch *search, const uint8_t *ptr,
+                      const uint8_t *end)
+{
+    unsigned index;
+#if defined(__EC_SIMD_WIDTH)
+    for(; end - ptr >= __EC_SIMD_WIDTH; ptr += __EC_SIMD_WIDTH)
+    {
+        __ec_simd_t block = __ec_simd_load(ptr);
+        __ec_simd_t found = __ec_simd_eq(block,
+                                __ec_simd_splat(search->start_bytes[0]));
+        uint32_t mask;
+        for(index = 1; index < search->start_count; index++)
+            found = __ec_simd_or(found, __ec_simd_eq(block,
+                                __ec_simd_splat(search->start_bytes[index])));
+        mask = __ec_simd_mask(found);
+        if(mask != 0)
+            return ptr + __ec_simd_first(mask);
+    }
+#endif
+    for(; ptr < end; ptr++)
+    {
+        for(index = 0; index < search->start_count; index++)
+        {
+            if(*ptr == search->start_bytes[index])
+                return ptr;
+        }
+    }
+    return end;
+}
+
+static size_t
+__attribute__ ((hot))
+__ec_multisearch_run(const ec_multisearch *search, uint32_t *state_io,
+                     uint64_t offset, const uint8_t *data, size_t *len_io,
+                     ec_multisearch_callback_t callback, void *context)
+{
+    const uint32_t *transitions = search->transitions;
+    const uint8_t *classes = search->classes;
+    const uint32_t threshold = search->match_threshold;
+    const bool skip = (search->start_count != 0);
+    const uint8_t *ptr = data;
+    const uint8_t *end = data + *len_io;
+    uint32_t state = *state_io;
+    size_t reported = 0;
+
+    while(ptr < end)
+    {
+        if(state == 0 && skip)
+        {
+            ptr = __ec_multisearch_skip(search, ptr, end);
+            if(ptr == end)
+                break;
+        }
+        state = transitions[state + classes[*ptr++]];
+        if(__builtin_expect(state >= threshold, 0))
+        {
+            uint32_t match = (state - threshold) / search->class_count;
+            uint32_t first = search->match_first[match];
+            uint32_t last = search->match_first[match + 1];
+            uint64_t match_end = offset + (uint64_t)(ptr - data);
+            for(; first < last; first++)
+            {
+                uint32_t id = search->match_ids[first];
+                reported++;
+                if(callback != EC_NULL &&
+                   !callback(id, match_end - search->pattern_lengths[id],
+                             context))
+                {
+                    /* Stopped: the state belongs to the end of this match,
+                     * so only the bytes up to there count as searched. */
+                    *state_io = state;
+                    *len_io = (size_t)(ptr - data);
+                    return reported;
+                }
+            }
+        }
+    }
+    *state_io = state;
+    return reported;
+}
+
+size_t ec_multisearch_feed(const ec_multisearch *search,
+                           ec_multisearch_stream *stream, const char *data,
+                           size_t len, ec_multisearch_callback_t callback,
+                           void *context)
+{
+    size_t reported;
+    if(search->transitions == EC_NULL)
+        return 0;
+    reported = __ec_multisearch_run(search, &stream->state, stream->offset,
+                                    (const uint8_t *)data, &len, callback,
+                                    context);
+    stream->offset += len;
+    return reported;
+}
+
+size_t ec_multisearch_scan(const ec_multisearch *search, const char *data,
+                           size_t len, ec_multisearch_callback_t callback,
+                           void *context)
+{
+    uint32_t state = 0;
+    if(search->transitions == EC_NULL)
+        return 0;
+    return __ec_multisearch_run(search, &state, 0, (const uint8_t *)data, &len,
+                                callback, context);
+}
+
+typedef struct
+{
+    size_t pattern_id;
+    size_t offset;
+} __ec_multisearch_first_match;
+
+static bool
+__ec_multisearch_first_callback(size_t pattern_id, uint64_t offset,
+                                void *context)
+{
+    __ec_multisearch_first_match *match =
+                                    (__ec_multisearch_first_match *)context;
+    match->pattern_id = pattern_id;
+    match->offset = (size_t)offset;
+    return false;
+}
+
+bool ec_multisearch_find(const ec_multisearch *search, const char *data,
+                         size_t len, size_t *pattern_id, size_t *offset)
+{
+    __ec_multisearch_first_match match;
+    if(ec_multisearch_scan(search, data, len,
+                           __ec_multisearch_first_callback, &match) == 0)
+        return false;
+    if(pattern_id != EC_NULL)
+        *pattern_id = match.pattern_id;
+    if(offset != EC_NULL)
+        *offset = match.offset;
+    return true;
+}
+
+#undef __EC_MULTISEARCH_NONE
+
+#ifdef __cplusplus
+}
+#endif
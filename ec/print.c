@@ -0,0 +1,104 @@
+/* <print.c> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ec/print.h>
+#include <ec/internal/text_parse/ftoa.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+void ec_strbuf_print_double(ec_strbuf *buf, double value)
+{
+    char storage[EC_FTOA_SHORTEST_SIZE];
+    char *end = storage + sizeof(storage);
+    char *start = ec_double_to_shortest(value, end, false);
+    ec_strbuf_append_n(buf, start, (size_t)(end - start));
+}
+
+void ec_strbuf_print_float(ec_strbuf *buf, float value)
+{
+    char storage[EC_FTOA_SHORTEST_SIZE];
+    char *end = storage + sizeof(storage);
+    char *start = ec_float_to_shortest(value, end, false);
+    ec_strbuf_append_n(buf, start, (size_t)(end - start));
+}
+
+void ec_strbuf_print_ipv4(ec_strbuf *buf, ec_ipv4_t value)
+{
+    char storage[16];
+    char *end = storage + sizeof(storage);
+    char *start = end;
+    start = ec_itoa_uint8_t((uint8_t)value.display_string.byte4, start, 10, 0);
+    *--start = '.';
+    start = ec_itoa_uint8_t((uint8_t)value.display_string.byte3, start, 10, 0);
+    *--start = '.';
+    start = ec_itoa_uint8_t((uint8_t)value.display_string.byte2, start, 10, 0);
+    *--start = '.';
+    start = ec_itoa_uint8_t((uint8_t)value.display_string.byte1, start, 10, 0);
+    ec_strbuf_append_n(buf, start, (size_t)(end - start));
+}
+
+void ec_strbuf_print_ipv6(ec_strbuf *buf, ec_ipv6_t value)
+{
+    char storage[40];
+    char *end = storage + sizeof(storage);
+    char *start = end;
+    #define __EC_PRINT_GROUP(INDEX)                                            \
+    start = ec_itoa_uint16_t((uint16_t)value.display_string.byte##INDEX,       \
+                                                            start, 16, 0);
+    __EC_PRINT_GROUP(8); *--start = ':';
+    __EC_PRINT_GROUP(7); *--start = ':';
+    __EC_PRINT_GROUP(6); *--start = ':';
+    __EC_PRINT_GROUP(5); *--start = ':';
+    __EC_PRINT_GROUP(4); *--start = ':';
+    __EC_PRINT_GROUP(3); *--start = ':';
+    __EC_PRINT_GROUP(2); *--start = ':';
+    __EC_PRINT_GROUP(1);
+    #undef __EC_PRINT_GROUP
+    ec_strbuf_append_n(buf, start, (size_t)(end - start));
+}
+
+void ec_strbuf_print_mac(ec_strbuf *buf, ec_mac_t value)
+{
+    extern const char __ec_lower_digits[];
+    char storage[17];
+    char *ptr = storage;
+    #define __EC_PRINT_BYTE(INDEX)                                             \
+    *ptr++ = __ec_lower_digits[(value.display_string.byte##INDEX >> 4) & 0xF]; \
+    *ptr++ = __ec_lower_digits[value.display_string.byte##INDEX & 0xF];
+    __EC_PRINT_BYTE(1); *ptr++ = ':';
+    __EC_PRINT_BYTE(2); *ptr++ = ':';
+    __EC_PRINT_BYTE(3); *ptr++ = ':';
+    __EC_PRINT_BYTE(4); *ptr++ = ':';
+    __EC_PRINT_BYTE(5); *ptr++ = ':';
+    __EC_PRINT_BYTE(6);
+    #undef __EC_PRINT_BYTE
+    ec_strbuf_append_n(buf, storage, sizeof(storage));
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,658 @@
+/* <radix.c> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <stdlib.h>
+#include <ec/radix.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef enum
+{
+    __ec_radix_node_4   = 0,
+    __ec_radix_node_16  = 1,
+    __ec_radix_node_48  = 2,
+    __ec_radix_node_256 = 3
+} __ec_radix_node_type;
+
+/* Common header of all the node types. The prefix holds the compressed path
+ * leading to the node, excluding the byte stored as the key of the node in its
+ * parent. */
+struct __ec_radix_node
+{
+    uint8_t   type;
+    bool      has_value;
+    uint16_t  count;
+    size_t    prefix_len;
+    uint8_t  *prefix;
+    void     *value;
+};
+
+typedef struct
+{
+    __ec_radix_node  header;
+    uint8_t          keys[4];
+    __ec_radix_node *children[4];
+} __ec_radix_node4;
+
+typedef struct
+{
+    __ec_radix_node  header;
+    uint8_t          keys[16];
+    __ec_radix_node *children[16];
+} __ec_radix_node16;
+
+typedef struct
+{
+    __ec_radix_node  header;
+    /* 0 means no child, otherwise the index of the child plus one. */
+    uint8_t          index[256];
+    __ec_radix_node *children[48];
+} __ec_radix_node48;
+
+typedef struct
+{
+    __ec_radix_node  header;
+    __ec_radix_node *children[256];
+} __ec_radix_node256;
+
+static __ec_radix_node *__ec_radix_new_node(const uint8_t *prefix,
+                                            size_t prefix_len)
+{
+    __ec_radix_node *node =
+            (__ec_radix_node *)calloc(1, sizeof(__ec_radix_node4));
+    if(node == EC_NULL)
+        return EC_NULL;
+    node->type = __ec_radix_node_4;
+    if(prefix_len > 0)
+    {
+        node->prefix = (uint8_t *)malloc(prefix_len);
+        if(node->prefix == EC_NULL)
+        {
+            free(node);
+            return EC_NULL;
+        }
+        memcpy(node->prefix, prefix, prefix_len);
+        node->prefix_len = prefix_len;
+    }
+    return node;
+}
+
+static void __ec_radix_free_node(__ec_radix_node *node)
+{
+    unsigned index;
+    switch((__ec_radix_node_type)node->type)
+    {
+        case __ec_radix_node_4:
+            for(index = 0; index < node->count; index++)
+                __ec_radix_free_node(((__ec_radix_node4 *)node)->children[index]);
+            break;
+        case __ec_radix_node_16:
+            for(index = 0; index < node->count; index++)
+                __ec_radix_free_node(((__ec_radix_node16 *)node)->children[index]);
+            break;
+        case __ec_radix_node_48:
+            for(index = 0; index < node->count; index++)
+                __ec_radix_free_node(((__ec_radix_node48 *)node)->children[index]);
+            break;
+        case __ec_radix_node_256:
+            for(index = 0; index < 256; index++)
+            {
+                if(((__ec_radix_node256 *)node)->children[index] != EC_NULL)
+                    __ec_radix_free_node(
+                                ((__ec_radix_node256 *)node)->children[index]);
+            }
+            break;
+    }
+    free(node->prefix);
+    free(node);
+}
+
+static inline __ec_radix_node **
+__attribute__ ((hot,always_inline))
+__ec_radix_find_child(__ec_radix_node *node, uint8_t key)
+{
+    unsigned index;
+    switch((__ec_radix_node_type)node->type)
+    {
+        case __ec_radix_node_4:
+        {
+            __ec_radix_node4 *node4 = (__ec_radix_node4 *)node;
+            for(index = 0; index < node->count; index++)
+            {
+                if(node4->keys[index] == key)
+                    return &node4->children[index];
+            }
+            return EC_NULL;
+        }
+        case __ec_radix_node_16:
+        {
+            __ec_radix_node16 *node16 = (__ec_radix_node16 *)node;
+#if defined(__SSE2__)
+            unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(
+                    _mm_set1_epi8((char)key),
+                    _mm_loadu_si128((const __m128i *)(const void *)node16->keys)));
+            mask &= (1U << node->count) - 1U;
+            if(mask == 0)
+                return EC_NULL;
+            return &node16->children[__builtin_ctz(mask)];
+#else
+            for(index = 0; index < node->count; index++)
+            {
+                if(node16->keys[index] == key)
+                    return &node16->children[index];
+            }
+            return EC_NULL;
+#endif
+        }
+        case __ec_radix_node_48:
+        {
+            __ec_radix_node48 *node48 = (__ec_radix_node48 *)node;
+            if(node48->index[key] == 0)
+                return EC_NULL;
+            return &node48->children[node48->index[key] - 1];
+        }
+        case __ec_radix_node_256:
+        {
+            __ec_radix_node256 *node256 = (__ec_radix_node256 *)node;
+            if(node256->children[key] == EC_NULL)
+                return EC_NULL;
+            return &node256->children[key];
+        }
+    }
+    return EC_NULL;
+}
+
+/* Inserts the key into a sorted node4/node16 key array. */
+static inline void
+__attribute__ ((always_inline))
+__ec_radix_insert_sorted(uint8_t *keys, __ec_radix_node **children,
+                         unsigned count, uint8_t key, __ec_radix_node *child)
+{
+    unsigned index = 0;
+    while(index < count && keys[index] < key)
+        index++;
+    memmove(keys + index + 1, keys + index, count - index);
+    memmove(children + index + 1, children + index,
+            (count - index) * sizeof(__ec_radix_node *));
+    keys[index] = key;
+    children[index] = child;
+}
+
+/* Adds a child to the node pointed by ref, growing the node to the next size
+ * class if it is full. */
+static bool __ec_radix_add_child(__ec_radix_node **ref, uint8_t key,
+                                 __ec_radix_node *child)
+{
+    __ec_radix_node *node = *ref;
+    unsigned index;
+    switch((__ec_radix_node_type)node->type)
+    {
+        case __ec_radix_node_4:
+        {
+            __ec_radix_node4 *node4 = (__ec_radix_node4 *)node;
+            __ec_radix_node16 *node16;
+            if(node->count < 4)
+            {
+                __ec_radix_insert_sorted(node4->keys, node4->children,
+                                         node->count, key, child);
+                break;
+            }
+            node16 = (__ec_radix_node16 *)malloc(sizeof(__ec_radix_node16));
+            if(node16 == EC_NULL)
+                return false;
+            node16->header = node4->header;
+            node16->header.type = __ec_radix_node_16;
+            memcpy(node16->keys, node4->keys, 4);
+            memcpy(node16->children, node4->children,
+                   4 * sizeof(__ec_radix_node *));
+            __ec_radix_insert_sorted(node16->keys, node16->children, 4, key,
+                                     child);
+            free(node4);
+            *ref = node = &node16->header;
+            break;
+        }
+        case __ec_radix_node_16:
+        {
+            __ec_radix_node16 *node16 = (__ec_radix_node16 *)node;
+            __ec_radix_node48 *node48;
+            if(node->count < 16)
+            {
+                __ec_radix_insert_sorted(node16->keys, node16->children,
+                                         node->count, key, child);
+                break;
+            }
+            node48 = (__ec_radix_node48 *)calloc(1, sizeof(__ec_radix_node48));
+            if(node48 == EC_NULL)
+                return false;
+            node48->header = node16->header;
+            node48->header.type = __ec_radix_node_48;
+            for(index = 0; index < 16; index++)
+            {
+                node48->index[node16->keys[index]] = (uint8_t)(index + 1);
+                node48->children[index] = node16->children[index];
+            }
+            node48->index[key] = 17;
+            node48->children[16] = child;
+            free(node16);
+            *ref = node = &node48->header;
+            break;
+        }
+        case __ec_radix_node_48:
+        {
+            __ec_radix_node48 *node48 = (__ec_radix_node48 *)node;
+            __ec_radix_node256 *node256;
+            if(node->count < 48)
+            {
+                /* Nodes never lose children, so the slots are dense. */
+                node48->children[node->count] = child;
+                node48->index[key] = (uint8_t)(node->count + 1);
+                break;
+            }
+            node256 = (__ec_radix_node256 *)calloc(1,
+                                                   sizeof(__ec_radix_node256));
+            if(node256 == EC_NULL)
+                return false;
+            node256->header = node48->header;
+            node256->header.type = __ec_radix_node_256;
+            for(index = 0; index < 256; index++)
+            {
+                if(node48->index[index] != 0)
+                    node256->children[index] =
+                            node48->children[node48->index[index] - 1];
+            }
+            node256->children[key] = child;
+            free(node48);
+            *ref = node = &node256->header;
+            break;
+        }
+        case __ec_radix_node_256:
+            ((__ec_radix_node256 *)node)->children[key] = child;
+            break;
+    }
+    node->count++;
+    return true;
+}
+
+static inline size_t
+__attribute__ ((always_inline))
+__ec_radix_common_prefix(const uint8_t *first, size_t first_len,
+                         const uint8_t *second, size_t second_len)
+{
+    size_t limit = (first_len < second_len) ? first_len : second_len;
+    size_t index = 0;
+    while(index < limit && first[index] == second[index])
+        index++;
+    return index;
+}
+
+static inline bool
+__attribute__ ((hot,always_inline))
+__ec_radix_path_matches(const __ec_radix_node *node, const uint8_t *input,
+                        size_t input_len)
+{
+    return (node->prefix_len <= input_len) &&
+           ((node->prefix_len == 0) ||
+            (memcmp(node->prefix, input, node->prefix_len) == 0));
+}
+
+void ec_radix_init(ec_radix_tree *tree)
+{
+    tree->root        = EC_NULL;
+    tree->size        = 0;
+    tree->max_key_len = 0;
+}
+
+void ec_radix_delete(ec_radix_tree *tree)
+{
+    if(tree->root != EC_NULL)
+        __ec_radix_free_node(tree->root);
+    ec_radix_init(tree);
+}
+
+bool ec_radix_insert(ec_radix_tree *tree, const char *key, size_t key_len,
+                     void *value)
+{
+    const uint8_t *ukey = (const uint8_t *)key;
+    __ec_radix_node **ref = &tree->root;
+    __ec_radix_node *node;
+    __ec_radix_node **child;
+    __ec_radix_node *leaf;
+    size_t depth = 0;
+    size_t common;
+
+    for(;;)
+    {
+        node = *ref;
+        if(node == EC_NULL)
+        {
+            leaf = __ec_radix_new_node(ukey + depth, key_len - depth);
+            if(leaf == EC_NULL)
+                return false;
+            leaf->has_value = true;
+            leaf->value = value;
+            *ref = leaf;
+            break;
+        }
+
+        common = __ec_radix_common_prefix(node->prefix, node->prefix_len,
+                                          ukey + depth, key_len - depth);
+        if(common < node->prefix_len)
+        {
+            /* The key leaves the compressed path in the middle, so the path
+             * is split by a new node holding the common part. */
+            __ec_radix_node *split = __ec_radix_new_node(ukey + depth, common);
+            uint8_t edge = node->prefix[common];
+            if(split == EC_NULL)
+                return false;
+            leaf = EC_NULL;
+            if(depth + common < key_len)
+            {
+                leaf = __ec_radix_new_node(ukey + depth + common + 1,
+                                           key_len - depth - common - 1);
+                if(leaf == EC_NULL)
+                {
+                    free(split->prefix);
+                    free(split);
+                    return false;
+                }
+                leaf->has_value = true;
+                leaf->value = value;
+            }
+            else
+            {
+                split->has_value = true;
+                split->value = value;
+            }
+            node->prefix_len -= common + 1;
+            memmove(node->prefix, node->prefix + common + 1, node->prefix_len);
+            /* A fresh node4 has room for both children. */
+            __ec_radix_add_child(&split, edge, node);
+            if(leaf != EC_NULL)
+                __ec_radix_add_child(&split, ukey[depth + common], leaf);
+            *ref = split;
+            break;
+        }
+
+        depth += node->prefix_len;
+        if(depth == key_len)
+        {
+            node->value = value;
+            if(node->has_value)
+                return true;
+            node->has_value = true;
+            break;
+        }
+
+        child = __ec_radix_find_child(node, ukey[depth]);
+        if(child != EC_NULL)
+        {
+            ref = child;
+            depth++;
+            continue;
+        }
+
+        leaf = __ec_radix_new_node(ukey + depth + 1, key_len - depth - 1);
+        if(leaf == EC_NULL)
+            return false;
+        leaf->has_value = true;
+        leaf->value = value;
+        if(!__ec_radix_add_child(ref, ukey[depth], leaf))
+        {
+            __ec_radix_free_node(leaf);
+            return false;
+        }
+        break;
+    }
+
+    tree->size++;
+    if(key_len > tree->max_key_len)
+        tree->max_key_len = key_len;
+    return true;
+}
+
+bool ec_radix_find(const ec_radix_tree *tree, const char *key, size_t key_len,
+                   void **value)
+{
+    const uint8_t *ukey = (const uint8_t *)key;
+    __ec_radix_node *node = tree->root;
+    __ec_radix_node **child;
+    size_t depth = 0;
+    while(node != EC_NULL)
+    {
+        if(!__ec_radix_path_matches(node, ukey + depth, key_len - depth))
+            return false;
+        depth += node->prefix_len;
+        if(depth == key_len)
+        {
+            if(node->has_value && value != EC_NULL)
+                *value = node->value;
+            return node->has_value;
+        }
+        child = __ec_radix_find_child(node, ukey[depth]);
+        if(child == EC_NULL)
+            return false;
+        node = *child;
+        depth++;
+    }
+    return false;
+}
+
+bool ec_radix_longest_prefix(const ec_radix_tree *tree, const char *input,
+                             size_t input_len, size_t *match_len,
+                             void **value)
+{
+    const uint8_t *uinput = (const uint8_t *)input;
+    __ec_radix_node *node = tree->root;
+    __ec_radix_node *best = EC_NULL;
+    __ec_radix_node **child;
+    size_t best_len = 0;
+    size_t depth = 0;
+    while(node != EC_NULL)
+    {
+        if(!__ec_radix_path_matches(node, uinput + depth, input_len - depth))
+            break;
+        depth += node->prefix_len;
+        if(node->has_value)
+        {
+            best = node;
+            best_len = depth;
+        }
+        if(depth == input_len)
+            break;
+        child = __ec_radix_find_child(node, uinput[depth]);
+        if(child == EC_NULL)
+            break;
+        node = *child;
+        depth++;
+    }
+    if(best == EC_NULL)
+        return false;
+    if(match_len != EC_NULL)
+        *match_len = best_len;
+    if(value != EC_NULL)
+        *value = best->value;
+    return true;
+}
+
+size_t ec_radix_all_prefixes(const ec_radix_tree *tree, const char *input,
+                             size_t input_len, ec_radix_callback_t callback,
+                             void *context)
+{
+    const uint8_t *uinput = (const uint8_t *)input;
+    __ec_radix_node *node = tree->root;
+    __ec_radix_node **child;
+    size_t matches = 0;
+    size_t depth = 0;
+    while(node != EC_NULL)
+    {
+        if(!__ec_radix_path_matches(node, uinput + depth, input_len - depth))
+            break;
+        depth += node->prefix_len;
+        if(node->has_value)
+        {
+            matches++;
+            if(!callback(input, depth, node->value, context))
+                break;
+        }
+        if(depth == input_len)
+            break;
+        child = __ec_radix_find_child(node, uinput[depth]);
+        if(child == EC_NULL)
+            break;
+        node = *child;
+        depth++;
+    }
+    return matches;
+}
+
+/* Depth first walk in key order. The buffer holds the key bytes leading to
+ * the node and is large enough for the longest key. */
+static bool __ec_radix_walk(const __ec_radix_node *node, uint8_t *buffer,
+                            size_t depth, ec_radix_callback_t callback,
+                            void *context)
+{
+    unsigned index;
+    if(node->prefix_len > 0)
+        memcpy(buffer + depth, node->prefix, node->prefix_len);
+    depth += node->prefix_len;
+    if(node->has_value &&
+       !callback((const char *)buffer, depth, node->value, context))
+        return false;
+    switch((__ec_radix_node_type)node->type)
+    {
+        case __ec_radix_node_4:
+        {
+            const __ec_radix_node4 *node4 = (const __ec_radix_node4 *)node;
+            for(index = 0; index < node->count; index++)
+            {
+                buffer[depth] = node4->keys[index];
+                if(!__ec_radix_walk(node4->children[index], buffer, depth + 1,
+                                    callback, context))
+                    return false;
+            }
+            break;
+        }
+        case __ec_radix_node_16:
+        {
+            const __ec_radix_node16 *node16 = (const __ec_radix_node16 *)node;
+            for(index = 0; index < node->count; index++)
+            {
+                buffer[depth] = node16->keys[index];
+                if(!__ec_radix_walk(node16->children[index], buffer, depth + 1,
+                                    callback, context))
+                    return false;
+            }
+            break;
+        }
+        case __ec_radix_node_48:
+        {
+            const __ec_radix_node48 *node48 = (const __ec_radix_node48 *)node;
+            for(index = 0; index < 256; index++)
+            {
+                if(node48->index[index] == 0)
+                    continue;
+                buffer[depth] = (uint8_t)index;
+                if(!__ec_radix_walk(node48->children[node48->index[index] - 1],
+                                    buffer, depth + 1, callback, context))
+                    return false;
+            }
+            break;
+        }
+        case __ec_radix_node_256:
+        {
+            const __ec_radix_node256 *node256 =
+                    (const __ec_radix_node256 *)node;
+            for(index = 0; index < 256; index++)
+            {
+                if(node256->children[index] == EC_NULL)
+                    continue;
+                buffer[depth] = (uint8_t)index;
+                if(!__ec_radix_walk(node256->children[index], buffer,
+                                    depth + 1, callback, context))
+                    return false;
+            }
+            break;
+        }
+    }
+    return true;
+}
+
+bool ec_radix_for_each(const ec_radix_tree *tree, ec_radix_callback_t callback,
+                       void *context)
+{
+    return ec_radix_prefix_scan(tree, EC_NULL, 0, callback, context);
+}
+
+bool ec_radix_prefix_scan(const ec_radix_tree *tree, const char *prefix,
+                          size_t prefix_len, ec_radix_callback_t callback,
+                          void *context)
+{
+    const uint8_t *uprefix = (const uint8_t *)prefix;
+    __ec_radix_node *node = tree->root;
+    __ec_radix_node **child;
+    uint8_t *buffer;
+    size_t depth = 0;
+    size_t remaining;
+    bool result;
+    while(node != EC_NULL)
+    {
+        remaining = prefix_len - depth;
+        if(node->prefix_len >= remaining)
+        {
+            /* The prefix ends inside the path of this node, so the whole
+             * subtree matches it. */
+            if(remaining > 0 &&
+               memcmp(node->prefix, uprefix + depth, remaining) != 0)
+                return true;
+            buffer = (uint8_t *)malloc(tree->max_key_len + 1);
+            if(buffer == EC_NULL)
+                return false;
+            if(depth > 0)
+                memcpy(buffer, uprefix, depth);
+            result = __ec_radix_walk(node, buffer, depth, callback, context);
+            free(buffer);
+            return result;
+        }
+        if(!__ec_radix_path_matches(node, uprefix + depth, remaining))
+            return true;
+        depth += node->prefix_len;
+        child = __ec_radix_find_child(node, uprefix[depth]);
+        if(child == EC_NULL)
+            return true;
+        node = *child;
+        depth++;
+    }
+    return true;
+}
+
+#ifdef __cplusplus
+}
+#endif
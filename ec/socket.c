@@ -34,7 +34,9 @@ int64_t ipLookup(const char *hostname)
     char *ptr = response;
     char *ptr2;
     int64_t addr;
-    ec_sprintf(command, "ping -c 1 -t 1 %s", hostname);
+    if(ec_snprintf(command, sizeof(command), "ping -c 1 -t 1 %s", hostname)
+                                                    >= (int)sizeof(command))
+        return -1;
     ec_popen(command, response, sizeof(response));
     while(*ptr != '(' && *ptr != '\0')
         ptr++;
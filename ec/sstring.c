@@ -0,0 +1,222 @@
+/* <sstring.c> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <stdlib.h>
+#include <ec/sstring.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* The heap capacity is tagged so that the byte overlapping the last inline
+ * byte has its 0x80 bit set. That is the most significant byte on little
+ * endian platforms and the least significant one on big endian ones. */
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__)
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define __EC_SSTRING_BIG_ENDIAN
+#endif
+#endif
+
+#if defined(__EC_SSTRING_BIG_ENDIAN)
+#define __ec_sstring_pack_cap(_cap)     (((size_t)(_cap) << 8) | 0x80U)
+#define __ec_sstring_unpack_cap(_field) ((size_t)(_field) >> 8)
+#define __EC_SSTRING_MAX_CAP            (SIZE_MAX >> 9)
+#else
+#define __EC_SSTRING_HEAP_BIT           ((size_t)1 << (sizeof(size_t) * 8 - 1))
+#define __ec_sstring_pack_cap(_cap)     ((size_t)(_cap) | __EC_SSTRING_HEAP_BIT)
+#define __ec_sstring_unpack_cap(_field) ((size_t)(_field) & ~__EC_SSTRING_HEAP_BIT)
+#define __EC_SSTRING_MAX_CAP            (SIZE_MAX >> 2)
+#endif
+
+static inline size_t
+__attribute__ ((hot,always_inline))
+__ec_sstring_capacity(const ec_sstring *str)
+{
+    return ec_sstring_is_inline(str) ? EC_SSTRING_INLINE_CAPACITY :
+                                       __ec_sstring_unpack_cap(str->heap.cap);
+}
+
+static inline void
+__attribute__ ((hot,always_inline))
+__ec_sstring_set_len(ec_sstring *str, size_t len)
+{
+    if(ec_sstring_is_inline(str))
+    {
+        str->small[len] = '\0';
+        str->small[EC_SSTRING_INLINE_CAPACITY] =
+                                    (char)(EC_SSTRING_INLINE_CAPACITY - len);
+    }
+    else
+    {
+        str->heap.ptr[len] = '\0';
+        str->heap.len = len;
+    }
+}
+
+static inline char *
+__attribute__ ((hot,always_inline))
+__ec_sstring_data(ec_sstring *str)
+{
+    return ec_sstring_is_inline(str) ? str->small : str->heap.ptr;
+}
+
+void ec_sstring_delete(ec_sstring *str)
+{
+    if(!ec_sstring_is_inline(str))
+        free(str->heap.ptr);
+    ec_sstring_init(str);
+}
+
+bool ec_sstring_reserve(ec_sstring *str, size_t capacity)
+{
+    size_t current = __ec_sstring_capacity(str);
+    size_t len;
+    char *data;
+
+    if(capacity <= current)
+        return true;
+    if(capacity > __EC_SSTRING_MAX_CAP)
+        return false;
+    /* Grow geometrically, so appending is amortized O(1) per byte. */
+    if(capacity < current * 2)
+        capacity = current * 2;
+
+    len = ec_sstring_len(str);
+    if(ec_sstring_is_inline(str))
+    {
+        data = (char *)malloc(capacity + 1);
+        if(data == EC_NULL)
+            return false;
+        memcpy(data, str->small, len + 1);
+    }
+    else
+    {
+        data = (char *)realloc(str->heap.ptr, capacity + 1);
+        if(data == EC_NULL)
+            return false;
+    }
+    str->heap.ptr = data;
+    str->heap.len = len;
+    str->heap.cap = __ec_sstring_pack_cap(capacity);
+    return true;
+}
+
+bool ec_sstring_assign(ec_sstring *str, const char *ptr, size_t len)
+{
+    if(!ec_sstring_reserve(str, len))
+        return false;
+    if(len > 0)
+        memcpy(__ec_sstring_data(str), ptr, len);
+    __ec_sstring_set_len(str, len);
+    return true;
+}
+
+__attribute__((hot))
+bool ec_sstring_append(ec_sstring *str, const char *ptr, size_t len)
+{
+    size_t current = ec_sstring_len(str);
+    if(len > __EC_SSTRING_MAX_CAP - current ||
+       !ec_sstring_reserve(str, current + len))
+        return false;
+    if(len > 0)
+        memcpy(__ec_sstring_data(str) + current, ptr, len);
+    __ec_sstring_set_len(str, current + len);
+    return true;
+}
+
+bool ec_sstring_append_fmt(ec_sstring *str, const char *format, ...)
+{
+    char storage[128];
+    ec_strbuf buf;
+    va_list argptr;
+    bool result;
+
+    ec_strbuf_init_inline(&buf, storage, sizeof(storage));
+    va_start(argptr, format);
+    result = ec_strbuf_append_vfmt(&buf, format, argptr);
+    va_end(argptr);
+    if(result)
+        result = ec_sstring_append(str, buf.data, buf.len);
+    ec_strbuf_delete(&buf);
+    return result;
+}
+
+void ec_sstring_move(ec_sstring *dst, ec_sstring *src)
+{
+    if(dst == src)
+        return;
+    ec_sstring_delete(dst);
+    *dst = *src;
+    ec_sstring_init(src);
+}
+
+char *ec_sstring_steal(ec_sstring *str, size_t *len)
+{
+    size_t length = ec_sstring_len(str);
+    char *result;
+    if(ec_sstring_is_inline(str))
+    {
+        result = (char *)malloc(length + 1);
+        if(result == EC_NULL)
+            return EC_NULL;
+        memcpy(result, str->small, length + 1);
+    }
+    else
+        result = str->heap.ptr;
+    if(len != EC_NULL)
+        *len = length;
+    ec_sstring_init(str);
+    return result;
+}
+
+bool ec_sstring_from_strbuf(ec_sstring *str, ec_strbuf *buf)
+{
+    if(buf->len > EC_SSTRING_INLINE_CAPACITY && (buf->flags & EC_STRBUF_HEAP))
+    {
+        ec_sstring_delete(str);
+        str->heap.ptr = buf->data;
+        str->heap.len = buf->len;
+        str->heap.cap = __ec_sstring_pack_cap(buf->cap - 1);
+        ec_strbuf_init(buf);
+        return true;
+    }
+    if(!ec_sstring_assign(str, buf->data, buf->len))
+        return false;
+    ec_strbuf_delete(buf);
+    return true;
+}
+
+#undef __ec_sstring_pack_cap
+#undef __ec_sstring_unpack_cap
+#undef __EC_SSTRING_MAX_CAP
+#if defined(__EC_SSTRING_BIG_ENDIAN)
+#undef __EC_SSTRING_BIG_ENDIAN
+#else
+#undef __EC_SSTRING_HEAP_BIT
+#endif
+
+#ifdef __cplusplus
+}
+#endif
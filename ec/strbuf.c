@@ -0,0 +1,378 @@
+/* <strbuf.c> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <stdlib.h>
+#include <ec/strbuf.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* The first heap allocation is never smaller than this. */
+#define EC_STRBUF_MIN_HEAP          64
+
+void ec_strbuf_init(ec_strbuf *buf)
+{
+    buf->data  = EC_NULL;
+    buf->len   = 0;
+    buf->cap   = 0;
+    buf->flags = 0;
+    buf->sink  = EC_NULL;
+    buf->context = EC_NULL;
+    buf->dropped = 0;
+}
+
+void ec_strbuf_init_inline(ec_strbuf *buf, char *storage, size_t size)
+{
+    buf->data  = storage;
+    buf->len   = 0;
+    buf->cap   = size;
+    buf->flags = 0;
+    buf->sink  = EC_NULL;
+    buf->context = EC_NULL;
+    buf->dropped = 0;
+    storage[0] = '\0';
+}
+
+void ec_strbuf_init_fixed(ec_strbuf *buf, char *storage, size_t size)
+{
+    ec_strbuf_init_inline(buf, storage, size);
+    buf->flags = EC_STRBUF_FIXED;
+}
+
+void ec_strbuf_init_sink(ec_strbuf *buf, char *storage, size_t size,
+                                        ec_strbuf_sink_t sink, void *context)
+{
+    ec_strbuf_init_inline(buf, storage, size);
+    buf->flags   = EC_STRBUF_FIXED | EC_STRBUF_SINK;
+    buf->sink    = sink;
+    buf->context = context;
+}
+
+bool ec_strbuf_flush(ec_strbuf *buf)
+{
+    if(!(buf->flags & EC_STRBUF_SINK))
+        return true;
+    if(buf->len > 0)
+    {
+        if(!buf->sink(buf->context, buf->data, buf->len))
+            buf->flags |= EC_STRBUF_FAILED;
+        buf->len = 0;
+        buf->data[0] = '\0';
+    }
+    return !(buf->flags & EC_STRBUF_FAILED);
+}
+
+void ec_strbuf_delete(ec_strbuf *buf)
+{
+    if(buf->flags & EC_STRBUF_HEAP)
+        free(buf->data);
+    ec_strbuf_init(buf);
+}
+
+/* Grows the storage so "extra" more bytes and the terminator fit in. */
+static bool __ec_strbuf_grow(ec_strbuf *buf, size_t extra)
+{
+    size_t needed = buf->len + extra + 1;
+    size_t cap;
+    char *data;
+    if(needed < buf->len)
+        return false;
+    cap = (buf->cap < EC_STRBUF_MIN_HEAP / 2) ? EC_STRBUF_MIN_HEAP :
+                                                buf->cap * 2;
+    if(cap < needed)
+        cap = needed;
+    if(buf->flags & EC_STRBUF_HEAP)
+    {
+        data = (char *)realloc(buf->data, cap);
+        if(data == EC_NULL)
+            return false;
+    }
+    else
+    {
+        data = (char *)malloc(cap);
+        if(data == EC_NULL)
+            return false;
+        if(buf->len > 0)
+            memcpy(data, buf->data, buf->len);
+        data[buf->len] = '\0';
+        buf->flags |= EC_STRBUF_HEAP;
+    }
+    buf->data = data;
+    buf->cap  = cap;
+    return true;
+}
+
+bool ec_strbuf_reserve(ec_strbuf *buf, size_t extra)
+{
+    if(extra < buf->cap - buf->len)
+        return true;
+    if(buf->flags & EC_STRBUF_FIXED)
+        return false;
+    return __ec_strbuf_grow(buf, extra);
+}
+
+/* Makes room for "len" bytes. Returns how many of them can be written. */
+static size_t __ec_strbuf_make_room(ec_strbuf *buf, size_t len)
+{
+    size_t room;
+    if(len < buf->cap - buf->len)
+        return len;
+    if(!(buf->flags & EC_STRBUF_FIXED))
+    {
+        if(__ec_strbuf_grow(buf, len))
+            return len;
+    }
+    buf->flags |= EC_STRBUF_FAILED;
+    room = (buf->cap > buf->len) ? (buf->cap - buf->len - 1) : 0;
+    buf->dropped += len - room;
+    return room;
+}
+
+bool __ec_strbuf_append_slow(ec_strbuf *buf, const char *ptr, size_t len)
+{
+    size_t room;
+    if(buf->flags & EC_STRBUF_SINK)
+    {
+        ec_strbuf_flush(buf);
+        /* Too big for the storage anyway, skip the copy. */
+        if(len >= buf->cap)
+        {
+            if(!buf->sink(buf->context, ptr, len))
+                buf->flags |= EC_STRBUF_FAILED;
+            return !(buf->flags & EC_STRBUF_FAILED);
+        }
+    }
+    room = __ec_strbuf_make_room(buf, len);
+    if(room > 0)
+    {
+        memcpy(buf->data + buf->len, ptr, room);
+        buf->len += room;
+        buf->data[buf->len] = '\0';
+    }
+    return (room == len);
+}
+
+bool __ec_strbuf_repeat_slow(ec_strbuf *buf, char character, size_t count)
+{
+    size_t room;
+    if(buf->flags & EC_STRBUF_SINK)
+    {
+        while(count >= buf->cap - buf->len)
+        {
+            room = buf->cap - buf->len - 1;
+            memset(buf->data + buf->len, character, room);
+            buf->len += room;
+            count    -= room;
+            ec_strbuf_flush(buf);
+        }
+    }
+    room = __ec_strbuf_make_room(buf, count);
+    if(room > 0)
+    {
+        memset(buf->data + buf->len, character, room);
+        buf->len += room;
+        buf->data[buf->len] = '\0';
+    }
+    return (room == count);
+}
+
+char *ec_strbuf_detach(ec_strbuf *buf, size_t *len)
+{
+    char *result;
+    if(buf->flags & EC_STRBUF_HEAP)
+        result = buf->data;
+    else
+    {
+        result = (char *)malloc(buf->len + 1);
+        if(result == EC_NULL)
+            return EC_NULL;
+        if(buf->len > 0)
+            memcpy(result, buf->data, buf->len);
+        result[buf->len] = '\0';
+    }
+    if(len != EC_NULL)
+        *len = buf->len;
+    ec_strbuf_init(buf);
+    return result;
+}
+
+bool ec_strbuf_append_fmt(ec_strbuf *buf, const char *format, ...)
+{
+    bool result;
+    va_list argptr;
+    va_start(argptr, format);
+    result = ec_strbuf_append_vfmt(buf, format, argptr);
+    va_end(argptr);
+    return result;
+}
+
+/* Number of the bytes encoded at a time on the stack, when the builder can
+ * not hold the whole output. A multiple of 3 for base64 and of 16 for the
+ * hex dumps. */
+#define __EC_STRBUF_ENCODE_CHUNK    192
+
+bool ec_strbuf_append_hex(ec_strbuf *buf, const void *src, size_t len,
+                                                            bool upper_case)
+{
+    char chunk[EC_HEX_ENCODED_SIZE(__EC_STRBUF_ENCODE_CHUNK)];
+    const uint8_t *bytes = (const uint8_t *)src;
+    size_t part;
+    if(len <= ((size_t)-1) / 2 &&
+                            ec_strbuf_reserve(buf, EC_HEX_ENCODED_SIZE(len)))
+    {
+        buf->len += ec_hex_encode(buf->data + buf->len, bytes, len,
+                                                                upper_case);
+        buf->data[buf->len] = '\0';
+        return ((buf->flags & EC_STRBUF_FAILED) == 0);
+    }
+    while(len > 0)
+    {
+        part = (len < __EC_STRBUF_ENCODE_CHUNK) ? len
+                                                : __EC_STRBUF_ENCODE_CHUNK;
+        ec_strbuf_append_n(buf, chunk,
+                                ec_hex_encode(chunk, bytes, part, upper_case));
+        bytes += part;
+        len -= part;
+    }
+    return ((buf->flags & EC_STRBUF_FAILED) == 0);
+}
+
+bool ec_strbuf_append_base64(ec_strbuf *buf, const void *src, size_t len,
+                                                                unsigned mode)
+{
+    char chunk[EC_BASE64_ENCODED_SIZE(__EC_STRBUF_ENCODE_CHUNK)];
+    const uint8_t *bytes = (const uint8_t *)src;
+    size_t part;
+    if(len <= ((size_t)-1) / 2 &&
+                        ec_strbuf_reserve(buf, EC_BASE64_ENCODED_SIZE(len)))
+    {
+        buf->len += ec_base64_encode(buf->data + buf->len, bytes, len, mode);
+        buf->data[buf->len] = '\0';
+        return ((buf->flags & EC_STRBUF_FAILED) == 0);
+    }
+    while(len > 0)
+    {
+        part = (len < __EC_STRBUF_ENCODE_CHUNK) ? len
+                                                : __EC_STRBUF_ENCODE_CHUNK;
+        ec_strbuf_append_n(buf, chunk,
+                                ec_base64_encode(chunk, bytes, part, mode));
+        bytes += part;
+        len -= part;
+    }
+    return ((buf->flags & EC_STRBUF_FAILED) == 0);
+}
+
+/* Writes a line of "hexdump -C" for up to 16 bytes and returns its end. */
+static char *__ec_strbuf_hexdump_line(char *out, const uint8_t *bytes,
+                                                size_t len, size_t offset)
+{
+    static const char digits[] = "0123456789abcdef";
+    char hex[EC_HEX_ENCODED_SIZE(16)];
+    unsigned shift = 28;
+    size_t index;
+    /* at least 8 digits, more for the offsets past 4GB */
+    while(shift < sizeof(size_t) * 8 - 4 && (offset >> (shift + 4)) != 0)
+        shift += 4;
+    for(;; shift -= 4)
+    {
+        *out++ = digits[(offset >> shift) & 0x0F];
+        if(shift == 0)
+            break;
+    }
+    *out++ = ' ';
+    ec_hex_encode(hex, bytes, len, false);
+    for(index = 0; index < 16; index++)
+    {
+        if(index == 0 || index == 8)
+            *out++ = ' ';
+        if(index < len)
+        {
+            out[0] = hex[2 * index];
+            out[1] = hex[2 * index + 1];
+        }
+        else
+        {
+            out[0] = ' ';
+            out[1] = ' ';
+        }
+        out[2] = ' ';
+        out += 3;
+    }
+    *out++ = ' ';
+    *out++ = '|';
+    for(index = 0; index < len; index++)
+        *out++ = (bytes[index] >= 0x20 && bytes[index] < 0x7F)
+                                                ? (char)bytes[index] : '.';
+    *out++ = '|';
+    *out++ = '\n';
+    return out;
+}
+
+bool ec_strbuf_append_hexdump(ec_strbuf *buf, const void *src, size_t len,
+                                                                unsigned mode)
+{
+    /* 16 bytes take 79 characters in a classic line with a 8 digits offset,
+     * up to 87 with a 16 digits one. */
+    char chunk[(__EC_STRBUF_ENCODE_CHUNK / 16) * 88];
+    char hex[EC_HEX_ENCODED_SIZE(__EC_STRBUF_ENCODE_CHUNK)];
+    const uint8_t *bytes = (const uint8_t *)src;
+    size_t offset = 0;
+    size_t part;
+    size_t index;
+    char *out;
+    while(offset < len)
+    {
+        part = (len - offset < __EC_STRBUF_ENCODE_CHUNK)
+                                    ? len - offset : __EC_STRBUF_ENCODE_CHUNK;
+        out = chunk;
+        if(mode & EC_HEXDUMP_CLASSIC)
+        {
+            for(index = 0; index < part; index += 16)
+                out = __ec_strbuf_hexdump_line(out, bytes + offset + index,
+                        (part - index < 16) ? part - index : 16,
+                        offset + index);
+        }
+        else
+        {
+            ec_hex_encode(hex, bytes + offset, part, false);
+            for(index = 0; index < part; index++)
+            {
+                if(index != 0 || offset != 0)
+                    *out++ = ' ';
+                out[0] = hex[2 * index];
+                out[1] = hex[2 * index + 1];
+                out += 2;
+            }
+        }
+        ec_strbuf_append_n(buf, chunk, (size_t)(out - chunk));
+        offset += part;
+    }
+    return ((buf->flags & EC_STRBUF_FAILED) == 0);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -23,15 +23,807 @@
  **/
 
 #include <ec/string.h>
+#include <ec/internal/simd.h>
 
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+static inline bool
+__attribute__ ((hot,always_inline))
+__ec_str_is_space(char ch)
+{
+    return (ch == ' ') || ((unsigned char)(ch - '\t') < 5U);
+}
+
+/* Returns true if the first "len" bytes of both pointers are equal. */
+static inline bool
+__attribute__ ((hot,always_inline))
+__ec_str_equal(const char *first, const char *second, size_t len)
+{
+#if defined(__EC_SIMD_WIDTH)
+    size_t index;
+    if(len >= __EC_SIMD_WIDTH)
+    {
+        for(index = 0; index + __EC_SIMD_WIDTH <= len;
+                                                    index += __EC_SIMD_WIDTH)
+        {
+            if(__ec_simd_mask(__ec_simd_eq(__ec_simd_load(first + index),
+                              __ec_simd_load(second + index))) !=
+               __EC_SIMD_FULL_MASK)
+                return false;
+        }
+        /* The tail is covered by one last block overlapping the previous. */
+        if(index < len)
+        {
+            index = len - __EC_SIMD_WIDTH;
+            return __ec_simd_mask(__ec_simd_eq(__ec_simd_load(first + index),
+                                  __ec_simd_load(second + index))) ==
+                   __EC_SIMD_FULL_MASK;
+        }
+        return true;
+    }
+#endif
+    return (memcmp(first, second, len) == 0);
+}
+
+/* Returns the index of the first differing byte, or "len" if there is none. */
+static inline size_t
+__attribute__ ((hot,always_inline))
+__ec_str_mismatch(const char *first, const char *second, size_t len)
+{
+    size_t index = 0;
+#if defined(__EC_SIMD_WIDTH)
+    uint32_t mask;
+    for(; index + __EC_SIMD_WIDTH <= len; index += __EC_SIMD_WIDTH)
+    {
+        mask = __ec_simd_mask(__ec_simd_eq(__ec_simd_load(first + index),
+                              __ec_simd_load(second + index))) ^
+               __EC_SIMD_FULL_MASK;
+        if(mask != 0)
+            return index + __ec_simd_first(mask);
+    }
+#endif
+    for(; index < len; index++)
+    {
+        if(first[index] != second[index])
+            return index;
+    }
+    return len;
+}
+
+bool ec_strview_equals(ec_strview first, ec_strview second)
+{
+    return (first.len == second.len) &&
+           __ec_str_equal(first.ptr, second.ptr, first.len);
+}
+
+int ec_strview_compare(ec_strview first, ec_strview second)
+{
+    size_t len = (first.len < second.len) ? first.len : second.len;
+    size_t index = __ec_str_mismatch(first.ptr, second.ptr, len);
+    if(index < len)
+        return (int)(unsigned char)first.ptr[index] -
+               (int)(unsigned char)second.ptr[index];
+    return (first.len > second.len) - (first.len < second.len);
+}
+
+bool ec_strview_starts_with(ec_strview view, ec_strview prefix)
+{
+    return (prefix.len <= view.len) &&
+           __ec_str_equal(view.ptr, prefix.ptr, prefix.len);
+}
+
+bool ec_strview_ends_with(ec_strview view, ec_strview suffix)
+{
+    return (suffix.len <= view.len) &&
+           __ec_str_equal(view.ptr + view.len - suffix.len, suffix.ptr,
+                          suffix.len);
+}
+
+size_t ec_strview_find_char(ec_strview view, char ch)
+{
+#if defined(__EC_SIMD_WIDTH)
+    __ec_simd_t needle = __ec_simd_splat(ch);
+    uint32_t mask;
+    size_t index = 0;
+    if(view.len >= __EC_SIMD_WIDTH)
+    {
+        for(; index + __EC_SIMD_WIDTH <= view.len; index += __EC_SIMD_WIDTH)
+        {
+            mask = __ec_simd_mask(__ec_simd_eq(__ec_simd_load(view.ptr + index),
+                                               needle));
+            if(mask != 0)
+                return index + __ec_simd_first(mask);
+        }
+        if(index < view.len)
+        {
+            index = view.len - __EC_SIMD_WIDTH;
+            mask = __ec_simd_mask(__ec_simd_eq(__ec_simd_load(view.ptr + index),
+                                               needle));
+            if(mask != 0)
+                return index + __ec_simd_first(mask);
+        }
+        return EC_STRVIEW_NPOS;
+    }
+    for(; index < view.len; index++)
+    {
+        if(view.ptr[index] == ch)
+            return index;
+    }
+    return EC_STRVIEW_NPOS;
+#else
+    const char *hit = (const char *)memchr(view.ptr, ch, view.len);
+    return (hit == EC_NULL) ? EC_STRVIEW_NPOS : (size_t)(hit - view.ptr);
+#endif
+}
+
+size_t ec_strview_rfind_char(ec_strview view, char ch)
+{
+    size_t index = view.len;
+#if defined(__EC_SIMD_WIDTH)
+    __ec_simd_t needle = __ec_simd_splat(ch);
+    uint32_t mask;
+    while(index >= __EC_SIMD_WIDTH)
+    {
+        index -= __EC_SIMD_WIDTH;
+        mask = __ec_simd_mask(__ec_simd_eq(__ec_simd_load(view.ptr + index),
+                                           needle));
+        if(mask != 0)
+            return index + __ec_simd_last(mask);
+    }
+#endif
+    while(index > 0)
+    {
+        index--;
+        if(view.ptr[index] == ch)
+            return index;
+    }
+    return EC_STRVIEW_NPOS;
+}
+
+size_t ec_strview_find(ec_strview view, ec_strview needle)
+{
+    const char *found = (const char *)ec_memmem(view.ptr, view.len,
+                                                needle.ptr, needle.len);
+    return (found == EC_NULL) ? EC_STRVIEW_NPOS : (size_t)(found - view.ptr);
+}
+
+static size_t __ec_two_way_last(const uint8_t *haystack, size_t haystack_len,
+                                const uint8_t *needle, size_t needle_len);
+
+size_t ec_strview_rfind(ec_strview view, ec_strview needle)
+{
+    size_t limit;
+    size_t found;
+    size_t work = 0;
+    if(needle.len > view.len)
+        return EC_STRVIEW_NPOS;
+    if(needle.len == 0)
+        return view.len;
+    /* Candidates are the positions [0, limit). */
+    limit = view.len - needle.len + 1;
+    while(limit > 0)
+    {
+        found = ec_strview_rfind_char(ec_strview_make(view.ptr, limit),
+                                      needle.ptr[0]);
+        if(found == EC_STRVIEW_NPOS)
+            break;
+        if(__ec_str_equal(view.ptr + found + 1, needle.ptr + 1,
+                          needle.len - 1))
+            return found;
+        limit = found;
+        /* Too many false candidates, e.g. "baaaa..." in "aaaa...". Continue
+         * with the reverse Two-Way to keep the search linear. */
+        work += needle.len;
+        if(limit > 0 && work > 4 * (view.len - limit) + 4096)
+            return __ec_two_way_last((const uint8_t *)view.ptr,
+                                     limit + needle.len - 1,
+                                     (const uint8_t *)needle.ptr, needle.len);
+    }
+    return EC_STRVIEW_NPOS;
+}
+
+ec_strview ec_strview_ltrim(ec_strview view)
+{
+    while(view.len > 0 && __ec_str_is_space(view.ptr[0]))
+    {
+        view.ptr++;
+        view.len--;
+    }
+    return view;
+}
+
+ec_strview ec_strview_rtrim(ec_strview view)
+{
+    while(view.len > 0 && __ec_str_is_space(view.ptr[view.len - 1]))
+        view.len--;
+    return view;
+}
+
+ec_strview ec_strview_trim(ec_strview view)
+{
+    return ec_strview_rtrim(ec_strview_ltrim(view));
+}
+
+bool ec_strview_split(ec_strview *rest, char delimiter, ec_strview *field)
+{
+    size_t index;
+    if(rest->ptr == EC_NULL)
+        return false;
+    index = ec_strview_find_char(*rest, delimiter);
+    if(index == EC_STRVIEW_NPOS)
+    {
+        *field = *rest;
+        rest->ptr = EC_NULL;
+        rest->len = 0;
+        return true;
+    }
+    *field = ec_strview_make(rest->ptr, index);
+    rest->ptr += index + 1;
+    rest->len -= index + 1;
+    return true;
+}
+
+/* The Two-Way functions below run either forwards or, with "reverse" set,
+ * on the mirrored haystack and needle, which finds the last occurrence
+ * instead of the first one. Returns the byte "index" of a string of "len"
+ * bytes, in the order of the search. */
+static inline uint8_t
+__attribute__ ((always_inline))
+__ec_two_way_at(const uint8_t *ptr, size_t len, size_t index,
+                const bool reverse)
+{
+    return reverse ? ptr[len - 1 - index] : ptr[index];
+}
+
+/* Splits the needle into a critical factorization for the Two-Way algorithm.
+ * Returns the index where the right half starts and its period. */
+static inline size_t
+__attribute__ ((always_inline))
+__ec_two_way_factorize(const uint8_t *needle, size_t needle_len,
+                       size_t *period, const bool reverse)
+{
+    size_t suffix;
+    size_t suffix_rev;
+    size_t index;
+    size_t offset;
+    size_t step;
+    uint8_t first;
+    uint8_t second;
+
+    /* Maximal suffix for the "<" ordering. SIZE_MAX stands for "-1". */
+    suffix = (size_t)-1;
+    index = 0;
+    offset = step = 1;
+    while(index + offset < needle_len)
+    {
+        first = __ec_two_way_at(needle, needle_len, index + offset, reverse);
+        second = __ec_two_way_at(needle, needle_len, suffix + offset, reverse);
+        if(first < second)
+        {
+            index += offset;
+            offset = 1;
+            step = index - suffix;
+        }
+        else if(first == second)
+        {
+            if(offset != step)
+                offset++;
+            else
+            {
+                index += step;
+                offset = 1;
+            }
+        }
+        else
+        {
+            suffix = index++;
+            offset = step = 1;
+        }
+    }
+    *period = step;
+
+    /* Maximal suffix for the ">" ordering. */
+    suffix_rev = (size_t)-1;
+    index = 0;
+    offset = step = 1;
+    while(index + offset < needle_len)
+    {
+        first = __ec_two_way_at(needle, needle_len, index + offset, reverse);
+        second = __ec_two_way_at(needle, needle_len, suffix_rev + offset,
+                                 reverse);
+        if(second < first)
+        {
+            index += offset;
+            offset = 1;
+            step = index - suffix_rev;
+        }
+        else if(first == second)
+        {
+            if(offset != step)
+                offset++;
+            else
+            {
+                index += step;
+                offset = 1;
+            }
+        }
+        else
+        {
+            suffix_rev = index++;
+            offset = step = 1;
+        }
+    }
+
+    if(suffix_rev + 1 < suffix + 1)
+        return suffix + 1;
+    *period = step;
+    return suffix_rev + 1;
+}
+
+/* Checks if the left half of the factorization repeats with the period. */
+static inline bool
+__attribute__ ((always_inline))
+__ec_two_way_is_periodic(const uint8_t *needle, size_t needle_len,
+                         size_t suffix, size_t period, const bool reverse)
+{
+    size_t index;
+    if(!reverse)
+        return (memcmp(needle, needle + period, suffix) == 0);
+    for(index = 0; index < suffix; index++)
+    {
+        if(__ec_two_way_at(needle, needle_len, index, reverse) !=
+           __ec_two_way_at(needle, needle_len, index + period, reverse))
+            return false;
+    }
+    return true;
+}
+
+/* Crochemore-Perrin Two-Way string matching: linear time, constant space.
+ * Returns the position of the match in the order of the search, or
+ * EC_STRVIEW_NPOS. */
+static inline size_t
+__attribute__ ((always_inline))
+__ec_two_way_search(const uint8_t *haystack, size_t haystack_len,
+                    const uint8_t *needle, size_t needle_len,
+                    const bool reverse)
+{
+    size_t period;
+    size_t suffix = __ec_two_way_factorize(needle, needle_len, &period,
+                                                                    reverse);
+    size_t position = 0;
+    size_t index;
+    size_t memory;
+
+    if(__ec_two_way_is_periodic(needle, needle_len, suffix, period, reverse))
+    {
+        /* Periodic needle: the part of the needle already matched by the
+         * previous shift is remembered and not compared again. */
+        memory = 0;
+        while(position + needle_len <= haystack_len)
+        {
+            index = (suffix > memory) ? suffix : memory;
+            while(index < needle_len &&
+                  __ec_two_way_at(needle, needle_len, index, reverse) ==
+                  __ec_two_way_at(haystack, haystack_len, position + index,
+                                  reverse))
+                index++;
+            if(index >= needle_len)
+            {
+                index = suffix - 1;
+                while(memory < index + 1 &&
+                      __ec_two_way_at(needle, needle_len, index, reverse) ==
+                      __ec_two_way_at(haystack, haystack_len,
+                                      position + index, reverse))
+                    index--;
+                if(index + 1 < memory + 1)
+                    return position;
+                position += period;
+                memory = needle_len - period;
+            }
+            else
+            {
+                position += index - suffix + 1;
+                memory = 0;
+            }
+        }
+    }
+    else
+    {
+        period = ((suffix > needle_len - suffix) ? suffix :
+                                                   needle_len - suffix) + 1;
+        while(position + needle_len <= haystack_len)
+        {
+            index = suffix;
+            while(index < needle_len &&
+                  __ec_two_way_at(needle, needle_len, index, reverse) ==
+                  __ec_two_way_at(haystack, haystack_len, position + index,
+                                  reverse))
+                index++;
+            if(index >= needle_len)
+            {
+                index = suffix - 1;
+                while(index != (size_t)-1 &&
+                      __ec_two_way_at(needle, needle_len, index, reverse) ==
+                      __ec_two_way_at(haystack, haystack_len,
+                                      position + index, reverse))
+                    index--;
+                if(index == (size_t)-1)
+                    return position;
+                position += period;
+            }
+            else
+                position += index - suffix + 1;
+        }
+    }
+    return EC_STRVIEW_NPOS;
+}
+
+static const uint8_t *__ec_two_way(const uint8_t *haystack,
+                                   size_t haystack_len, const uint8_t *needle,
+                                   size_t needle_len)
+{
+    size_t found = __ec_two_way_search(haystack, haystack_len, needle,
+                                                        needle_len, false);
+    return (found == EC_STRVIEW_NPOS) ? EC_NULL : haystack + found;
+}
+
+/* The start of the last occurrence, or EC_STRVIEW_NPOS. */
+static size_t __ec_two_way_last(const uint8_t *haystack, size_t haystack_len,
+                                const uint8_t *needle, size_t needle_len)
+{
+    size_t found = __ec_two_way_search(haystack, haystack_len, needle,
+                                                        needle_len, true);
+    return (found == EC_STRVIEW_NPOS) ? EC_STRVIEW_NPOS
+                                      : haystack_len - needle_len - found;
+}
+
+#if defined(__EC_SIMD_WIDTH)
+/* Bitmask of the positions where both the first and the last byte of the
+ * needle match. */
+static inline uint32_t
+__attribute__ ((hot,always_inline))
+__ec_memmem_candidates(const uint8_t *block, size_t needle_len,
+                       __ec_simd_t first, __ec_simd_t last)
+{
+    return __ec_simd_mask(__ec_simd_and(
+                __ec_simd_eq(__ec_simd_load(block), first),
+                __ec_simd_eq(__ec_simd_load(block + needle_len - 1), last)));
+}
+#endif
+
+void *ec_memmem(const void *haystack, size_t haystack_len,
+                const void *needle, size_t needle_len)
+{
+    const uint8_t *uhaystack = (const uint8_t *)haystack;
+    const uint8_t *uneedle = (const uint8_t *)needle;
+    const uint8_t *found;
+    size_t position = 0;
+#if defined(__EC_SIMD_WIDTH)
+    __ec_simd_t first;
+    __ec_simd_t last;
+    uint32_t mask;
+    size_t work = 0;
+#endif
+
+    if(needle_len == 0)
+        return (void *)(uintptr_t)uhaystack;
+    if(needle_len > haystack_len)
+        return EC_NULL;
+    if(needle_len == 1)
+        return (void *)(uintptr_t)memchr(uhaystack, uneedle[0], haystack_len);
+
+#if defined(__EC_SIMD_WIDTH)
+    first = __ec_simd_splat(uneedle[0]);
+    last = __ec_simd_splat(uneedle[needle_len - 1]);
+    for(; position + needle_len - 1 + __EC_SIMD_WIDTH <= haystack_len;
+                                                 position += __EC_SIMD_WIDTH)
+    {
+        mask = __ec_memmem_candidates(uhaystack + position, needle_len,
+                                      first, last);
+        if(mask == 0 &&
+           position + needle_len - 1 + 2 * __EC_SIMD_WIDTH <= haystack_len)
+        {
+            /* Two vectors per iteration while there is nothing to verify. */
+            position += __EC_SIMD_WIDTH;
+            mask = __ec_memmem_candidates(uhaystack + position, needle_len,
+                                          first, last);
+        }
+        while(mask != 0)
+        {
+            found = uhaystack + position + __ec_simd_first(mask);
+            if(__ec_str_equal((const char *)found + 1,
+                              (const char *)uneedle + 1, needle_len - 2))
+                return (void *)(uintptr_t)found;
+            work += needle_len;
+            mask &= mask - 1;
+        }
+        /* Too many false candidates, e.g. "aaaa...b" in "aaaa...". Continue
+         * with Two-Way to keep the search linear. */
+        if(work > 4 * position + 4096)
+        {
+            position += __EC_SIMD_WIDTH;
+            break;
+        }
+    }
+    if(position + needle_len - 1 + __EC_SIMD_WIDTH > haystack_len)
+    {
+        /* Less than a vector of candidate positions is left. */
+        for(; position + needle_len <= haystack_len; position++)
+        {
+            if(uhaystack[position] == uneedle[0] &&
+               uhaystack[position + needle_len - 1] ==
+                   uneedle[needle_len - 1] &&
+               __ec_str_equal((const char *)uhaystack + position + 1,
+                              (const char *)uneedle + 1, needle_len - 2))
+                return (void *)(uintptr_t)(uhaystack + position);
+        }
+        return EC_NULL;
+    }
+#endif
+
+    found = __ec_two_way(uhaystack + position, haystack_len - position,
+                         uneedle, needle_len);
+    return (void *)(uintptr_t)found;
+}
+
+const char *ec_str_find(const char *haystack, size_t haystack_len,
+                        const char *needle)
+{
+    return (const char *)ec_memmem(haystack, haystack_len,
+                                   needle, strlen(needle));
+}
+
+void *ec_memchr2(const void *ptr, int ch1, int ch2, size_t len)
+{
+    const uint8_t *uptr = (const uint8_t *)ptr;
+    size_t index = 0;
+#if defined(__EC_SIMD_WIDTH)
+    __ec_simd_t first = __ec_simd_splat(ch1);
+    __ec_simd_t second = __ec_simd_splat(ch2);
+    __ec_simd_t block;
+    uint32_t mask;
+    for(; index + __EC_SIMD_WIDTH <= len; index += __EC_SIMD_WIDTH)
+    {
+        block = __ec_simd_load(uptr + index);
+        mask = __ec_simd_mask(__ec_simd_or(__ec_simd_eq(block, first),
+                                           __ec_simd_eq(block, second)));
+        if(mask != 0)
+            return (void *)(uintptr_t)(uptr + index + __ec_simd_first(mask));
+    }
+#endif
+    for(; index < len; index++)
+    {
+        if(uptr[index] == (uint8_t)ch1 || uptr[index] == (uint8_t)ch2)
+            return (void *)(uintptr_t)(uptr + index);
+    }
+    return EC_NULL;
+}
+
+void *ec_memchr3(const void *ptr, int ch1, int ch2, int ch3, size_t len)
+{
+    const uint8_t *uptr = (const uint8_t *)ptr;
+    size_t index = 0;
+#if defined(__EC_SIMD_WIDTH)
+    __ec_simd_t first = __ec_simd_splat(ch1);
+    __ec_simd_t second = __ec_simd_splat(ch2);
+    __ec_simd_t third = __ec_simd_splat(ch3);
+    __ec_simd_t block;
+    uint32_t mask;
+    for(; index + __EC_SIMD_WIDTH <= len; index += __EC_SIMD_WIDTH)
+    {
+        block = __ec_simd_load(uptr + index);
+        mask = __ec_simd_mask(__ec_simd_or(
+                    __ec_simd_or(__ec_simd_eq(block, first),
+                                 __ec_simd_eq(block, second)),
+                    __ec_simd_eq(block, third)));
+        if(mask != 0)
+            return (void *)(uintptr_t)(uptr + index + __ec_simd_first(mask));
+    }
+#endif
+    for(; index < len; index++)
+    {
+        if(uptr[index] == (uint8_t)ch1 || uptr[index] == (uint8_t)ch2 ||
+           uptr[index] == (uint8_t)ch3)
+            return (void *)(uintptr_t)(uptr + index);
+    }
+    return EC_NULL;
+}
+
+void ec_tokenizer_init(ec_tokenizer *tokenizer, ec_strview input,
+                       unsigned mode, const char *delimiters)
+{
+    const char *whitespaces = " \t\n\v\f\r";
+    size_t index;
+    tokenizer->ptr = input.ptr;
+    tokenizer->end = input.ptr + input.len;
+    tokenizer->mode = (uint8_t)mode;
+    tokenizer->set_len = 0;
+    tokenizer->done = false;
+    memset(tokenizer->table, 0, sizeof(tokenizer->table));
+    if((mode & 0x0FU) == EC_TOKENIZE_WHITESPACE)
+    {
+        tokenizer->mode |= EC_TOKENIZE_COLLAPSE;
+        delimiters = whitespaces;
+    }
+    else if((mode & 0x0FU) == EC_TOKENIZE_CHAR)
+    {
+        tokenizer->set[0] = delimiters[0];
+        tokenizer->set_len = 1;
+        tokenizer->table[(uint8_t)delimiters[0] >> 3] |=
+                                    (uint8_t)(1U << ((uint8_t)delimiters[0] & 7));
+        return;
+    }
+    for(index = 0; delimiters[index] != '\0'; index++)
+    {
+        if(index < sizeof(tokenizer->set))
+            tokenizer->set[index] = delimiters[index];
+        tokenizer->table[(uint8_t)delimiters[index] >> 3] |=
+                                (uint8_t)(1U << ((uint8_t)delimiters[index] & 7));
+    }
+    tokenizer->set_len = (index <= sizeof(tokenizer->set)) ? (uint8_t)index : 0;
+}
+
+static inline bool
+__attribute__ ((hot,always_inline))
+__ec_tokenizer_is_delimiter(const ec_tokenizer *tokenizer, char ch)
+{
+    return (tokenizer->table[(uint8_t)ch >> 3] >> ((uint8_t)ch & 7)) & 1U;
+}
+
+#if defined(__EC_SIMD_WIDTH)
+/* Bitmask of the delimiters inside the block starting at "ptr". */
+static inline uint32_t
+__attribute__ ((hot,always_inline))
+__ec_tokenizer_classify(const ec_tokenizer *tokenizer, const char *ptr)
+{
+    __ec_simd_t block = __ec_simd_load(ptr);
+    __ec_simd_t result;
+    unsigned index;
+    if((tokenizer->mode & 0x0FU) == EC_TOKENIZE_WHITESPACE)
+    {
+        /* ' ', or '\t' to '\r' which are 5 consecutive values. */
+        __ec_simd_t shifted = __ec_simd_sub(block, __ec_simd_splat('\t'));
+        return __ec_simd_mask(__ec_simd_or(
+                    __ec_simd_eq(block, __ec_simd_splat(' ')),
+                    __ec_simd_le_u8(shifted, __ec_simd_splat(4))));
+    }
+    result = __ec_simd_eq(block, __ec_simd_splat(tokenizer->set[0]));
+    for(index = 1; index < tokenizer->set_len; index++)
+        result = __ec_simd_or(result, __ec_simd_eq(block,
+                                    __ec_simd_splat(tokenizer->set[index])));
+    return __ec_simd_mask(result);
+}
+#endif
+
+/* Finds the first delimiter, or the first non delimiter if "delimiter" is
+ * false, inside [ptr, end). Returns "end" if there is none. */
+static inline const char *
+__attribute__ ((hot,always_inline))
+__ec_tokenizer_scan(const ec_tokenizer *tokenizer, const char *ptr,
+                    const char *end, bool delimiter)
+{
+#if defined(__EC_SIMD_WIDTH)
+    uint32_t mask;
+    if(tokenizer->set_len > 0 ||
+       (tokenizer->mode & 0x0FU) == EC_TOKENIZE_WHITESPACE)
+    {
+        for(; end - ptr >= __EC_SIMD_WIDTH; ptr += __EC_SIMD_WIDTH)
+        {
+            mask = __ec_tokenizer_classify(tokenizer, ptr);
+            if(!delimiter)
+                mask ^= __EC_SIMD_FULL_MASK;
+            if(mask != 0)
+                return ptr + __ec_simd_first(mask);
+        }
+    }
+#endif
+    for(; ptr < end; ptr++)
+    {
+        if(__ec_tokenizer_is_delimiter(tokenizer, *ptr) == delimiter)
+            return ptr;
+    }
+    return end;
+}
+
+bool ec_tokenizer_next(ec_tokenizer *tokenizer, ec_strview *field)
+{
+    const char *delimiter;
+    if(tokenizer->done)
+        return false;
+    if(tokenizer->mode & EC_TOKENIZE_COLLAPSE)
+    {
+        tokenizer->ptr = __ec_tokenizer_scan(tokenizer, tokenizer->ptr,
+                                             tokenizer->end, false);
+        if(tokenizer->ptr == tokenizer->end)
+        {
+            tokenizer->done = true;
+            return false;
+        }
+    }
+    delimiter = __ec_tokenizer_scan(tokenizer, tokenizer->ptr, tokenizer->end,
+                                    true);
+    *field = ec_strview_make(tokenizer->ptr,
+                             (size_t)(delimiter - tokenizer->ptr));
+    if(delimiter == tokenizer->end)
+        tokenizer->done = true;
+    else
+        tokenizer->ptr = delimiter + 1;
+    return true;
+}
+
 bool ec_str_starts_with(const char *ptr, const char *refference)
 {
-    return (strncmp(refference, ptr, strlen(refference)) == 0);
+    ec_strview prefix = ec_strview_from_cstr(refference);
+    /* Only the first prefix.len characters of ptr are of interest, so its
+     * length is never measured past that. */
+    const char *end = (const char *)memchr(ptr, '\0', prefix.len);
+    return ec_strview_starts_with(
+            ec_strview_make(ptr, (end == EC_NULL) ? prefix.len :
+                                                    (size_t)(end - ptr)),
+            prefix);
+}
+
+static const char __ec_hex_lower[] = "0123456789abcdef";
+static const char __ec_hex_upper[] = "0123456789ABCDEF";
+
+size_t ec_hex_encode(char *dst, const void *src, size_t len, bool upper_case)
+{
+    const uint8_t *bytes = (const uint8_t *)src;
+    const char *digits = upper_case ? __ec_hex_upper : __ec_hex_lower;
+    size_t index = 0;
+#if defined(__EC_SIMD_HEX16)
+    for(; index + 16 <= len; index += 16)
+        __ec_simd_hex16(dst + 2 * index, bytes + index, digits);
+#endif
+    for(; index < len; index++)
+    {
+        dst[2 * index]     = digits[bytes[index] >> 4];
+        dst[2 * index + 1] = digits[bytes[index] & 0x0F];
+    }
+    return EC_HEX_ENCODED_SIZE(len);
+}
+
+static const char __ec_base64_standard[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const char __ec_base64_url[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+size_t ec_base64_encode(char *dst, const void *src, size_t len, unsigned mode)
+{
+    const uint8_t *bytes = (const uint8_t *)src;
+    const char *alphabet = (mode & EC_BASE64_URL) ? __ec_base64_url
+                                                  : __ec_base64_standard;
+    char *out = dst;
+    uint32_t group;
+    size_t index = 0;
+    for(; index + 3 <= len; index += 3)
+    {
+        group = ((uint32_t)bytes[index] << 16) |
+                ((uint32_t)bytes[index + 1] << 8) | bytes[index + 2];
+        out[0] = alphabet[group >> 18];
+        out[1] = alphabet[(group >> 12) & 0x3F];
+        out[2] = alphabet[(group >> 6) & 0x3F];
+        out[3] = alphabet[group & 0x3F];
+        out += 4;
+    }
+    if(index < len)
+    {
+        group = (uint32_t)bytes[index] << 16;
+        if(index + 1 < len)
+            group |= (uint32_t)bytes[index + 1] << 8;
+        *out++ = alphabet[group >> 18];
+        *out++ = alphabet[(group >> 12) & 0x3F];
+        if(index + 1 < len)
+            *out++ = alphabet[(group >> 6) & 0x3F];
+        else if((mode & EC_BASE64_URL) == 0)
+            *out++ = '=';
+        if((mode & EC_BASE64_URL) == 0)
+            *out++ = '=';
+    }
+    return (size_t)(out - dst);
 }
 
 #ifdef __cplusplus
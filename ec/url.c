@@ -0,0 +1,625 @@
+/* <url.c> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ec/url.h>
+#include <ec/print.h>
+#include <ec/internal/simd.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* The characters which can stay as they are, by the classes of RFC 3986:
+ *      1   the unreserved ones: the letters, the digits and "-._~"
+ *      2   the others allowed in a path: '/', ':', '@' and "!$&'()*+,;="
+ *      4   the others allowed in a fragment: '?' */
+#define __EC_URL_UNRESERVED         0x01U
+#define __EC_URL_PCHAR              0x02U
+#define __EC_URL_FRAGMENT_CHAR      0x04U
+
+static const uint8_t __ec_url_classes[256] =
+{
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 2, 0, 0, 2, 0, 2, 2, 2, 2, 2, 2, 2, 1, 1, 2,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 0, 2, 0, 4,
+    2, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 1,
+    0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 1, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+/* The classes kept by an encoding mode. */
+static inline unsigned
+__attribute__ ((always_inline))
+__ec_url_kept_classes(unsigned mode)
+{
+    if(mode & EC_URL_FRAGMENT)
+        return __EC_URL_UNRESERVED | __EC_URL_PCHAR | __EC_URL_FRAGMENT_CHAR;
+    if(mode & EC_URL_PATH)
+        return __EC_URL_UNRESERVED | __EC_URL_PCHAR;
+    return __EC_URL_UNRESERVED;
+}
+
+static const char __ec_url_hex[] = "0123456789ABCDEF";
+
+/* Copies the runs between the escapes. They are mostly short, so a call to
+ * memmove costs more than the copy itself. Copying forwards is also safe
+ * when decoding in place, as the destination never gets ahead. */
+static inline char *
+__attribute__ ((hot,always_inline))
+__ec_url_copy(char *out, const char *src, size_t len)
+{
+    if(len >= 16)
+    {
+        memmove(out, src, len);
+        return out + len;
+    }
+    while(len-- > 0)
+        *out++ = *src++;
+    return out;
+}
+
+/* Writes the encoded form of a character which is not unreserved. */
+static inline char *
+__attribute__ ((hot,always_inline))
+__ec_url_escape(char *out, uint8_t ch, unsigned mode)
+{
+    if(ch == ' ' && (mode & EC_URL_FORM))
+    {
+        *out++ = '+';
+        return out;
+    }
+    out[0] = '%';
+    out[1] = __ec_url_hex[ch >> 4];
+    out[2] = __ec_url_hex[ch & 0x0F];
+    return out + 3;
+}
+
+#if defined(__EC_SIMD_WIDTH)
+/* The kept characters of an encoding mode, as vectors: the punctuation and
+ * the digits in the range "low" ... "low + span", except "excluded", and
+ * the "extra" characters. */
+typedef struct
+{
+    __ec_simd_t low;
+    __ec_simd_t span;
+    __ec_simd_t excluded;
+    __ec_simd_t extra[6];
+} __ec_url_simd_class;
+
+static inline void
+__attribute__ ((always_inline))
+__ec_url_simd_class_init(__ec_url_simd_class *cls, unsigned classes)
+{
+    if(classes & __EC_URL_PCHAR)
+    {
+        /* "$%&'()*+,-./0123456789:;", except '%' */
+        cls->low      = __ec_simd_splat(0x24);
+        cls->span     = __ec_simd_splat(0x3B - 0x24);
+        cls->excluded = __ec_simd_splat('%');
+        cls->extra[2] = __ec_simd_splat('!');
+        cls->extra[3] = __ec_simd_splat('=');
+        cls->extra[4] = __ec_simd_splat('@');
+        cls->extra[5] = __ec_simd_splat((classes & __EC_URL_FRAGMENT_CHAR)
+                                                                ? '?' : '_');
+    }
+    else
+    {
+        /* "-./0123456789", except '/' */
+        cls->low      = __ec_simd_splat(0x2D);
+        cls->span     = __ec_simd_splat(0x39 - 0x2D);
+        cls->excluded = __ec_simd_splat('/');
+        cls->extra[2] = __ec_simd_splat('_');
+        cls->extra[3] = cls->extra[2];
+        cls->extra[4] = cls->extra[2];
+        cls->extra[5] = cls->extra[2];
+    }
+    cls->extra[0] = __ec_simd_splat('_');
+    cls->extra[1] = __ec_simd_splat('~');
+}
+
+/* One bit per byte of the vector, set for the bytes needing an escape. */
+static inline uint32_t
+__attribute__ ((hot,always_inline))
+__ec_url_reserved_mask(const char *ptr, const __ec_url_simd_class *cls)
+{
+    __ec_simd_t vec = __ec_simd_load(ptr);
+    __ec_simd_t keep = __ec_simd_le_u8(__ec_simd_sub(vec, cls->low),
+                                                                cls->span);
+    /* the letters, folded to lower case */
+    keep = __ec_simd_or(keep, __ec_simd_le_u8(
+                __ec_simd_sub(__ec_simd_or(vec, __ec_simd_splat(0x20)),
+                              __ec_simd_splat('a')),
+                __ec_simd_splat('z' - 'a')));
+    keep = __ec_simd_or(keep,
+                __ec_simd_or(__ec_simd_eq(vec, cls->extra[0]),
+                             __ec_simd_eq(vec, cls->extra[1])));
+    keep = __ec_simd_or(keep,
+                __ec_simd_or(__ec_simd_eq(vec, cls->extra[2]),
+                             __ec_simd_eq(vec, cls->extra[3])));
+    keep = __ec_simd_or(keep,
+                __ec_simd_or(__ec_simd_eq(vec, cls->extra[4]),
+                             __ec_simd_eq(vec, cls->extra[5])));
+    return (__ec_simd_mask(keep) ^ __EC_SIMD_FULL_MASK) |
+                __ec_simd_mask(__ec_simd_eq(vec, cls->excluded));
+}
+
+/* One bit per byte of the vector, set for the '%' and, for EC_URL_FORM,
+ * the '+' characters. */
+static inline uint32_t
+__attribute__ ((hot,always_inline))
+__ec_url_escape_mask(const char *ptr, __ec_simd_t plus)
+{
+    __ec_simd_t vec = __ec_simd_load(ptr);
+    return __ec_simd_mask(__ec_simd_or(__ec_simd_eq(vec, __ec_simd_splat('%')),
+                                       __ec_simd_eq(vec, plus)));
+}
+#endif
+
+/* The encoder, for the kept "classes" of the mode. It is given constants,
+ * so the vectors of each set are built from immediates. */
+static inline size_t
+__attribute__ ((hot,always_inline))
+__ec_url_encode_classes(char *dst, const char *src, size_t len, unsigned mode,
+                                                        const unsigned classes)
+{
+    char *out = dst;
+    size_t index = 0;
+    uint8_t ch;
+#if defined(__EC_SIMD_WIDTH)
+    __ec_url_simd_class cls;
+    uint32_t mask;
+    size_t start, position;
+    __ec_url_simd_class_init(&cls, classes);
+    for(; index + __EC_SIMD_WIDTH <= len; index += __EC_SIMD_WIDTH)
+    {
+        mask = __ec_url_reserved_mask(src + index, &cls);
+        if(mask == 0)
+        {
+            memcpy(out, src + index, __EC_SIMD_WIDTH);
+            out += __EC_SIMD_WIDTH;
+            continue;
+        }
+        /* The runs between the escapes are copied as they are. */
+        start = 0;
+        while(mask != 0)
+        {
+            position = __ec_simd_first(mask);
+            out = __ec_url_copy(out, src + index + start, position - start);
+            out = __ec_url_escape(out, (uint8_t)src[index + position], mode);
+            start = position + 1;
+            mask &= mask - 1;
+        }
+        if(start < __EC_SIMD_WIDTH)
+            out = __ec_url_copy(out, src + index + start,
+                                                    __EC_SIMD_WIDTH - start);
+    }
+#endif
+    for(; index < len; index++)
+    {
+        ch = (uint8_t)src[index];
+        if(__ec_url_classes[ch] & classes)
+            *out++ = (char)ch;
+        else
+            out = __ec_url_escape(out, ch, mode);
+    }
+    return (size_t)(out - dst);
+}
+
+size_t ec_url_encode(char *dst, const char *src, size_t len, unsigned mode)
+{
+    switch(__ec_url_kept_classes(mode))
+    {
+        case __EC_URL_UNRESERVED:
+            return __ec_url_encode_classes(dst, src, len, mode,
+                                                        __EC_URL_UNRESERVED);
+        case __EC_URL_UNRESERVED | __EC_URL_PCHAR:
+            return __ec_url_encode_classes(dst, src, len, mode,
+                                        __EC_URL_UNRESERVED | __EC_URL_PCHAR);
+        default:
+            return __ec_url_encode_classes(dst, src, len, mode,
+                                        __EC_URL_UNRESERVED | __EC_URL_PCHAR |
+                                                    __EC_URL_FRAGMENT_CHAR);
+    }
+}
+
+/* Value of a hexadecimal digit, or 16 for anything else. */
+static inline unsigned
+__attribute__ ((hot,always_inline))
+__ec_url_hex_value(char ch)
+{
+    unsigned value = (unsigned)(uint8_t)ch - '0';
+    if(value <= 9)
+        return value;
+    value = ((unsigned)(uint8_t)ch | 0x20U) - 'a';
+    if(value <= 5)
+        return value + 10;
+    return 16;
+}
+
+/* Decodes the escape at "position", which the caller found to be a '%' or
+ * a '+', and returns the position after it. */
+static inline size_t
+__attribute__ ((hot,always_inline))
+__ec_url_unescape(char **out, const char *src, size_t position, size_t len)
+{
+    unsigned high, low;
+    if(src[position] == '+')
+    {
+        *(*out)++ = ' ';
+        return position + 1;
+    }
+    high = (position + 2 < len) ? __ec_url_hex_value(src[position + 1]) : 16;
+    low  = (high < 16) ? __ec_url_hex_value(src[position + 2]) : 16;
+    if(low < 16)
+    {
+        *(*out)++ = (char)((high << 4) | low);
+        return position + 3;
+    }
+    *(*out)++ = '%';
+    return position + 1;
+}
+
+size_t ec_url_decode(char *dst, const char *src, size_t len, unsigned mode)
+{
+    char *out = dst;
+    /* Everything before it is decoded already. */
+    size_t done = 0;
+    size_t index = 0;
+    size_t position;
+#if defined(__EC_SIMD_WIDTH)
+    __ec_simd_t plus = __ec_simd_splat((mode & EC_URL_FORM) ? '+' : '%');
+    uint32_t mask;
+    for(; index + __EC_SIMD_WIDTH <= len; index += __EC_SIMD_WIDTH)
+    {
+        mask = __ec_url_escape_mask(src + index, plus);
+        while(mask != 0)
+        {
+            position = index + __ec_simd_first(mask);
+            mask &= mask - 1;
+            /* Part of the previous escape, e.g. "%25" */
+            if(position < done)
+                continue;
+            out = __ec_url_copy(out, src + done, position - done);
+            done = __ec_url_unescape(&out, src, position, len);
+        }
+    }
+    if(index < done)
+        index = done;
+#endif
+    for(; index < len; index++)
+    {
+        if(index < done)
+            continue;
+        if(src[index] == '%' || (src[index] == '+' && (mode & EC_URL_FORM)))
+        {
+            out = __ec_url_copy(out, src + done, index - done);
+            done = __ec_url_unescape(&out, src, index, len);
+        }
+    }
+    out = __ec_url_copy(out, src + done, len - done);
+    return (size_t)(out - dst);
+}
+
+bool ec_strbuf_append_url_encoded(ec_strbuf *buf, const char *src, size_t len,
+                                                                unsigned mode)
+{
+    char chunk[EC_URL_ENCODED_SIZE(64)];
+    size_t part;
+    /* Encoded right into the builder when it has the room, e.g. when it can
+     * grow, otherwise through the stack, a chunk at a time. */
+    if(len <= ((size_t)-1) / 3 &&
+                            ec_strbuf_reserve(buf, EC_URL_ENCODED_SIZE(len)))
+    {
+        buf->len += ec_url_encode(buf->data + buf->len, src, len, mode);
+        buf->data[buf->len] = '\0';
+        return ((buf->flags & EC_STRBUF_FAILED) == 0);
+    }
+    while(len > 0)
+    {
+        part = (len < 64) ? len : 64;
+        ec_strbuf_append_n(buf, chunk, ec_url_encode(chunk, src, part, mode));
+        src += part;
+        len -= part;
+    }
+    return ((buf->flags & EC_STRBUF_FAILED) == 0);
+}
+
+ec_strview ec_url_decode_view(ec_strview view, char *dst, unsigned mode)
+{
+    if(ec_memchr2(view.ptr, '%', (mode & EC_URL_FORM) ? '+' : '%',
+                                                        view.len) == EC_NULL)
+        return view;
+    return ec_strview_make(dst, ec_url_decode(dst, view.ptr, view.len, mode));
+}
+
+/* 1 for the characters allowed in a scheme after its first letter. */
+static inline bool
+__attribute__ ((always_inline))
+__ec_url_is_scheme(char ch)
+{
+    return ((ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') ||
+            (ch >= '0' && ch <= '9') || ch == '+' || ch == '-' || ch == '.');
+}
+
+/* Splits "userinfo@host:port", which is between "ptr" and "end". */
+static bool __ec_url_parse_authority(ec_url *url, const char *ptr,
+                                                            const char *end)
+{
+    const char *cursor;
+    const char *colon = end;
+    unsigned port = 0;
+    /* The host can not have a '@', the userinfo can. */
+    for(cursor = end; cursor > ptr; cursor--)
+    {
+        if(cursor[-1] == '@')
+        {
+            url->userinfo = ec_strview_make(ptr, (size_t)(cursor - 1 - ptr));
+            ptr = cursor;
+            break;
+        }
+    }
+    if(ptr < end && *ptr == '[')
+    {
+        cursor = (const char *)memchr(ptr, ']', (size_t)(end - ptr));
+        if(cursor == EC_NULL)
+            return false;
+        colon = cursor + 1;
+        if(colon < end && *colon != ':')
+            return false;
+    }
+    else
+    {
+        for(cursor = end; cursor > ptr; cursor--)
+        {
+            if(cursor[-1] == ':')
+            {
+                colon = cursor - 1;
+                break;
+            }
+        }
+    }
+    url->host = ec_strview_make(ptr, (size_t)(colon - ptr));
+    if(colon == end)
+        return true;
+    for(cursor = colon + 1; cursor < end; cursor++)
+    {
+        if(*cursor < '0' || *cursor > '9')
+            return false;
+        port = port * 10 + (unsigned)(*cursor - '0');
+        if(port > 65535)
+            return false;
+    }
+    url->port = ec_strview_make(colon + 1, (size_t)(end - colon - 1));
+    url->port_number = (uint16_t)port;
+    return true;
+}
+
+bool ec_url_parse(ec_url *url, ec_strview input)
+{
+    const char *ptr = input.ptr;
+    const char *end = input.ptr + input.len;
+    const char *stop;
+    size_t index;
+    url->scheme   = ec_strview_make(EC_NULL, 0);
+    url->userinfo = url->scheme;
+    url->host     = url->scheme;
+    url->port     = url->scheme;
+    url->query    = url->scheme;
+    url->fragment = url->scheme;
+    url->port_number = 0;
+    /* A scheme is a letter followed by letters, digits, '+', '-' and '.' up
+     * to a ':'. Anything else, e.g. "/a:b", is a relative reference. */
+    if(input.len > 0 && ((*ptr | 0x20) >= 'a' && (*ptr | 0x20) <= 'z'))
+    {
+        for(index = 1; index < input.len && __ec_url_is_scheme(ptr[index]);
+                                                                    index++);
+        if(index < input.len && ptr[index] == ':')
+        {
+            url->scheme = ec_strview_make(ptr, index);
+            ptr += index + 1;
+        }
+    }
+    if(end - ptr >= 2 && ptr[0] == '/' && ptr[1] == '/')
+    {
+        ptr += 2;
+        stop = (const char *)ec_memchr3(ptr, '/', '?', '#',
+                                                        (size_t)(end - ptr));
+        if(stop == EC_NULL)
+            stop = end;
+        if(!__ec_url_parse_authority(url, ptr, stop))
+            return false;
+        ptr = stop;
+    }
+    stop = (const char *)ec_memchr2(ptr, '?', '#', (size_t)(end - ptr));
+    if(stop == EC_NULL)
+        stop = end;
+    url->path = ec_strview_make(ptr, (size_t)(stop - ptr));
+    if(stop < end && *stop == '?')
+    {
+        ptr = stop + 1;
+        stop = (const char *)memchr(ptr, '#', (size_t)(end - ptr));
+        if(stop == EC_NULL)
+            stop = end;
+        url->query = ec_strview_make(ptr, (size_t)(stop - ptr));
+    }
+    if(stop < end)
+        url->fragment = ec_strview_make(stop + 1, (size_t)(end - stop - 1));
+    return true;
+}
+
+void ec_url_query_init(ec_url_query *query, ec_strview input)
+{
+    query->ptr = input.ptr;
+    query->end = input.ptr + input.len;
+}
+
+bool ec_url_query_next(ec_url_query *query, ec_url_param *param)
+{
+    const char *ptr;
+    const char *stop;
+    const char *equal;
+    while(query->ptr < query->end)
+    {
+        ptr = query->ptr;
+        stop = (const char *)memchr(ptr, '&', (size_t)(query->end - ptr));
+        if(stop == EC_NULL)
+            stop = query->end;
+        query->ptr = (stop < query->end) ? stop + 1 : stop;
+        if(stop == ptr)
+            continue;
+        equal = (const char *)memchr(ptr, '=', (size_t)(stop - ptr));
+        if(equal == EC_NULL)
+        {
+            param->key   = ec_strview_make(ptr, (size_t)(stop - ptr));
+            param->value = ec_strview_make(EC_NULL, 0);
+        }
+        else
+        {
+            param->key   = ec_strview_make(ptr, (size_t)(equal - ptr));
+            param->value = ec_strview_make(equal + 1,
+                                                (size_t)(stop - equal - 1));
+        }
+        return true;
+    }
+    return false;
+}
+
+bool ec_url_query_find(ec_strview input, ec_strview key, ec_strview *value)
+{
+    ec_url_query query;
+    ec_url_param param;
+    ec_url_query_init(&query, input);
+    while(ec_url_query_next(&query, &param))
+    {
+        if(ec_strview_equals(param.key, key))
+        {
+            *value = param.value;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Appends a view percent-encoded. */
+static inline void
+__attribute__ ((always_inline))
+__ec_url_append_part(ec_strbuf *buf, ec_strview part, unsigned mode)
+{
+    ec_strbuf_append_url_encoded(buf, part.ptr, part.len, mode);
+}
+
+bool ec_strbuf_append_url(ec_strbuf *buf, const ec_url *url,
+                                const ec_url_param *params, size_t count)
+{
+    size_t index;
+    size_t user;
+    bool separator = false;
+    if(url->scheme.ptr != EC_NULL)
+    {
+        ec_strbuf_append_view(buf, url->scheme);
+        ec_strbuf_append_char(buf, ':');
+    }
+    if(url->host.ptr != EC_NULL)
+    {
+        ec_strbuf_append_n(buf, "//", 2);
+        if(url->userinfo.ptr != EC_NULL)
+        {
+            /* The ':' between the user and the password is kept. */
+            user = ec_strview_find_char(url->userinfo, ':');
+            if(user == EC_STRVIEW_NPOS)
+                user = url->userinfo.len;
+            ec_strbuf_append_url_encoded(buf, url->userinfo.ptr, user,
+                                                            EC_URL_COMPONENT);
+            if(user < url->userinfo.len)
+            {
+                ec_strbuf_append_char(buf, ':');
+                __ec_url_append_part(buf, ec_strview_slice(url->userinfo,
+                            user + 1, EC_STRVIEW_NPOS), EC_URL_COMPONENT);
+            }
+            ec_strbuf_append_char(buf, '@');
+        }
+        if(url->host.len > 0 && url->host.ptr[0] == '[')
+            ec_strbuf_append_view(buf, url->host);
+        else
+            __ec_url_append_part(buf, url->host, EC_URL_COMPONENT);
+        if(url->port.ptr != EC_NULL)
+        {
+            ec_strbuf_append_char(buf, ':');
+            ec_strbuf_append_view(buf, url->port);
+        }
+        else if(url->port_number != 0)
+        {
+            ec_strbuf_append_char(buf, ':');
+            ec_strbuf_print_uint(buf, url->port_number);
+        }
+        /* A path following a host must start with a '/'. */
+        if(url->path.len > 0 && url->path.ptr[0] != '/')
+            ec_strbuf_append_char(buf, '/');
+    }
+    if(url->path.ptr != EC_NULL)
+        __ec_url_append_part(buf, url->path, EC_URL_PATH);
+    if(url->query.ptr != EC_NULL || count > 0)
+    {
+        ec_strbuf_append_char(buf, '?');
+        if(url->query.ptr != EC_NULL)
+        {
+            ec_strbuf_append_view(buf, url->query);
+            separator = (url->query.len > 0);
+        }
+        for(index = 0; index < count; index++)
+        {
+            if(separator)
+                ec_strbuf_append_char(buf, '&');
+            separator = true;
+            __ec_url_append_part(buf, params[index].key, EC_URL_FORM);
+            if(params[index].value.ptr != EC_NULL)
+            {
+                ec_strbuf_append_char(buf, '=');
+                __ec_url_append_part(buf, params[index].value, EC_URL_FORM);
+            }
+        }
+    }
+    if(url->fragment.ptr != EC_NULL)
+    {
+        ec_strbuf_append_char(buf, '#');
+        __ec_url_append_part(buf, url->fragment, EC_URL_FRAGMENT);
+    }
+    return ((buf->flags & EC_STRBUF_FAILED) == 0);
+}
+
+#ifdef __cplusplus
+}
+#endif
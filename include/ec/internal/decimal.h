@@ -0,0 +1,145 @@
+/* <decimal.h> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+/**
+ * @file decimal.h
+ * @brief       An exact decimal number of up to 800 digits, shifted by powers
+ *              of two. Every double has an exact decimal expansion of at most
+ *              767 significant digits, so this is the common ground of the
+ *              slow paths of parsing (atof) and of formatting (ftoa).
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef ECLIBC_INTERNAL_DECIMAL_H
+#define ECLIBC_INTERNAL_DECIMAL_H 1
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Since different compilers and different platforms implement NULL in a
+ * different manner, EC_NULL is a helping macro to unify the NULL pointer over
+ * all platforms.
+ * E.g. some platforms have __builtin_null (like XC16) and some define it the
+ *      same exact way.
+ */
+#ifndef EC_NULL
+#define EC_NULL ((void *)0)
+#endif
+
+/* All CPP compilers on the other hand, use the same exact NULL pointer on all
+ * platforms. So, there is no need to change the course of standard C++ library.
+ */
+#ifdef __cplusplus
+#undef EC_NULL
+#define EC_NULL NULL
+#endif
+
+/* 800 digits are enough to tell the half way cases of parsing apart; the
+ * dropped digits are only remembered as "truncated". */
+#define __EC_DECIMAL_DIGITS     800
+#define __EC_DECIMAL_MAX_SHIFT  60
+
+/* The value is 0.d[0]d[1]...d[count - 1] * 10^point, without trailing
+ * zeros. */
+typedef struct
+{
+    uint8_t digits[__EC_DECIMAL_DIGITS];
+    int     count;
+    int     point;
+    bool    truncated;
+} __ec_decimal;
+
+static inline void
+__attribute__ ((unused, always_inline))
+__ec_decimal_trim(__ec_decimal *decimal)
+{
+    while(decimal->count > 0 && decimal->digits[decimal->count - 1] == 0)
+        decimal->count--;
+    if(decimal->count == 0)
+        decimal->point = 0;
+}
+
+/**
+ * @brief __ec_decimal_append  Appends the digits of a parsed literal.
+ * @param [in]decimal   The number.
+ * @param [in]ptr       The digits.
+ * @param [in]len       Number of the digits.
+ * @param [in]integer   true if the digits are before the decimal point.
+ */
+void __ec_decimal_append(__ec_decimal *decimal, const char *ptr, size_t len,
+                         bool integer);
+
+/**
+ * @brief __ec_decimal_assign  Sets the number to an integer.
+ * @param [out]decimal  The number.
+ * @param [in]value     The integer.
+ */
+void __ec_decimal_assign(__ec_decimal *decimal, uint64_t value);
+
+/**
+ * @brief __ec_decimal_shift   Multiplies the number by 2^shift, or divides
+ *                             it by 2^-shift when shift is negative.
+ * @param [in]decimal   The number.
+ * @param [in]shift     The power of two.
+ */
+void __ec_decimal_shift(__ec_decimal *decimal, int shift);
+
+/**
+ * @brief __ec_decimal_rounded_integer     The integer part, rounded half to
+ *                                         even.
+ * @param [in]decimal   The number.
+ * @return              The integer, UINT64_MAX if it does not fit.
+ */
+uint64_t __ec_decimal_rounded_integer(const __ec_decimal *decimal);
+
+/**
+ * @brief __ec_decimal_round_up    Keeps the first "keep" digits and adds one
+ *                                 unit to the last of them, carrying into a
+ *                                 new leading digit when needed. A
+ *                                 non-positive "keep" rounds up to the unit
+ *                                 at that position, e.g. 0.004 kept to -2
+ *                                 digits becomes 0.01.
+ * @param [in]decimal   The number.
+ * @param [in]keep      Number of the digits kept.
+ */
+void __ec_decimal_round_up(__ec_decimal *decimal, int keep);
+
+/**
+ * @brief __ec_decimal_round_down  Keeps the first "keep" digits and drops the
+ *                                 rest.
+ * @param [in]decimal   The number.
+ * @param [in]keep      Number of the digits kept.
+ */
+void __ec_decimal_round_down(__ec_decimal *decimal, int keep);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -113,6 +113,10 @@ typedef enum
     /* for 'G' , shortest double form    */
     glibc_printf_form_float_g           = 'g',
     /* for 'g' , shortest double form    */
+    glibc_printf_form_floathex_Cap      = 'A',
+    /* for 'A' , aka double hex form     */
+    glibc_printf_form_float_hex_Lower   = 'a',
+    /* for 'a' , aka double hex form     */
     glibc_printf_form_character         = 'c',
     /* for 'c' , aka char      = 1 byte  */
     glibc_printf_form_string_1          = 's',
@@ -126,10 +130,6 @@ typedef enum
     glibc_printf_form_strerror          = 'm',
     /* for 'm' , ="%s", strerror (errno) */
 
-    glibc_printf_form_floathex_Cap      = 'A',               /* NOT SUPPORTED */
-    /* for 'A' , aka double hex form     */                  /* NOT SUPPORTED */
-    glibc_printf_form_float_hex_Lower   = 'a',               /* NOT SUPPORTED */
-    /* for 'a' , aka double hex form     */                  /* NOT SUPPORTED */
     glibc_printf_mod_intmax_t           = 'j',               /* NOT SUPPORTED */
     /* for 'j' , int max, */                                 /* NOT SUPPORTED */
     glibc_printf_form_wcharacter        = 'C',               /* NOT SUPPORTED */
@@ -249,11 +249,27 @@ typedef enum
                             /* Boolean (True, False) */
     eclibc_printf_bool                  = 'B', /* False = 0 / True = ?        */
 
+                              /* Floating point */
+    eclibc_printf_double_shortest       = 'g',
+    /* the shortest string reading back as the same double   0.1, 1e+21       */
+    /* 'h' format takes the value as a float                 0.1f is 0.1      */
+    /* ^ can be used to capitalize the exponent, INF and NAN                  */
+
                               /* Special Character */
 
     eclibc_printf_utf8                  = 'U',
     /* prints UTF characters, using ec_utf8_t                                 */
 
+                               /* Binary buffers */
+    /* All of them take a pointer and a size_t length. A precision limits    */
+    /* the number of the bytes printed, e.g. "%!.16x" prints 16 at most.     */
+    eclibc_printf_hex                   = 'x', /* deadbeef                    */
+    /* ^ can be used to capitalize the digits                DEADBEEF         */
+    eclibc_printf_hexdump               = 'X', /* de ad be ef                 */
+    /* ^ prints the lines of "hexdump -C", with the offsets and the text      */
+    eclibc_printf_base64                = 'e', /* 3q2+7w==                    */
+    /* ^ uses the URL alphabet, without padding              3q2-7w           */
+
 
                                /* Network formats */
     eclibc_printf_phone_number          = 'P',               /* +XXYYYZZZZZZZ */
@@ -0,0 +1,149 @@
+/* <printf_compile.h> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <ec/internal/text_parse/printf_format.h>
+#include <ec/internal/printf_perform.h>
+
+#ifndef ECLIBC_INTERNAL_PRINTF_COMPILE_H
+#define ECLIBC_INTERNAL_PRINTF_COMPILE_H 1
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Since different compilers and different platforms implement NULL in a
+ * different manner, EC_NULL is a helping macro to unify the NULL pointer over
+ * all platforms.
+ * E.g. some platforms have __builtin_null (like XC16) and some define it the
+ *      same exact way.
+ */
+#ifndef EC_NULL
+#define EC_NULL ((void *)0)
+#endif
+
+/* All CPP compilers on the other hand, use the same exact NULL pointer on all
+ * platforms. So, there is no need to change the course of standard C++ library.
+ */
+#ifdef __cplusplus
+#undef EC_NULL
+#define EC_NULL NULL
+#endif
+
+/**
+ *****************************************************************************
+ **                                                                         **
+ **                          How to use this API                            **
+ **                                                                         **
+ *****************************************************************************
+ *****************************************************************************
+ **                                                                         **
+ ** ec_printf parses its format string on every call. A format which is     **
+ ** used over and over, e.g. a log line, can be parsed once instead:        **
+ **                                                                         **
+ **      ec_printf_format $FMT$;                                            **
+ **      ec_printf_compile(&$FMT$, "%s: %5d %!i\n");                        **
+ **      ec_printf_compiled(&$FMT$, name, count, ip);                       **
+ **      ...                                                                **
+ **      ec_printf_format_delete(&$FMT$);                                   **
+ **                                                                         **
+ ** The compiled format keeps its own copy of the format string.            **
+ **                                                                         **
+ ** For formats given as string literals, ec_printf_cached and              **
+ ** ec_fprintf_cached do the same thing behind the scenes: every call site  **
+ ** compiles its format on the first call and keeps it for the lifetime of **
+ ** the program. ec_printf and ec_fprintf use them on their own when the    **
+ ** format is a constant.                                                   **
+ **      ec_printf_cached("%s: %5d %!i\n", name, count, ip);                **
+ **                                                                         **
+ *****************************************************************************
+ *****************************************************************************
+ **/
+
+/* A literal span of the format, followed by a specifier. */
+typedef struct
+{
+    const char      *literal;
+    size_t           literal_len;
+    /* The specifier as written in the format, printed as is if the engine
+     * does not support it. spec_len is 0 if there is no specifier, which is
+     * only the case for the last operation. */
+    const char      *spec;
+    size_t           spec_len;
+    /* The handler of a "%!" specifier and its context, as registered when
+     * the format was compiled. EC_NULL for the built-in formats. */
+    ec_printf_handler_t handler;
+    void            *context;
+    __ec_printf_args args;
+} __ec_printf_op;
+
+typedef struct
+{
+    __ec_printf_op  *ops;
+    size_t           count;
+    /* The format given to ec_printf_compile, not the copy. */
+    const char      *source;
+    /* __ec_printf_handlers_generation when the handlers were looked up. */
+    unsigned         handlers;
+} ec_printf_format;
+
+/**
+ * @brief ec_printf_compile     Parses a format string once, to be printed any
+ *                              number of times using ec_printf_compiled and
+ *                              the likes.
+ * @param [out]compiled         The compiled format.
+ * @param [in]format            The format string. It is copied, so it does not
+ *                              need to outlive the compiled format.
+ * @return                      false if the memory allocation failed.
+ */
+bool ec_printf_compile(ec_printf_format *compiled, const char *format);
+
+/**
+ * @brief ec_printf_format_delete   Releases the memory of a compiled format.
+ * @param [in]compiled              The compiled format.
+ */
+void ec_printf_format_delete(ec_printf_format *compiled);
+
+/**
+ * @brief __ec_printf_site_format   Returns the compiled format of a call site
+ *                                  of the cached printf family, compiling it
+ *                                  on the first call. Safe to be called from
+ *                                  several threads at once.
+ * @param [in]site                  The cache of the call site.
+ * @param [in]format                The format string of the call site.
+ * @return                          The compiled format, or EC_NULL if the
+ *                                  memory allocation failed or the site was
+ *                                  compiled for another format. The format
+ *                                  is to be printed uncached then.
+ */
+const ec_printf_format *__ec_printf_site_format(ec_printf_format **site,
+                                                        const char *format);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
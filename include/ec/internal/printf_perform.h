@@ -0,0 +1,204 @@
+/* <printf_perform.h> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <ec/internal/text_parse/printf_format.h>
+#include <ec/strbuf.h>
+
+#ifndef ECLIBC_INTERNAL_PRINTF_PERFORM_H
+#define ECLIBC_INTERNAL_PRINTF_PERFORM_H 1
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Since different compilers and different platforms implement NULL in a
+ * different manner, EC_NULL is a helping macro to unify the NULL pointer over
+ * all platforms.
+ * E.g. some platforms have __builtin_null (like XC16) and some define it the
+ *      same exact way.
+ */
+#ifndef EC_NULL
+#define EC_NULL ((void *)0)
+#endif
+
+/* All CPP compilers on the other hand, use the same exact NULL pointer on all
+ * platforms. So, there is no need to change the course of standard C++ library.
+ */
+#ifdef __cplusplus
+#undef EC_NULL
+#define EC_NULL NULL
+#endif
+
+/*
+ * The formatting core shared by all the printf families. It prints a single
+ * specifier to an ec_strbuf, and the builder decides where the characters
+ * go:
+ *     ec_strbuf_init_fixed      a bounded buffer, ec_snprintf and friends
+ *     ec_strbuf_init_inline     a growable string, ec_strbuf_append_fmt
+ *     ec_strbuf_init_sink       anything else, in chunks: a FILE for
+ *                               ec_fprintf, the writev gatherer of
+ *                               ec_dprintf, a ring buffer, ...
+ * The arguments are taken through a pointer, so every caller advances the
+ * same va_list no matter how the platform passes it.
+ */
+
+/**
+ *****************************************************************************
+ **                                                                         **
+ **                        Adding your own specifiers                       **
+ **                                                                         **
+ *****************************************************************************
+ *****************************************************************************
+ **                                                                         **
+ ** Any character which is not a modifier can be given a handler for the    **
+ ** "%!" formats, so a type of the program prints straight to the output,   **
+ ** without formatting it to a temporary string first:                      **
+ **                                                                         **
+ **      static bool print_price(ec_strbuf *buf, const ec_printf_spec *spec,**
+ **                              va_list *arg, void *context)               **
+ **      {                                                                  **
+ **          int64_t cents = va_arg(*arg, int64_t);                         **
+ **          return ec_strbuf_append_fmt(buf, "%lld.%.2lld",                **
+ **                                         cents / 100, cents % 100);      **
+ **      }                                                                  **
+ **      ...                                                                **
+ **      ec_printf_register('p', print_price, EC_NULL);                     **
+ **      ec_printf("total: %!p\n", cents);                                  **
+ **                                                                         **
+ ** The handlers are found with a single look up in a table of 256 entries  **
+ ** and are used by all the printf families, including the compiled and     **
+ ** the cached ones. A compiled format keeps the handlers of its specifiers **
+ ** and looks them up again only if ec_printf_register was called since it  **
+ ** was compiled. A handler registered for a built-in character replaces    **
+ ** the built-in format. Register the handlers before printing from other   **
+ ** threads, the table is not locked.                                       **
+ **                                                                         **
+ *****************************************************************************
+ *****************************************************************************
+ **/
+
+/* The parsed specifier, as seen by the handlers:
+ *      format_chr      the character after "%!"
+ *      NumberLeft      the width, or 0
+ *      NumberRight     the precision, or 0
+ *      NumSeen         1 if a width was given, 2 if a precision, 3 for both
+ *      alternateForm   1 for "%!^"
+ *      Size            0 for 'h', 1 by default, 2 for 'l' and 3 for "ll" */
+typedef __ec_printf_args ec_printf_spec;
+
+/**
+ * @brief ec_printf_handler_t   Prints a "%!" specifier.
+ * @param [in]buf               The destination.
+ * @param [in]spec              The specifier.
+ * @param [in]arg               The arguments. Take the value(s) using
+ *                              va_arg(*arg, type).
+ * @param [in]context           The context given to ec_printf_register.
+ * @return                      false if the value can not be printed, in
+ *                              which case nothing must be printed and no
+ *                              argument must be taken. The specifier itself
+ *                              is printed then.
+ */
+typedef bool (*ec_printf_handler_t)(ec_strbuf *buf, const ec_printf_spec *spec,
+                                                va_list *arg, void *context);
+
+/**
+ * @brief ec_printf_register    Sets the handler of a "%!" specifier.
+ * @param [in]specifier         The character after "%!".
+ * @param [in]handler           The handler, or EC_NULL to remove it.
+ * @param [in]context           Passed to the handler as is.
+ * @return                      false if the character can not be used, i.e.
+ *                              it is '\0', '%' or one of the modifiers
+ *                              ("^+-*.0123456789hlLq").
+ * @note                        These characters are taken by the built-in
+ *                              formats, see <print_format_table.h>, and a
+ *                              handler registered for one of them replaces
+ *                              the built-in format:
+ *                                  "BCDHIMPSTUXZbcdegimostx"
+ */
+bool ec_printf_register(char specifier, ec_printf_handler_t handler,
+                                                                void *context);
+
+/**
+ * @brief __ec_printf_find_handler  Looks up the handler of a "%!" specifier.
+ * @param [in]specifier         The character after "%!".
+ * @param [out]context          The context of the handler.
+ * @return                      The handler, or EC_NULL if there is none.
+ */
+ec_printf_handler_t __ec_printf_find_handler(char specifier, void **context);
+
+/**
+ * @brief __ec_printf_handlers_generation   Returns a number which changes on
+ *                              every ec_printf_register call, to tell if the
+ *                              handlers found earlier are still the same.
+ */
+unsigned __ec_printf_handlers_generation(void);
+
+/**
+ * @brief __ec_printf_perform   Prints a parsed specifier.
+ * @param [in]__s               The destination.
+ * @param [in]__ec_args         The parsed specifier. Modified while printing.
+ * @param [in]__arg             The arguments, advanced past the used ones.
+ * @return                      false if the specifier is unknown. Nothing is
+ *                              printed then, and no argument is used.
+ */
+__attribute__((hot,noinline))
+bool
+__ec_printf_perform(ec_strbuf *__restrict __s,
+                    __ec_printf_args *__restrict __ec_args, va_list *__arg);
+
+/**
+ * @brief __ec_printf_perform_builtin The same as __ec_printf_perform, without
+ *                              looking for a handler, for the specifiers
+ *                              which are known to have none.
+ */
+__attribute__((hot,noinline))
+bool
+__ec_printf_perform_builtin(ec_strbuf *__restrict __s,
+                       __ec_printf_args *__restrict __ec_args, va_list *__arg);
+
+/**
+ * @brief __ec_urlprintf_perform The same as __ec_printf_perform, with the
+ *                              values percent-encoded and the field widths
+ *                              ignored, for ec_urlprintf.
+ */
+__attribute__((hot,noinline))
+bool
+__ec_urlprintf_perform(ec_strbuf *__restrict __s,
+                       __ec_printf_args *__restrict __ec_args, va_list *__arg);
+
+/**
+ * @brief __ec_strbuf_append_url_vfmt The same as ec_strbuf_append_vfmt, using
+ *                              __ec_urlprintf_perform.
+ */
+bool __ec_strbuf_append_url_vfmt(ec_strbuf *buf, const char *format,
+                                                                va_list arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,232 @@
+/* <simd.h> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <stdint.h>
+#include <stddef.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#ifndef ECLIBC_INTERNAL_SIMD_H
+#define ECLIBC_INTERNAL_SIMD_H 1
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Since different compilers and different platforms implement NULL in a
+ * different manner, EC_NULL is a helping macro to unify the NULL pointer over
+ * all platforms.
+ * E.g. some platforms have __builtin_null (like XC16) and some define it the
+ *      same exact way.
+ */
+#ifndef EC_NULL
+#define EC_NULL ((void *)0)
+#endif
+
+/* All CPP compilers on the other hand, use the same exact NULL pointer on all
+ * platforms. So, there is no need to change the course of standard C++ library.
+ */
+#ifdef __cplusplus
+#undef EC_NULL
+#define EC_NULL NULL
+#endif
+
+/*
+ * A thin layer over the byte-wise vector instructions of the supported
+ * platforms, so the string routines are written only once.
+ *
+ * __EC_SIMD_WIDTH is the number of bytes processed per vector, and the
+ * comparisons are reduced to a bitmask holding one bit per byte, bit 0 being
+ * the byte with the lowest address. __ec_simd_le_u8 compares the bytes as
+ * unsigned values. When none of AVX2, SSE2 or AArch64 NEON is
+ * available, __EC_SIMD_WIDTH is left undefined and the callers fall back to
+ * their scalar code.
+ */
+#if defined(__AVX2__)
+
+#define __EC_SIMD_WIDTH             32
+#define __EC_SIMD_FULL_MASK         0xFFFFFFFFU
+typedef __m256i __ec_simd_t;
+#define __ec_simd_load(_ptr)                                                   \
+        _mm256_loadu_si256((const __m256i *)(const void *)(_ptr))
+#define __ec_simd_splat(_ch)        _mm256_set1_epi8((char)(_ch))
+#define __ec_simd_eq(_a, _b)        _mm256_cmpeq_epi8(_a, _b)
+#define __ec_simd_or(_a, _b)        _mm256_or_si256(_a, _b)
+#define __ec_simd_and(_a, _b)       _mm256_and_si256(_a, _b)
+#define __ec_simd_sub(_a, _b)       _mm256_sub_epi8(_a, _b)
+#define __ec_simd_le_u8(_a, _b)                                                \
+        _mm256_cmpeq_epi8(_mm256_min_epu8(_a, _b), _a)
+#define __ec_simd_mask(_vec)        ((uint32_t)_mm256_movemask_epi8(_vec))
+
+#elif defined(__SSE2__)
+
+#define __EC_SIMD_WIDTH             16
+#define __EC_SIMD_FULL_MASK         0xFFFFU
+typedef __m128i __ec_simd_t;
+#define __ec_simd_load(_ptr)                                                   \
+        _mm_loadu_si128((const __m128i *)(const void *)(_ptr))
+#define __ec_simd_splat(_ch)        _mm_set1_epi8((char)(_ch))
+#define __ec_simd_eq(_a, _b)        _mm_cmpeq_epi8(_a, _b)
+#define __ec_simd_or(_a, _b)        _mm_or_si128(_a, _b)
+#define __ec_simd_and(_a, _b)       _mm_and_si128(_a, _b)
+#define __ec_simd_sub(_a, _b)       _mm_sub_epi8(_a, _b)
+#define __ec_simd_le_u8(_a, _b)     _mm_cmpeq_epi8(_mm_min_epu8(_a, _b), _a)
+#define __ec_simd_mask(_vec)        ((uint32_t)_mm_movemask_epi8(_vec))
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+#define __EC_SIMD_WIDTH             16
+#define __EC_SIMD_FULL_MASK         0xFFFFU
+typedef uint8x16_t __ec_simd_t;
+#define __ec_simd_load(_ptr)        vld1q_u8((const uint8_t *)(_ptr))
+#define __ec_simd_splat(_ch)        vdupq_n_u8((uint8_t)(_ch))
+#define __ec_simd_eq(_a, _b)        vceqq_u8(_a, _b)
+#define __ec_simd_or(_a, _b)        vorrq_u8(_a, _b)
+#define __ec_simd_and(_a, _b)       vandq_u8(_a, _b)
+#define __ec_simd_sub(_a, _b)       vsubq_u8(_a, _b)
+#define __ec_simd_le_u8(_a, _b)     vcleq_u8(_a, _b)
+#define __ec_simd_mask(_vec)        __ec_simd_neon_mask(_vec)
+
+/* NEON has no movemask. Each byte keeps only its own bit weight, then the
+ * two halves are summed up horizontally. */
+static inline uint32_t
+__attribute__ ((unused, always_inline))
+__ec_simd_neon_mask(uint8x16_t vec)
+{
+    static const uint8_t weights[16] =
+            { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    uint8x16_t bits = vandq_u8(vec, vld1q_u8(weights));
+    return (uint32_t)vaddv_u8(vget_low_u8(bits)) |
+           ((uint32_t)vaddv_u8(vget_high_u8(bits)) << 8);
+}
+
+#endif
+
+/*
+ * __ec_simd_hex16 writes the 32 hexadecimal digits of 16 bytes, the high
+ * nibble of each byte first. "digits" holds the 16 digits to use, e.g.
+ * "0123456789abcdef". The nibbles are turned into digits with a byte shuffle
+ * using "digits" as the table where there is one (SSSE3 and NEON). Plain
+ * SSE2 adds the distance between '9' and the letters to the nibbles above 9
+ * instead. __EC_SIMD_HEX16 is left undefined when there is no vector unit.
+ */
+#if defined(__SSE2__)
+
+#define __EC_SIMD_HEX16             1
+
+static inline void
+__attribute__ ((unused, always_inline))
+__ec_simd_hex16(char *dst, const uint8_t *src, const char *digits)
+{
+    __m128i vec  = _mm_loadu_si128((const __m128i *)(const void *)src);
+    __m128i mask = _mm_set1_epi8(0x0F);
+    __m128i high = _mm_and_si128(_mm_srli_epi16(vec, 4), mask);
+    __m128i low  = _mm_and_si128(vec, mask);
+#if defined(__SSSE3__)
+    __m128i table = _mm_loadu_si128((const __m128i *)(const void *)digits);
+    high = _mm_shuffle_epi8(table, high);
+    low  = _mm_shuffle_epi8(table, low);
+#else
+    __m128i zero    = _mm_set1_epi8(digits[0]);
+    __m128i letters = _mm_set1_epi8((char)(digits[10] - digits[0] - 10));
+    __m128i nine    = _mm_set1_epi8(9);
+    high = _mm_add_epi8(_mm_add_epi8(high, zero),
+                    _mm_and_si128(_mm_cmpgt_epi8(high, nine), letters));
+    low  = _mm_add_epi8(_mm_add_epi8(low, zero),
+                    _mm_and_si128(_mm_cmpgt_epi8(low, nine), letters));
+#endif
+    _mm_storeu_si128((__m128i *)(void *)dst, _mm_unpacklo_epi8(high, low));
+    _mm_storeu_si128((__m128i *)(void *)(dst + 16),
+                                                _mm_unpackhi_epi8(high, low));
+}
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+#define __EC_SIMD_HEX16             1
+
+static inline void
+__attribute__ ((unused, always_inline))
+__ec_simd_hex16(char *dst, const uint8_t *src, const char *digits)
+{
+    uint8x16_t  vec   = vld1q_u8(src);
+    uint8x16_t  table = vld1q_u8((const uint8_t *)digits);
+    uint8x16x2_t pair;
+    pair.val[0] = vqtbl1q_u8(table, vshrq_n_u8(vec, 4));
+    pair.val[1] = vqtbl1q_u8(table, vandq_u8(vec, vdupq_n_u8(0x0F)));
+    /* stores the two interleaved */
+    vst2q_u8((uint8_t *)dst, pair);
+}
+
+#endif
+
+/* Index of the lowest set bit. "mask" must not be zero. */
+static inline unsigned
+__attribute__ ((unused, always_inline))
+__ec_simd_first(uint32_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctz(mask);
+#else
+    unsigned index = 0;
+    while((mask & 1U) == 0)
+    {
+        mask >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+/* Index of the highest set bit. "mask" must not be zero. */
+static inline unsigned
+__attribute__ ((unused, always_inline))
+__ec_simd_last(uint32_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 31U - (unsigned)__builtin_clz(mask);
+#else
+    unsigned index = 31;
+    while((mask & 0x80000000UL) == 0)
+    {
+        mask <<= 1;
+        index--;
+    }
+    return index;
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -23,7 +23,7 @@
  **/
 
 #include <string.h>
-#include <ec/io.h>
+#include <ec/strbuf.h>
 #include <ec/arch.h>
 
 #ifndef ECLIBC_INTERNAL_SPAD_STRING_H
@@ -58,58 +58,70 @@ extern "C"
 #pragma GCC diagnostic ignored "-Wsign-conversion"
 #endif
 
-#pragma GCC diagnostic ignored "-Wunused-parameter"
-#pragma GCC diagnostic ignored "-Wunused-variable"
-#include <stdint.h>
+/*
+ * The sprintf family writes through an ec_strbuf, which caches the write
+ * position. Padding is done using a single memset instead of appending the
+ * pad character one by one.
+ * A positive padSize pads on the left (right aligned), a negative one pads on
+ * the right (left aligned).
+ */
+static inline void
+__attribute__ ((unused, always_inline))
+ec_sfpad_string(ec_strbuf *__restrict __s, int padSize, char padChar,
+                const char *__restrict start, const char *__restrict end)
+{
+    size_t len = (size_t)(end - start);
+    if(padSize > 0 && (size_t)padSize > len)
+        ec_strbuf_append_repeat(__s, padChar, (size_t)padSize - len);
+    ec_strbuf_append_n(__s, start, len);
+    if(padSize < 0 && (size_t)(-(long)padSize) > len)
+        ec_strbuf_append_repeat(__s, padChar, (size_t)(-(long)padSize) - len);
+}
+
+/* The same as ec_sfpad_string, for a number with "zeros" more '0' characters
+ * inserted at "split", which are counted in the padding, e.g. the fraction
+ * digits of a "%.100e" beyond the precision the conversion rounds at. */
 static inline void
 __attribute__ ((unused, always_inline))
-ec_sfpad_string(char *__restrict __s, int padSize, char padChar,
-                char *__restrict start, char *__restrict end)
+ec_sfpad_number(ec_strbuf *__restrict __s, int padSize, char padChar,
+                const char *start, const char *split, const char *end,
+                size_t zeros)
 {
-    int rpad = padSize - (int)(start - end);
-    char *__restrict lpad = end - padSize;
-    while(lpad++ < start)
-        strncat(__s, &padChar, 1);
-    strncat(__s, start, (size_t)(end - start));
-    while(rpad++ < 0)
-        strncat(__s, &padChar, 1);
+    size_t len = (size_t)(end - start) + zeros;
+    if(padSize > 0 && (size_t)padSize > len)
+        ec_strbuf_append_repeat(__s, padChar, (size_t)padSize - len);
+    ec_strbuf_append_n(__s, start, (size_t)(split - start));
+    if(zeros != 0)
+        ec_strbuf_append_repeat(__s, '0', zeros);
+    ec_strbuf_append_n(__s, split, (size_t)(end - split));
+    if(padSize < 0 && (size_t)(-(long)padSize) > len)
+        ec_strbuf_append_repeat(__s, padChar, (size_t)(-(long)padSize) - len);
 }
 
+/* Pads based on the display length "len", which may differ from the byte
+ * length of "str", e.g. for UTF8 characters. */
 static inline void
 __attribute__ ((unused, always_inline))
-ec_spad_len_str(char *__restrict __s, int padSize, char padChar,
+ec_spad_len_str(ec_strbuf *__restrict __s, int padSize, char padChar,
                 const char * __restrict str, size_t len)
 {
-    char *__restrict __start;
-    if(padSize > (int)len)
-    {
-        __start = __s + strlen(__s);
-        memset(__start, padChar, (size_t)(padSize - (int)len));
-        __start[(padSize - (int)len)] = '\0';
-    }
-    strcat(__s, str);
-    while(padSize++ < (int)((((int)len) * -1) - 1))
-        strncat(__s, &padChar, 1);
+    if(padSize > 0 && (size_t)padSize > len)
+        ec_strbuf_append_repeat(__s, padChar, (size_t)padSize - len);
+    ec_strbuf_append(__s, str);
+    if(padSize < 0 && (size_t)(-(long)padSize) > len)
+        ec_strbuf_append_repeat(__s, padChar, (size_t)(-(long)padSize) - len);
 }
 
 static inline void
 __attribute__ ((unused, always_inline))
-ec_spad_character(char *__restrict __s, int padSize, char padChar,
+ec_spad_character(ec_strbuf *__restrict __s, int padSize, char padChar,
                                                                 char character)
 {
-    char *__restrict __start = __s + strlen(__s);
     if(padSize > 1)
-    {
-        memset(__start, padChar, (size_t)(padSize - 1));
-        __start[(padSize - 1)] = '\0';
-    }
-    strncat(__s, &character, 1);
-    __start++;
-    if(padSize < -2)
-    {
-        memset(__start, padChar, (size_t)((padSize + 2) * -1));
-        __start[((padSize + 2) * -1)] = '\0';
-    }
+        ec_strbuf_append_repeat(__s, padChar, (size_t)padSize - 1);
+    ec_strbuf_append_char(__s, character);
+    if(padSize < -1)
+        ec_strbuf_append_repeat(__s, padChar, (size_t)(-(long)padSize) - 1);
 }
 
 #if !(defined(XC16) || defined(XC32))
@@ -0,0 +1,123 @@
+/* <atof.h> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+/**
+ * @file atof.h
+ * @brief       the counterpart of ftoa.h. Locale independent string to
+ *              floating point conversion with the correct (round to nearest,
+ *              ties to even) result for every input, so printing a value with
+ *              enough digits and parsing it back gives the same bits.
+ *              Up to 19 significant digits are converted with the
+ *              Eisel-Lemire algorithm, which only needs a 64x128 bit
+ *              multiplication. Longer inputs that Eisel-Lemire can not decide
+ *              fall back to an exact big decimal conversion.
+ */
+
+#include <stddef.h>
+#include <ec/internal/text_parse/atoi.h>
+
+#ifndef ECLIBC_ATOF_H
+#define ECLIBC_ATOF_H 1
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Since different compilers and different platforms implement NULL in a
+ * different manner, EC_NULL is a helping macro to unify the NULL pointer over
+ * all platforms.
+ * E.g. some platforms have __builtin_null (like XC16) and some define it the
+ *      same exact way.
+ */
+#ifndef EC_NULL
+#define EC_NULL ((void *)0)
+#endif
+
+/* All CPP compilers on the other hand, use the same exact NULL pointer on all
+ * platforms. So, there is no need to change the course of standard C++ library.
+ */
+#ifdef __cplusplus
+#undef EC_NULL
+#define EC_NULL NULL
+#endif
+
+/**
+ * @brief ec_parse_double   Parses a floating point number. The accepted
+ *                          syntax is an optional sign followed by either
+ *                          decimal digits with an optional '.' and an
+ *                          optional exponent ("e-12"), "inf", "infinity" or
+ *                          "nan" (case insensitive). White spaces are not
+ *                          skipped.
+ * @param [in]ptr           The string. It doesn't need to be NUL terminated.
+ * @param [in]len           The length of the string.
+ * @param [out]value        The parsed value.
+ * @param [out]end          The pointer past the parsed number. Can be EC_NULL.
+ * @return                  EC_PARSE_OK, EC_PARSE_NO_DIGITS if there is no
+ *                          number, or EC_PARSE_OVERFLOW if the number was too
+ *                          large (value is set to infinity) or too small
+ *                          (value is set to zero).
+ */
+ec_parse_status ec_parse_double(const char *ptr, size_t len, double *value,
+                                const char **end);
+
+/**
+ * @brief ec_parse_float    The same as ec_parse_double, but rounds directly
+ *                          to float. Parsing as double and casting the result
+ *                          can round twice and be off by one unit.
+ * @param [in]ptr           The string. It doesn't need to be NUL terminated.
+ * @param [in]len           The length of the string.
+ * @param [out]value        The parsed value.
+ * @param [out]end          The pointer past the parsed number. Can be EC_NULL.
+ * @return                  The parse status.
+ */
+ec_parse_status ec_parse_float(const char *ptr, size_t len, float *value,
+                               const char **end);
+
+/**
+ * @brief ec_strtod     A locale independent replacement for strtod. Leading
+ *                      white spaces are skipped. Sets errno to ERANGE if the
+ *                      number is out of range. Hexadecimal floating point
+ *                      numbers are not supported.
+ * @param [in]str       The NUL terminated string.
+ * @param [out]end      The pointer past the parsed number, or "str" if
+ *                      there was no number. Can be EC_NULL.
+ * @return              The parsed value, 0 if there was no number.
+ */
+double ec_strtod(const char *str, const char **end);
+
+/**
+ * @brief ec_strtof     The float version of ec_strtod.
+ * @param [in]str       The NUL terminated string.
+ * @param [out]end      The pointer past the parsed number, or "str" if
+ *                      there was no number. Can be EC_NULL.
+ * @return              The parsed value, 0 if there was no number.
+ */
+float ec_strtof(const char *str, const char **end);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,326 @@
+/* <atoi.h> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+/**
+ * @file atoi.h
+ * @brief       the counterpart of itoa.h. atoi and strtol are locale aware,
+ *              scan the string for the white spaces and the sign over and
+ *              over, and silently wrap around or saturate on overflow.
+ *              The parsers here take a length bounded string, never look past
+ *              it, report the overflow, and return the end of the number so
+ *              the caller doesn't need to scan the digits again.
+ *              Decimal digits are converted 8 at a time using SWAR.
+ */
+
+#include <string.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <limits.h>
+
+#ifndef ECLIBC_ATOI_H
+#define ECLIBC_ATOI_H 1
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Since different compilers and different platforms implement NULL in a
+ * different manner, EC_NULL is a helping macro to unify the NULL pointer over
+ * all platforms.
+ * E.g. some platforms have __builtin_null (like XC16) and some define it the
+ *      same exact way.
+ */
+#ifndef EC_NULL
+#define EC_NULL ((void *)0)
+#endif
+
+/* All CPP compilers on the other hand, use the same exact NULL pointer on all
+ * platforms. So, there is no need to change the course of standard C++ library.
+ */
+#ifdef __cplusplus
+#undef EC_NULL
+#define EC_NULL NULL
+#endif
+
+typedef enum
+{
+    EC_PARSE_OK = 0,
+    /* The string doesn't start with a digit. The value is set to 0. */
+    EC_PARSE_NO_DIGITS,
+    /* The number doesn't fit in the type. The value is saturated. */
+    EC_PARSE_OVERFLOW,
+    /* The base is not in the 2 to 36 range. */
+    EC_PARSE_INVALID_BASE
+} ec_parse_status;
+
+/* Loads 8 characters so that the first one lands in the lowest byte. */
+static inline uint64_t
+__attribute__ ((unused, always_inline))
+__ec_parse_load8(const char *ptr)
+{
+    uint64_t chunk;
+    memcpy(&chunk, ptr, sizeof(chunk));
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__)
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    chunk = __builtin_bswap64(chunk);
+#endif
+#endif
+    return chunk;
+}
+
+/* True if all the 8 characters of the chunk are decimal digits. */
+static inline bool
+__attribute__ ((unused, always_inline))
+__ec_parse_is_8_digits(uint64_t chunk)
+{
+    return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) |
+            (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4))
+            == 0x3333333333333333ULL;
+}
+
+/* Converts 8 decimal digits at once: neighbouring digits are merged into
+ * pairs, then the pairs into 4 digit groups and finally into the value. */
+static inline uint32_t
+__attribute__ ((unused, always_inline))
+__ec_parse_8_digits(uint64_t chunk)
+{
+    const uint64_t mask = 0x000000FF000000FFULL;
+    const uint64_t mul1 = 100ULL + (1000000ULL << 32);
+    const uint64_t mul2 = 1ULL + (10000ULL << 32);
+    chunk -= 0x3030303030303030ULL;
+    chunk = (chunk * 10) + (chunk >> 8);
+    chunk = (((chunk & mask) * mul1) + (((chunk >> 16) & mask) * mul2)) >> 32;
+    return (uint32_t)chunk;
+}
+
+/**
+ * @brief __ec_parse_digits     Parses the digits of an unsigned number. Used
+ *                              by the ec_parse_* functions below.
+ * @param [in]ptr               The string.
+ * @param [in]len               The length of the string.
+ * @param [in]base              The base of the number, 2 to 36.
+ * @param [in]limit             The largest acceptable value.
+ * @param [out]value            The parsed value.
+ * @param [out]end              The pointer past the last digit. Can be
+ *                              EC_NULL.
+ * @return                      The parse status.
+ */
+ec_parse_status __ec_parse_digits(const char *ptr, size_t len, unsigned base,
+                                  uint64_t limit, uint64_t *value,
+                                  const char **end);
+
+/**
+ * @brief __ec_parse_decimal_cstr   Reads a short decimal number, like the
+ *                                  width of a format specifier, from a NUL
+ *                                  terminated string in a single pass.
+ *                                  Saturates at INT_MAX.
+ * @param [in]ptr                   The string.
+ * @param [out]value                The parsed value, 0 if there are no digits.
+ * @return                          The pointer past the digits.
+ */
+static inline const char *
+__attribute__ ((unused, always_inline))
+__ec_parse_decimal_cstr(const char *ptr, int *value)
+{
+    unsigned digit;
+    int result = 0;
+    while((digit = (unsigned)(unsigned char)*ptr - '0') < 10)
+    {
+        if(result > (INT_MAX - (int)digit) / 10)
+            result = INT_MAX;
+        else
+            result = result * 10 + (int)digit;
+        ptr++;
+    }
+    *value = result;
+    return ptr;
+}
+
+#define __ec_parse_uint(type, max)                                             \
+    static inline ec_parse_status                                              \
+    __attribute__ ((unused, always_inline))                                    \
+    ec_parse_##type (const char *ptr, size_t len, unsigned base,               \
+                     type *value, const char **end)                            \
+    {                                                                          \
+        const char *start = ptr;                                               \
+        uint64_t magnitude;                                                    \
+        ec_parse_status status;                                                \
+                                                                               \
+        if(len > 0 && *ptr == '+')                                             \
+        {                                                                      \
+            ptr++;                                                             \
+            len--;                                                             \
+        }                                                                      \
+        status = __ec_parse_digits(ptr, len, base, (uint64_t)(max),            \
+                                   &magnitude, end);                           \
+        if(status == EC_PARSE_NO_DIGITS && end != EC_NULL)                     \
+            *end = start;                                                      \
+        *value = (type)magnitude;                                              \
+        return status;                                                         \
+    }
+
+#define __ec_parse_int(type, max)                                              \
+    static inline ec_parse_status                                              \
+    __attribute__ ((unused, always_inline))                                    \
+    ec_parse_##type (const char *ptr, size_t len, unsigned base,               \
+                     type *value, const char **end)                            \
+    {                                                                          \
+        const char *start = ptr;                                               \
+        uint64_t magnitude;                                                    \
+        ec_parse_status status;                                                \
+        bool negative = false;                                                 \
+                                                                               \
+        if(len > 0 && (*ptr == '+' || *ptr == '-'))                            \
+        {                                                                      \
+            negative = (*ptr == '-');                                          \
+            ptr++;                                                             \
+            len--;                                                             \
+        }                                                                      \
+        status = __ec_parse_digits(ptr, len, base,                             \
+                                   (uint64_t)(max) + (negative ? 1U : 0U),     \
+                                   &magnitude, end);                           \
+        if(status == EC_PARSE_NO_DIGITS && end != EC_NULL)                     \
+            *end = start;                                                      \
+        if(negative && magnitude != 0)                                         \
+            *value = (type)(-(type)(magnitude - 1) - 1);                       \
+        else                                                                   \
+            *value = (type)magnitude;                                          \
+        return status;                                                         \
+    }
+
+/**
+ * @brief ec_parse_int      Parses an integer. It is not recomended to use this
+ *                          function, since integer's size is platform
+ *                          dependent, and hence it will render your code
+ *                          unportable between different platforms.
+ *                          An optional '+' or '-' sign is accepted. White
+ *                          spaces and base prefixes (like "0x") are not.
+ * @param [in]ptr           The string. It doesn't need to be NUL terminated.
+ * @param [in]len           The length of the string.
+ * @param [in]base          The base of the number, 2 to 36.
+ * @param [out]value        The parsed value.
+ * @param [out]end          The pointer past the parsed number. Can be EC_NULL.
+ * @return                  The parse status.
+ */
+__ec_parse_int(int, INT_MAX)
+
+/**
+ * @brief ec_parse_int8_t   Parses an 8 bit signed integer.
+ * @param [in]ptr           The string. It doesn't need to be NUL terminated.
+ * @param [in]len           The length of the string.
+ * @param [in]base          The base of the number, 2 to 36.
+ * @param [out]value        The parsed value.
+ * @param [out]end          The pointer past the parsed number. Can be EC_NULL.
+ * @return                  The parse status.
+ */
+__ec_parse_int(int8_t, INT8_MAX)
+
+/**
+ * @brief ec_parse_int16_t  Parses a 16 bit signed integer.
+ * @param [in]ptr           The string. It doesn't need to be NUL terminated.
+ * @param [in]len           The length of the string.
+ * @param [in]base          The base of the number, 2 to 36.
+ * @param [out]value        The parsed value.
+ * @param [out]end          The pointer past the parsed number. Can be EC_NULL.
+ * @return                  The parse status.
+ */
+__ec_parse_int(int16_t, INT16_MAX)
+
+/**
+ * @brief ec_parse_int32_t  Parses a 32 bit signed integer.
+ * @param [in]ptr           The string. It doesn't need to be NUL terminated.
+ * @param [in]len           The length of the string.
+ * @param [in]base          The base of the number, 2 to 36.
+ * @param [out]value        The parsed value.
+ * @param [out]end          The pointer past the parsed number. Can be EC_NULL.
+ * @return                  The parse status.
+ */
+__ec_parse_int(int32_t, INT32_MAX)
+
+/**
+ * @brief ec_parse_int64_t  Parses a 64 bit signed integer.
+ * @param [in]ptr           The string. It doesn't need to be NUL terminated.
+ * @param [in]len           The length of the string.
+ * @param [in]base          The base of the number, 2 to 36.
+ * @param [out]value        The parsed value.
+ * @param [out]end          The pointer past the parsed number. Can be EC_NULL.
+ * @return                  The parse status.
+ */
+__ec_parse_int(int64_t, INT64_MAX)
+
+/**
+ * @brief ec_parse_uint8_t  Parses an 8 bit unsigned integer. An optional '+'
+ *                          sign is accepted.
+ * @param [in]ptr           The string. It doesn't need to be NUL terminated.
+ * @param [in]len           The length of the string.
+ * @param [in]base          The base of the number, 2 to 36.
+ * @param [out]value        The parsed value.
+ * @param [out]end          The pointer past the parsed number. Can be EC_NULL.
+ * @return                  The parse status.
+ */
+__ec_parse_uint(uint8_t, UINT8_MAX)
+
+/**
+ * @brief ec_parse_uint16_t Parses a 16 bit unsigned integer.
+ * @param [in]ptr           The string. It doesn't need to be NUL terminated.
+ * @param [in]len           The length of the string.
+ * @param [in]base          The base of the number, 2 to 36.
+ * @param [out]value        The parsed value.
+ * @param [out]end          The pointer past the parsed number. Can be EC_NULL.
+ * @return                  The parse status.
+ */
+__ec_parse_uint(uint16_t, UINT16_MAX)
+
+/**
+ * @brief ec_parse_uint32_t Parses a 32 bit unsigned integer.
+ * @param [in]ptr           The string. It doesn't need to be NUL terminated.
+ * @param [in]len           The length of the string.
+ * @param [in]base          The base of the number, 2 to 36.
+ * @param [out]value        The parsed value.
+ * @param [out]end          The pointer past the parsed number. Can be EC_NULL.
+ * @return                  The parse status.
+ */
+__ec_parse_uint(uint32_t, UINT32_MAX)
+
+/**
+ * @brief ec_parse_uint64_t Parses a 64 bit unsigned integer.
+ * @param [in]ptr           The string. It doesn't need to be NUL terminated.
+ * @param [in]len           The length of the string.
+ * @param [in]base          The base of the number, 2 to 36.
+ * @param [out]value        The parsed value.
+ * @param [out]end          The pointer past the parsed number. Can be EC_NULL.
+ * @return                  The parse status.
+ */
+__ec_parse_uint(uint64_t, UINT64_MAX)
+
+#undef __ec_parse_int
+#undef __ec_parse_uint
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,4 +1,4 @@
-/* <fota.h> -*- C -*- */
+/* <ftoa.h> -*- C -*- */
 /**
  ** @copyright
  ** This file is part of the "eclibc" project.
@@ -22,13 +22,27 @@
  ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
  **/
 
-#include <math.h>
+/**
+ * @file ftoa.h
+ * @brief       Locale independent floating point to string conversions, the
+ *              counterpart of atof.h. All of them are exact:
+ *              - the shortest forms print the fewest digits that read back
+ *                to the very same value (Ryu, Ulf Adams, PLDI 2018).
+ *              - the fixed, exponential and general forms print the exact
+ *                decimal expansion of the value, rounded at the requested
+ *                precision.
+ *              - the hex form prints the exact binary fraction.
+ *              Like itoa.h, the string is written backward from the END of
+ *              the given buffer and its start is returned. No terminating NUL
+ *              is written.
+ */
+
 #include <stdint.h>
 #include <stdbool.h>
 #include <ec/internal/text_parse/itoa.h>
 
 #ifndef ECLIBC_FTOA_H
-#define ECLIBC_FTOA_H 2
+#define ECLIBC_FTOA_H 1
 
 #ifdef __cplusplus
 extern "C"
@@ -53,98 +67,220 @@ extern "C"
 #define EC_NULL NULL
 #endif
 
-#if (ECLIBC_FTOA_H == 2)
+/* Characters needed by ec_double_to_shortest and ec_float_to_shortest. */
+#define EC_FTOA_SHORTEST_SIZE           32
+
+/* Characters needed by ec_double_to_fixed: the sign, the 309 digits of
+ * DBL_MAX, a carry digit, the decimal point and the fraction. */
+#define EC_FTOA_FIXED_SIZE(precision)   (312 + (precision))
+
+/* Characters needed by ec_double_to_exponential and ec_double_to_general: the
+ * sign, the first digit, the decimal point, the fraction and "e-308". */
+#define EC_FTOA_EXPONENTIAL_SIZE(precision) (8 + (precision))
+
+/* Characters needed by ec_double_to_hex: "-0x1.", at least 13 hex digits and
+ * "p-1022". */
+#define EC_FTOA_HEX_SIZE(precision)     (24 + (precision))
+
+/* The largest precision the printf family rounds at. The fraction digits
+ * asked beyond it are printed as zeros, which is exact for every value with
+ * no more than this many fraction digits in its expansion. */
+#define EC_FTOA_MAX_PRECISION           64
 
 /**
- * @brief ___ec_itoa_uint64_mod the same as the standard itoa_uint64 function
- *        but this one drops the last digit, as we add an astray 1 to the
- *        floating point part in order to ensure we always end up with the
- *        requested number of digits.
- * @param value
- * @param buflim
- * @param base
- * @param upper_case
- * @return
+ * @brief The rounding applied by ec_double_to_fixed to the dropped digits.
  */
-static inline char *
-__attribute__ ((unused, always_inline))
-___ec_itoa_uint64_mod (uint64_t value, char *__restrict buflim,
-                    uint64_t base, bool upper_case)
+typedef enum
 {
-    extern const char __ec_upper_digits[];
-    extern const char __ec_lower_digits[];
-    const char *digits = ((upper_case == true)
-                          ? __ec_upper_digits :
-                            __ec_lower_digits);
+    ec_ftoa_round_nearest   = 0, /* to nearest, ties to even, as printf does  */
+    ec_ftoa_round_half_up   = 1, /* to nearest, ties away from zero           */
+    ec_ftoa_round_truncate  = 2, /* toward zero                               */
+    ec_ftoa_round_ceiling   = 3, /* toward +infinity                          */
+    ec_ftoa_round_floor     = 4  /* toward -infinity                          */
+} ec_ftoa_rounding;
 
-    do
-        *--buflim = digits[value % base];
-    while ((value /= base) >= 10);
+/**
+ * @brief A floating point value as mantissa * 10^exponent.
+ */
+typedef struct
+{
+    uint64_t mantissa;
+    int32_t  exponent;
+    bool     negative;
+} ec_ftoa_decimal;
 
-    return buflim;
-}
+/**
+ * @brief ec_double_to_decimal     The shortest decimal that reads back as the
+ *                                 given value. Of several shortest ones, the
+ *                                 closest is picked.
+ * @param [in]value     The value, which must be finite.
+ * @return              The decimal, with no trailing zeros in the mantissa.
+ */
+ec_ftoa_decimal ec_double_to_decimal(double value);
 
 /**
- * @brief ___ec_break_double    breaks a double value into it's sub-parts.
- * @param [in]value             the double value to be separated.
- * @param [out]intpart          the integer part of the double value.
- * @param [in/out]decpart       [in]the number of decimal digits requested.
- *                              [out]the decimal part of the double value.
+ * @brief ec_float_to_decimal      The same as ec_double_to_decimal, for the
+ *                                 precision of a float, e.g. 0.1f is 1e-1
+ *                                 instead of 1.00000001490116e-1.
+ * @param [in]value     The value, which must be finite.
+ * @return              The decimal, with no trailing zeros in the mantissa.
  */
-static inline void
-__attribute__ ((unused, always_inline))
-___ec_break_double(double value, int64_t *intpart, uint64_t *decpart)
-{
-    *intpart = (int64_t)value;
-    double temp = (double)(value - (double)(*intpart));
-    *decpart = (uint64_t)((((temp < 0) ? (temp * -1) : temp) + 1) *
-                                                    pow(10, (double)*decpart));
-}
+ec_ftoa_decimal ec_float_to_decimal(float value);
 
 /**
- * @brief ec_ftoa       Converts a double value to a string.
+ * @brief ec_double_to_shortest    Converts a double to the shortest string
+ *                                 that reads back as the same value. Values
+ *                                 from 1e-6 to below 1e21 are written in
+ *                                 positional notation, e.g. "0.1", "42" or
+ *                                 "-1234.5", and the rest in exponential
+ *                                 notation, e.g. "1e+21" or "2.5e-7". Infinity
+ *                                 and NaN are written as "inf" and "nan".
  * @param [in]value     The value to be converted to string.
  * @param [in]buflim    The pointer to the END of the string to be used for the
- *                      conversion.
- * @param [in]dec       Number of decimal places to be generated.
+ *                      conversion, with EC_FTOA_SHORTEST_SIZE characters
+ *                      before it.
+ * @param [in]upper_case    if true, "E", "INF" and "NAN" are used.
  * @return              The pointer to the start of the generated string.
  */
-static inline char *
-__attribute__ ((unused, always_inline))
-ec_ftoa(double value, char *__restrict buflim, int dec)
-{
-    int64_t intpart;
-    uint64_t decpart = (uint64_t)dec;
-    ___ec_break_double(value, &intpart, &decpart);
-    buflim = ___ec_itoa_uint64_mod(decpart, buflim, 10, 1);
-    *--buflim = '.';
-    return ec_itoa_int64_t(intpart, buflim, 10, 1);
-}
-#endif
+char *ec_double_to_shortest(double value, char *__restrict buflim,
+                            bool upper_case);
 
-#if (ECLIBC_FTOA_H == 1)
 /**
- * @brief ec_ecvt_break     breaks a double value into it's sub-parts.
- * @param [in]value         the double value to be separated.
- * @param [out]intpart      the integer part of the double value.
- * @param [in/out]decpart   [in]the number of decimal digits requested.
- *                          [out]the decimal part of the double value.
+ * @brief ec_float_to_shortest     The same as ec_double_to_shortest, for the
+ *                                 precision of a float.
+ * @param [in]value     The value to be converted to string.
+ * @param [in]buflim    The pointer to the END of the string to be used for the
+ *                      conversion, with EC_FTOA_SHORTEST_SIZE characters
+ *                      before it.
+ * @param [in]upper_case    if true, "E", "INF" and "NAN" are used.
+ * @return              The pointer to the start of the generated string.
  */
-static inline void
+char *ec_float_to_shortest(float value, char *__restrict buflim,
+                           bool upper_case);
+
+/**
+ * @brief ec_double_to_fixed       Converts a double to a string with the given
+ *                                 number of fraction digits, the same as
+ *                                 "%.<precision>f". The digits are those of
+ *                                 the exact value of the double, e.g. 0.125
+ *                                 is "0.12" at a precision of 2 when rounding
+ *                                 to nearest, and 1e23 is
+ *                                 "99999999999999991611392".
+ * @param [in]value     The value to be converted to string.
+ * @param [in]buflim    The pointer to the END of the string to be used for the
+ *                      conversion, with EC_FTOA_FIXED_SIZE(precision)
+ *                      characters before it.
+ * @param [in]precision Number of the fraction digits. Zero drops the decimal
+ *                      point.
+ * @param [in]rounding  How the dropped digits are rounded.
+ * @return              The pointer to the start of the generated string.
+ */
+char *ec_double_to_fixed(double value, char *__restrict buflim, int precision,
+                         ec_ftoa_rounding rounding);
+
+/**
+ * @brief ec_double_to_exponential Converts a double to a string in exponential
+ *                                 notation, the same as "%.<precision>e",
+ *                                 e.g. "1.250000e+02". The exponent has two
+ *                                 digits at least.
+ * @param [in]value     The value to be converted to string.
+ * @param [in]buflim    The pointer to the END of the string to be used for the
+ *                      conversion, with EC_FTOA_EXPONENTIAL_SIZE(precision)
+ *                      characters before it.
+ * @param [in]precision Number of the digits after the decimal point. Zero
+ *                      drops the decimal point.
+ * @param [in]upper_case    if true, "E", "INF" and "NAN" are used.
+ * @param [in]rounding  How the dropped digits are rounded.
+ * @return              The pointer to the start of the generated string.
+ */
+char *ec_double_to_exponential(double value, char *__restrict buflim,
+                               int precision, bool upper_case,
+                               ec_ftoa_rounding rounding);
+
+/**
+ * @brief ec_double_to_general     Converts a double to a string the same as
+ *                                 "%.<precision>g": rounded to "precision"
+ *                                 significant digits, without the trailing
+ *                                 zeros, in exponential notation only when
+ *                                 the exponent is below -4 or not below the
+ *                                 precision.
+ * @param [in]value     The value to be converted to string.
+ * @param [in]buflim    The pointer to the END of the string to be used for the
+ *                      conversion, with EC_FTOA_EXPONENTIAL_SIZE(precision)
+ *                      characters before it.
+ * @param [in]precision Number of the significant digits, 0 is taken as 1.
+ * @param [in]upper_case    if true, "E", "INF" and "NAN" are used.
+ * @return              The pointer to the start of the generated string.
+ */
+char *ec_double_to_general(double value, char *__restrict buflim,
+                           int precision, bool upper_case);
+
+/**
+ * @brief ec_double_to_hex         Converts a double to a string the same as
+ *                                 "%.<precision>a", e.g. "0x1.8p+1" for 3.
+ * @param [in]value     The value to be converted to string.
+ * @param [in]buflim    The pointer to the END of the string to be used for the
+ *                      conversion, with EC_FTOA_HEX_SIZE(precision) characters
+ *                      before it.
+ * @param [in]precision Number of the hex digits after the point, a negative
+ *                      one writes all of them but the trailing zeros.
+ * @param [in]upper_case    if true, "0X", "P" and the upper case hex digits
+ *                          are used.
+ * @return              The pointer to the start of the generated string.
+ */
+char *ec_double_to_hex(double value, char *__restrict buflim, int precision,
+                       bool upper_case);
+
+/**
+ * @brief ec_double_to_printf      Converts a double the way the printf
+ *                                 conversion "%<conversion>" does, for one of
+ *                                 e E f F g G a A, rounding to the nearest.
+ * @param [in]value     The value to be converted to string.
+ * @param [in]buflim    The pointer to the END of the string to be used for the
+ *                      conversion, with EC_FTOA_FIXED_SIZE(precision)
+ *                      characters before it.
+ * @param [in]precision The precision of the conversion, negative when none
+ *                      was given.
+ * @param [in]conversion    The conversion character.
+ * @return              The pointer to the start of the generated string.
+ */
+char *ec_double_to_printf(double value, char *__restrict buflim,
+                          int precision, char conversion);
+
+/**
+ * @brief ec_ftoa_fraction_end     Where the fraction of a string written by
+ *                                 ec_double_to_printf ends: before the
+ *                                 exponent of "%e" and "%a", at the end of
+ *                                 "%f". This is where the zeros of a precision
+ *                                 beyond EC_FTOA_MAX_PRECISION go.
+ * @param [in]start     The start of the string.
+ * @param [in]end       The end of the string.
+ * @param [in]conversion    The conversion character.
+ * @return              The end of the fraction, or EC_NULL when no zeros are
+ *                      to be added (%g, inf and nan).
+ */
+static inline char *
 __attribute__ ((unused, always_inline))
-ec_break_double(double value, int64_t *intpart, uint64_t *decpart)
+ec_ftoa_fraction_end(char *start, char *end, char conversion)
 {
-    *intpart = (int64_t)value;
-    double temp = (double)(value - (double)(*intpart));
-    *decpart = (uint64_t)(((temp < 0) ? (temp * -1) : temp) *
-                                                    pow(10, (double)*decpart));
+    if(conversion == 'g' || conversion == 'G' || end == start ||
+       end[-1] < '0' || end[-1] > '9')
+        return (char *)EC_NULL;
+    if(conversion == 'f' || conversion == 'F')
+        return end;
+    while(end[-1] != 'e' && end[-1] != 'E' &&
+          end[-1] != 'p' && end[-1] != 'P')
+        end--;
+    return end - 1;
 }
 
 /**
- * @brief ec_ftoa       Converts a double value to a string.
+ * @brief ec_ftoa       Converts a double value to a string, rounding to the
+ *                      nearest.
  * @param [in]value     The value to be converted to string.
  * @param [in]buflim    The pointer to the END of the string to be used for the
- *                      conversion.
+ *                      conversion, with EC_FTOA_FIXED_SIZE(dec) characters
+ *                      before it.
  * @param [in]dec       Number of decimal places to be generated.
  * @return              The pointer to the start of the generated string.
  */
@@ -152,14 +288,8 @@ static inline char *
 __attribute__ ((unused, always_inline))
 ec_ftoa(double value, char *__restrict buflim, int dec)
 {
-    int64_t intpart;
-    uint64_t decpart = (uint64_t)dec;
-    ec_break_double(value, &intpart, &decpart);
-    buflim = ec_itoa_uint64_t(decpart, buflim, 10, 1);
-    *--buflim = '.';
-    return ec_itoa_int64_t(intpart, buflim, 10, 1);
+    return ec_double_to_fixed(value, buflim, dec, ec_ftoa_round_nearest);
 }
-#endif
 
 #ifdef __cplusplus
 }
@@ -61,11 +61,156 @@ extern "C"
 #endif
 
 
+/* "00" to "99", used to convert two decimal digits per step. */
+extern const char __ec_digit_pairs[200];
+
+/* "00" to "ff" and "00" to "FF", used to convert a byte per step. */
+extern const char __ec_lower_hex_pairs[512];
+extern const char __ec_upper_hex_pairs[512];
+
+/* 10^0 to 10^19, the decimal digit boundaries of a 64 bit integer. */
+extern const uint64_t __ec_pow10_u64[20];
+
+extern const char __ec_upper_digits[];
+extern const char __ec_lower_digits[];
+
 /**
- * @brief ec_itoa       Converts an unsigned long int to a string. It is not
- *                      recomended to use this function, since integer's size
- *                      is platform dependent, and hence it will render your
- *                      code unportable between different platforms.
+ * @brief __ec_utoa10_u64_wide     Writes the decimal digits of a value that
+ *                                 does not fit in 32 bits backward from end.
+ *                                 Uses SSE2 to produce 8 or 16 digits at once
+ *                                 where available.
+ * @param [in]value     The value to be converted, at least 2^32.
+ * @param [in]end       The pointer to the END of the digits.
+ * @param [in]count     The number of digits of the value.
+ */
+void __ec_utoa10_u64_wide(uint64_t value, char *__restrict end, unsigned count);
+
+/**
+ * @brief ec_count_digits_u64      Counts the decimal digits of a value
+ *                                 without dividing it.
+ * @param [in]value     The value to be measured.
+ * @return              The number of decimal digits, 1 for zero.
+ */
+static inline unsigned
+__attribute__ ((unused, always_inline))
+ec_count_digits_u64 (uint64_t value)
+{
+#if defined(__GNUC__)
+    /* log10(2) ~= 1233/4096, so this lands on the digit count or one below. */
+    unsigned bits = 64U - (unsigned)__builtin_clzll(value | 1U);
+    unsigned count = (bits * 1233U) >> 12;
+    return count + ((value | 1U) >= __ec_pow10_u64[count]);
+#else
+    unsigned count = 1;
+    while(count < 20 && value >= __ec_pow10_u64[count])
+        count++;
+    return count;
+#endif
+}
+
+/**
+ * @brief __ec_utoa10_fill_u32     Writes the decimal digits of value backward
+ *                                 from end, two digits per step.
+ * @param [in]value     The value to be converted.
+ * @param [in]end       The pointer to the END of the digits.
+ * @return              The pointer to the first digit.
+ */
+static inline char *
+__attribute__ ((unused, always_inline))
+__ec_utoa10_fill_u32 (uint32_t value, char *__restrict end)
+{
+    while(value >= 100)
+    {
+        uint32_t pair = (value % 100) * 2;
+        value /= 100;
+        *--end = __ec_digit_pairs[pair + 1];
+        *--end = __ec_digit_pairs[pair];
+    }
+
+    if(value >= 10)
+    {
+        *--end = __ec_digit_pairs[value * 2 + 1];
+        *--end = __ec_digit_pairs[value * 2];
+    }
+    else
+        *--end = (char)('0' + value);
+
+    return end;
+}
+
+/**
+ * @brief __ec_utoa10_u64          Writes the decimal digits of value backward
+ *                                 from end.
+ * @param [in]value     The value to be converted.
+ * @param [in]end       The pointer to the END of the digits.
+ * @return              The pointer to the first digit.
+ */
+static inline char *
+__attribute__ ((unused, always_inline))
+__ec_utoa10_u64 (uint64_t value, char *__restrict end)
+{
+    if(value <= UINT32_MAX)
+        return __ec_utoa10_fill_u32((uint32_t)value, end);
+
+    unsigned count = ec_count_digits_u64(value);
+    __ec_utoa10_u64_wide(value, end, count);
+    return end - count;
+}
+
+/**
+ * @brief __ec_utoa_pow2           Writes the digits of value in a power of two
+ *                                 base backward from end, using shifts and
+ *                                 masks instead of divisions.
+ * @param [in]value     The value to be converted.
+ * @param [in]end       The pointer to the END of the digits.
+ * @param [in]shift     log2 of the base: 1, 3 or 4.
+ * @param [in]upper_case    if true, uppercase letters will be used.
+ * @return              The pointer to the first digit.
+ */
+static inline char *
+__attribute__ ((unused, always_inline))
+__ec_utoa_pow2 (uint64_t value, char *__restrict end, unsigned shift,
+                bool upper_case)
+{
+    const uint64_t mask = (1U << shift) - 1U;
+    const char *digits = ((upper_case == true)
+                          ? __ec_upper_digits : __ec_lower_digits);
+
+    if(shift == 4)
+    {
+        /* A byte is exactly two hex digits, so take them from a pair table. */
+        const char *pairs = ((upper_case == true)
+                             ? __ec_upper_hex_pairs : __ec_lower_hex_pairs);
+        while(value > 0xFF)
+        {
+            unsigned pair = (unsigned)(value & 0xFF) * 2U;
+            value >>= 8;
+            *--end = pairs[pair + 1];
+            *--end = pairs[pair];
+        }
+
+        if(value > 0xF)
+        {
+            *--end = pairs[value * 2 + 1];
+            *--end = pairs[value * 2];
+        }
+        else
+            *--end = digits[value];
+
+        return end;
+    }
+
+    do
+        *--end = digits[value & mask];
+    while((value >>= shift) != 0);
+    return end;
+}
+
+/**
+ * @brief __ec_utoa_u32            Converts a 32 bit unsigned value, picking
+ *                                 the specialized converter of the base. Once
+ *                                 inlined with a constant base, only that
+ *                                 converter remains.
  * @param [in]value     The value to be converted to string.
  * @param [in]buflim    The pointer to the END of the string to be used for the
  *                      conversion.
@@ -75,11 +220,60 @@ extern "C"
  */
 static inline char *
 __attribute__ ((unused, always_inline))
-ec_itoa (unsigned long int value, char *__restrict buflim,
-          unsigned int base, bool upper_case)
+__ec_utoa_u32 (uint32_t value, char *__restrict buflim, unsigned base,
+               bool upper_case)
 {
-    extern const char __ec_upper_digits[];
-    extern const char __ec_lower_digits[];
+    switch(base)
+    {
+        case 10:
+            return __ec_utoa10_fill_u32(value, buflim);
+        case 16:
+            return __ec_utoa_pow2(value, buflim, 4, upper_case);
+        case 8:
+            return __ec_utoa_pow2(value, buflim, 3, upper_case);
+        case 2:
+            return __ec_utoa_pow2(value, buflim, 1, upper_case);
+        default:
+            break;
+    }
+
+    const char *digits = ((upper_case == true)
+                          ? __ec_upper_digits : __ec_lower_digits);
+    do
+        *--buflim = digits[value % base];
+    while ((value /= base) != 0);
+    return buflim;
+}
+
+/**
+ * @brief __ec_utoa_u64            Converts a 64 bit unsigned value, picking
+ *                                 the specialized converter of the base.
+ * @param [in]value     The value to be converted to string.
+ * @param [in]buflim    The pointer to the END of the string to be used for the
+ *                      conversion.
+ * @param [in]base      The base of the number to be used for the conversion.
+ * @param [in]upper_case    if true, uppercase letters will be used.
+ * @return              The pointer to the start of the generated string.
+ */
+static inline char *
+__attribute__ ((unused, always_inline))
+__ec_utoa_u64 (uint64_t value, char *__restrict buflim, unsigned base,
+               bool upper_case)
+{
+    switch(base)
+    {
+        case 10:
+            return __ec_utoa10_u64(value, buflim);
+        case 16:
+            return __ec_utoa_pow2(value, buflim, 4, upper_case);
+        case 8:
+            return __ec_utoa_pow2(value, buflim, 3, upper_case);
+        case 2:
+            return __ec_utoa_pow2(value, buflim, 1, upper_case);
+        default:
+            break;
+    }
+
     const char *digits = ((upper_case == true)
                           ? __ec_upper_digits : __ec_lower_digits);
     do
@@ -88,35 +282,81 @@ ec_itoa (unsigned long int value, char *__restrict buflim,
     return buflim;
 }
 
+/**
+ * @brief ec_utoa10     Writes the decimal digits of value forward into dst.
+ *                      The digit count is computed first, so the digits land
+ *                      in place and nothing is reversed or moved afterwards.
+ *                      dst must have room for 20 characters; no terminating
+ *                      NUL is written.
+ * @param [in]value     The value to be converted.
+ * @param [out]dst      The destination of the digits.
+ * @return              The number of digits written.
+ */
+static inline unsigned
+__attribute__ ((unused, always_inline))
+ec_utoa10 (uint64_t value, char *__restrict dst)
+{
+    unsigned count = ec_count_digits_u64(value);
+    if(value <= UINT32_MAX)
+        __ec_utoa10_fill_u32((uint32_t)value, dst + count);
+    else
+        __ec_utoa10_u64_wide(value, dst + count, count);
+    return count;
+}
+
+/**
+ * @brief ec_itoa       Converts an unsigned long int to a string. It is not
+ *                      recomended to use this function, since integer's size
+ *                      is platform dependent, and hence it will render your
+ *                      code unportable between different platforms.
+ * @param [in]value     The value to be converted to string.
+ * @param [in]buflim    The pointer to the END of the string to be used for the
+ *                      conversion.
+ * @param [in]base      The base of the number to be used for the conversion.
+ * @param [in]upper_case    if true, uppercase letters will be used.
+ * @return              The pointer to the start of the generated string.
+ */
+static inline char *
+__attribute__ ((unused, always_inline))
+ec_itoa (unsigned long int value, char *__restrict buflim,
+          unsigned int base, bool upper_case)
+{
+    if(sizeof(value) <= sizeof(uint32_t))
+        return __ec_utoa_u32((uint32_t)value, buflim, base, upper_case);
+    return __ec_utoa_u64((uint64_t)value, buflim, base, upper_case);
+}
+
+/* Negative values are written as '-' and the magnitude in base 10, and as the
+ * two's complement bit pattern of the type's width in every other base. */
 #define __ec_itoa(type)                                                        \
     static inline char *                                                       \
     __attribute__ ((unused, always_inline))                                    \
     ec_itoa_##type (type value, char *__restrict buflim,                       \
                       type base, bool upper_case)                              \
     {                                                                          \
-        extern const char __ec_upper_digits[];                                 \
-        extern const char __ec_lower_digits[];                                 \
-        const char *digits = ((upper_case == true)                             \
-                              ? __ec_upper_digits :                            \
-                                __ec_lower_digits);                            \
-        uint8_t sign = 0;                                                      \
-                                                                               \
-        if(value < 0 && base == 10)                                            \
+        if(sizeof(type) <= sizeof(uint32_t))                                   \
         {                                                                      \
-            value = (type)(value * -1);                                        \
-            sign = 1;                                                          \
+            uint32_t magnitude = (uint32_t)value;                              \
+            if(value < 0 && base == 10)                                        \
+            {                                                                  \
+                buflim = __ec_utoa10_fill_u32(0U - magnitude, buflim);         \
+                *--buflim = '-';                                               \
+                return buflim;                                                 \
+            }                                                                  \
+            magnitude &= (uint32_t)((UINT64_C(1) <<                            \
+                                     ((8U * sizeof(type)) & 63U)) - 1U);       \
+            return __ec_utoa_u32(magnitude, buflim, (unsigned)base,            \
+                                 upper_case);                                  \
         }                                                                      \
                                                                                \
-        do                                                                     \
+        uint64_t magnitude = (uint64_t)value;                                  \
+        if(value < 0 && base == 10)                                            \
         {                                                                      \
-            *--buflim = digits[(uint8_t)(value % base)];                       \
-            value = (type)(value /base);                                       \
-        } while (value != 0);                                                  \
-                                                                               \
-        if(sign == 1)                                                          \
+            buflim = __ec_utoa10_u64(0U - magnitude, buflim);                  \
             *--buflim = '-';                                                   \
-                                                                               \
-        return buflim;                                                         \
+            return buflim;                                                     \
+        }                                                                      \
+        return __ec_utoa_u64(magnitude, buflim, (unsigned)base, upper_case);   \
     }
 
 #define __ec_uitoa(type)                                                       \
@@ -125,17 +365,11 @@ ec_itoa (unsigned long int value, char *__restrict buflim,
     ec_itoa_##type (type value, char *__restrict buflim,                       \
                       type base, bool upper_case)                              \
     {                                                                          \
-        extern const char __ec_upper_digits[];                                 \
-        extern const char __ec_lower_digits[];                                 \
-        const char *digits = ((upper_case == true)                             \
-                              ? __ec_upper_digits :                            \
-                                __ec_lower_digits);                            \
-                                                                               \
-        do                                                                     \
-            *--buflim = digits[value % base];                                  \
-        while ((value /= base) != 0);                                          \
-                                                                               \
-        return buflim;                                                         \
+        if(sizeof(type) <= sizeof(uint32_t))                                   \
+            return __ec_utoa_u32((uint32_t)value, buflim, (unsigned)base,      \
+                                 upper_case);                                  \
+        return __ec_utoa_u64((uint64_t)value, buflim, (unsigned)base,          \
+                             upper_case);                                      \
     }
 
 /**
@@ -27,6 +27,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <ec/internal/text_parse/atoi.h>
 
 #ifndef ECLIBC_INTERNAL_PRINTF_FORMAT_H
 #define ECLIBC_INTERNAL_PRINTF_FORMAT_H 1
@@ -73,10 +74,12 @@ typedef struct
                                      */
 } __ec_printf_args;
 
+/* Parses a single specifier, starting at its '%'. The widths given as '*'
+ * are read from the arguments later, by __ec_printf_resolve_star. */
 static inline const char *
 __attribute__ ((hot,unused,always_inline))
-__ec_printf_extract_format (const char *__restrict start,
-                     __ec_printf_args  *__restrict args, va_list __arg)
+__ec_printf_parse_format (const char *__restrict start,
+                     __ec_printf_args  *__restrict args)
 {
     memset(args, 0, sizeof(__ec_printf_args));
     args->side = 0;
@@ -122,13 +125,20 @@ __ec_printf_extract_format (const char *__restrict start,
     ____ec_signs_temp_switch();
     ____ec_signs_temp_switch();
     #undef ____ec_signs_temp_switch
-    if(args->side == 0)
-        args->NumberLeft = atoi(start) * ((args->NumNegative & 1) ? -1 : 1);
-    else
-        args->NumberRight = atoi(start) * ((args->NumNegative & 2) ? -1 : 1);
     if(isdigit((unsigned char)(*start)))
         args->NumSeen = (unsigned)(args->NumSeen | (1 << args->side)) & 3;
-    start += strspn(start, "0123456789");
+    if(args->side == 0)
+    {
+        start = __ec_parse_decimal_cstr(start, &args->NumberLeft);
+        if(args->NumNegative & 1)
+            args->NumberLeft = -args->NumberLeft;
+    }
+    else
+    {
+        start = __ec_parse_decimal_cstr(start, &args->NumberRight);
+        if(args->NumNegative & 2)
+            args->NumberRight = -args->NumberRight;
+    }
     if(args->side == 0 && *start == '.')
     {
         args->side = 1;
@@ -167,11 +177,33 @@ __ec_printf_extract_format (const char *__restrict start,
             break;
         }
     }
+    args->format_chr = *start;
+    /* A format ending in the middle of a specifier must not be read past its
+     * terminator. */
+    if(*start != '\0')
+        start++;
+    return start;
+}
+
+static inline void
+__attribute__ ((hot,unused,always_inline))
+__ec_printf_resolve_star (__ec_printf_args *__restrict args, va_list *__arg)
+{
     if(args->Star & 1)
-        args->NumberLeft = va_arg(__arg, int);
+        args->NumberLeft = va_arg(*__arg, int);
     if(args->Star & 2)
-        args->NumberLeft = va_arg(__arg, int);
-    args->format_chr = *start++;
+        args->NumberRight = va_arg(*__arg, int);
+    args->NumSeen = (unsigned)(args->NumSeen | args->Star) & 3;
+}
+
+static inline const char *
+__attribute__ ((hot,unused,always_inline))
+__ec_printf_extract_format (const char *__restrict start,
+                     __ec_printf_args  *__restrict args, va_list *__arg)
+{
+    start = __ec_printf_parse_format(start, args);
+    if(args->Star != 0)
+        __ec_printf_resolve_star(args, __arg);
     return start;
 }
 
@@ -23,8 +23,9 @@
  **/
 
 #include <string.h>
-#include <ec/io.h>
-#include <ec/arch.h>
+#include <stdint.h>
+#include <ec/strbuf.h>
+#include <ec/url.h>
 
 #ifndef ECLIBC_INTERNAL_URLPAD_STRING_H
 #define ECLIBC_INTERNAL_URLPAD_STRING_H 1
@@ -58,61 +59,23 @@ extern "C"
 #pragma GCC diagnostic ignored "-Wsign-conversion"
 #endif
 
-#pragma GCC diagnostic ignored "-Wunused-parameter"
-#pragma GCC diagnostic ignored "-Wunused-variable"
-#include <stdint.h>
-
+/* Appends the characters percent-encoded, see EC_URL_COMPONENT. */
 static inline void
 __attribute__ ((unused, always_inline))
-url_encode_chr(char source, char *destination)
+ec_urlpad_string(ec_strbuf *__restrict __s,
+                 const char *__restrict start, const char *__restrict end)
 {
-    uint8_t ptr = (uint8_t)source;
-    const char *temp = "0123456789ABCDEF";
-    destination = destination + strlen(destination);
-    if((ptr >= 'a' && ptr <= 'z') ||
-       (ptr >= 'A' && ptr <= 'Z') ||
-       (ptr >= '0' && ptr <= '9'))
-    {
-        *destination++ = (char)ptr;
-    }
-    else
-    {
-        *destination++ = '%';
-        *destination++ = temp[ptr / 0x10];
-        *destination++ = temp[ptr % 0x10];
-    }
-    *destination = '\0';
+    ec_strbuf_append_url_encoded(__s, start, (size_t)(end - start),
+                                                            EC_URL_COMPONENT);
 }
 
 static inline void
 __attribute__ ((unused, always_inline))
-url_encode(const char *__restrict source, char *destination)
+ec_urlpad_character(ec_strbuf *__restrict __s, char chr)
 {
-    const uint8_t *ptr = (const uint8_t *)source;
-    const char *temp = "0123456789ABCDEF";
-    destination = destination + strlen(destination);
-    while(*ptr != '\0')
-    {
-        if((*ptr >= 'a' && *ptr <= 'z') ||
-           (*ptr >= 'A' && *ptr <= 'Z') ||
-           (*ptr >= '0' && *ptr <= '9'))
-        {
-            *destination++ = (char)*ptr++;
-        }
-        else
-        {
-            *destination++ = '%';
-            *destination++ = temp[*ptr   / 0x10];
-            *destination++ = temp[*ptr++ % 0x10];
-        }
-    }
-    *destination = '\0';
+    ec_urlpad_string(__s, &chr, &chr + 1);
 }
 
-#define ec_urlfpad_string(__s, str)   url_encode(str, __s)
-#define ec_urlpad_len_str(__s, str)   url_encode(str, __s)
-#define ec_urlpad_character(__s, chr) url_encode_chr(chr, __s)
-
 #if !(defined(XC16) || defined(XC32))
 #pragma GCC diagnostic pop
 #endif
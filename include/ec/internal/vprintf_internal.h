@@ -27,6 +27,8 @@
 
 #include <ec/preprocessor.h>
 #include <ec/internal/printf_fix_optimizer.h>
+#include <ec/internal/printf_compile.h>
+#include <ec/internal/printf_perform.h>
 
 #ifndef ECLIBC_INTERNAL_VPRINTF_INTERNAL_H
 #define ECLIBC_INTERNAL_VPRINTF_INTERNAL_H 1
@@ -54,6 +56,12 @@ extern "C"
 #define EC_NULL NULL
 #endif
 
+/* Size of the stack buffer ec_vfprintf formats into before writing to the
+ * stream. Longer outputs are written in chunks of this size. */
+#ifndef EC_VFPRINTF_BUFFER_SIZE
+#define EC_VFPRINTF_BUFFER_SIZE                 512
+#endif
+
 #define __ec_printf_impl(n, ...) __ec_printf_func__ ## n(__VA_ARGS__)
 #define __ec_printf(n, ...) __ec_printf_impl(n, __VA_ARGS__)
 #define ec_printf(...) __ec_printf(__EC_VA_NARGS__(__VA_ARGS__), __VA_ARGS__)
@@ -81,9 +89,11 @@ ec_fprintf(FILE *__restrict __stream, const char *__restrict __format);
 
 #define __ec_fprintf_func__2(__stream, __format)       fputs(__format, __stream)
 
+/* ec_fprintf with arguments, see __ec_fprintf_func__3 below. */
 __attribute__((hot,noinline))
 void
-ec_fprintf(FILE *__restrict __stream, const char *__restrict __format, ...);
+__ec_fprintf_uncached(FILE *__restrict __stream,
+                                        const char *__restrict __format, ...);
 
 __attribute__((hot,noinline))
 void
@@ -97,9 +107,144 @@ ec_printf(const char *__restrict __format);
 
 #define __ec_printf_func__1(__format)                    fputs(__format, stdout)
 
+/* ec_printf with arguments, see __ec_printf_func__2 below. */
+__attribute__((hot,noinline))
+void
+__ec_printf_uncached(const char *__restrict __format, ...);
+
+/*
+ * The unlocked family does not lock the stream. Use it where the stream is
+ * only ever used by a single thread, or where the caller already holds the
+ * lock using flockfile. The output of each call is still written to the
+ * stream in as few fwrite calls as possible.
+ */
+#define ec_vfprintf_unlocked(__stream, __format, __arg)                        \
+      __ec_vfprintf_unlocked(__stream, __format, __arg)
+
+#define ec_vprintf_unlocked(__format, __arg)                                   \
+      __ec_vprintf_unlocked(__format, __arg)
+
+__attribute__((hot,noinline))
+void
+ec_vfprintf_unlocked(FILE *__restrict __stream,
+                            const char *__restrict __format, va_list __arg);
+
+__attribute__((hot,noinline))
+void
+ec_fprintf_unlocked(FILE *__restrict __stream,
+                                        const char *__restrict __format, ...);
+
+__attribute__((hot,noinline))
+void
+ec_vprintf_unlocked(const char *__restrict __format, va_list __arg);
+
+__attribute__((hot,noinline))
+void
+ec_printf_unlocked(const char *__restrict __format, ...);
+
+/*
+ * The compiled family prints a format compiled by ec_printf_compile, see
+ * <ec/internal/printf_compile.h>.
+ */
+#define ec_vfprintf_compiled(__stream, __compiled, __arg)                      \
+      __ec_vfprintf_compiled(__stream, __compiled, __arg)
+
+__attribute__((hot,noinline))
+void
+ec_vfprintf_compiled(FILE *__restrict __stream,
+            const ec_printf_format *__restrict __compiled, va_list __arg);
+
 __attribute__((hot,noinline))
 void
-ec_printf(const char *__restrict __format, ...);
+ec_fprintf_compiled(FILE *__restrict __stream,
+                        const ec_printf_format *__restrict __compiled, ...);
+
+__attribute__((hot,noinline))
+void
+ec_printf_compiled(const ec_printf_format *__restrict __compiled, ...);
+
+/*
+ * The cached family compiles the format of each call site on its first call
+ * and reuses it afterwards. A call site which is given another format than
+ * the one it was compiled for, prints that format uncached.
+ * The compiled formats are kept for the lifetime of the program.
+ */
+#define ec_fprintf_cached(__stream, ...)                                       \
+    __extension__ ({                                                           \
+        static ec_printf_format *__ec_printf_site = EC_NULL;                   \
+        __ec_fprintf_cached(&__ec_printf_site, __stream, __VA_ARGS__);         \
+    })
+
+#define ec_printf_cached(...)       ec_fprintf_cached(stdout, __VA_ARGS__)
+
+__attribute__((hot,noinline))
+void
+__ec_fprintf_cached(ec_printf_format **__site, FILE *__restrict __stream,
+                                        const char *__restrict __format, ...);
+
+/*
+ * ec_printf and ec_fprintf with arguments end up here. A constant format,
+ * e.g. a string literal, goes through the cache of the call site, any other
+ * format is parsed on every call. Both stay expressions of type void, the
+ * same as the fputs forms without arguments.
+ */
+#define __ec_printf_func__2(__format, ...)                                     \
+    __extension__ ({                                                           \
+        if(__builtin_constant_p(__format))                                     \
+            ec_printf_cached(__format, __VA_ARGS__);                           \
+        else                                                                   \
+            __ec_printf_uncached(__format, __VA_ARGS__);                       \
+    })
+
+#define __ec_fprintf_func__3(__stream, __format, ...)                          \
+    __extension__ ({                                                           \
+        if(__builtin_constant_p(__format))                                     \
+            ec_fprintf_cached(__stream, __format, __VA_ARGS__);                \
+        else                                                                   \
+            __ec_fprintf_uncached(__stream, __format, __VA_ARGS__);            \
+    })
+
+#if defined(__linux__) || defined(__unix__) || defined(__APPLE__)
+/*
+ * The descriptor family writes to a file descriptor, e.g. a socket or a pipe,
+ * with writev. The literal parts of the format and the "%s" arguments of at
+ * least EC_DPRINTF_REFERENCE_SIZE characters are written from where they are,
+ * only the converted values and the shorter parts are copied to a scratch
+ * buffer of EC_DPRINTF_SCRATCH_SIZE characters. A call which needs at most
+ * EC_DPRINTF_IOVEC_COUNT pieces and fits the scratch buffer is written with
+ * a single writev.
+ */
+#ifndef EC_DPRINTF_IOVEC_COUNT
+#define EC_DPRINTF_IOVEC_COUNT                  32
+#endif
+
+#ifndef EC_DPRINTF_SCRATCH_SIZE
+#define EC_DPRINTF_SCRATCH_SIZE                 512
+#endif
+
+#ifndef EC_DPRINTF_REFERENCE_SIZE
+#define EC_DPRINTF_REFERENCE_SIZE               64
+#endif
+
+#define ec_vdprintf(__fd, __format, __arg)                                     \
+      __ec_vdprintf(__fd, __format, __arg)
+
+/**
+ * @brief ec_vdprintf           Prints to a file descriptor.
+ * @param [in]__fd              The file descriptor.
+ * @param [in]__format          The format, the same as for ec_vfprintf.
+ * @param [in]__arg             The arguments.
+ * @return                      The number of characters written, or -1 when
+ *                              writing failed, with errno set by writev.
+ */
+__attribute__((hot,noinline))
+int
+ec_vdprintf(int __fd, const char *__restrict __format, va_list __arg);
+
+__attribute__((hot,noinline))
+int
+ec_dprintf(int __fd, const char *__restrict __format, ...);
+#endif
 
 #ifdef __cplusplus
 }
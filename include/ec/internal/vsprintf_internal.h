@@ -72,6 +72,122 @@ __attribute__((hot,noinline))
 int
 ec_sprintf(char *__restrict __dst, const char *__restrict __src, ...);
 
+#define ec_vsnprintf(__s, __size, __format, __arg)                             \
+      __ec_vsnprintf(__s, __size, __format, __arg)
+
+/**
+ * @brief ec_vsnprintf          The va_list variant of ec_snprintf.
+ */
+__attribute__((hot,noinline))
+int
+ec_vsnprintf(char *__restrict __dst, size_t __size,
+                               const char *__restrict __src, va_list __arg);
+
+/**
+ * @brief ec_snprintf           Bounded ec_sprintf, following the C99 snprintf
+ *                              semantics: at most __size - 1 characters are
+ *                              written, and the output is always NUL
+ *                              terminated unless __size is 0.
+ * @param [out]__dst            The destination. Can be EC_NULL if __size is 0.
+ * @param [in]__size            Size of the destination in bytes.
+ * @param [in]__src             The format string.
+ * @return                      Length of the whole output, excluding the NUL
+ *                              terminator. The output was truncated if this
+ *                              is >= __size.
+ */
+__attribute__((hot,noinline))
+int
+ec_snprintf(char *__restrict __dst, size_t __size,
+                                        const char *__restrict __src, ...);
+
+#define ec_vprintf_len(__format, __arg)                                        \
+      __ec_vprintf_len(__format, __arg)
+
+/**
+ * @brief ec_vprintf_len        The va_list variant of ec_printf_len.
+ */
+__attribute__((hot,noinline))
+size_t
+ec_vprintf_len(const char *__restrict __src, va_list __arg);
+
+/**
+ * @brief ec_printf_len         Computes the length of the output of a format
+ *                              without storing it anywhere.
+ * @param [in]__src             The format string.
+ * @return                      Length of the output, excluding the NUL
+ *                              terminator.
+ */
+__attribute__((hot,noinline))
+size_t
+ec_printf_len(const char *__restrict __src, ...);
+
+/* Size of the stack buffer ec_vasprintf formats into first. Longer outputs
+ * are formatted twice: once for the length, once into the allocation. */
+#ifndef EC_ASPRINTF_BUFFER_SIZE
+#define EC_ASPRINTF_BUFFER_SIZE                 256
+#endif
+
+/**
+ * @brief ec_printf_alloc_t     Allocates the string of ec_asprintf_alloc.
+ * @param [in]context           The context given to ec_asprintf_alloc.
+ * @param [in]size              Size of the string in bytes, including the NUL
+ *                              terminator.
+ * @return                      The memory, or EC_NULL if the allocation
+ *                              failed.
+ */
+typedef void *(*ec_printf_alloc_t)(void *context, size_t size);
+
+#define ec_vasprintf_alloc(__alloc, __context, __len, __format, __arg)         \
+      __ec_vasprintf_alloc(__alloc, __context, __len, __format, __arg)
+
+/**
+ * @brief ec_vasprintf_alloc    The va_list variant of ec_asprintf_alloc.
+ */
+__attribute__((hot,noinline))
+char *
+ec_vasprintf_alloc(ec_printf_alloc_t __alloc, void *__context, size_t *__len,
+                               const char *__restrict __src, va_list __arg);
+
+/**
+ * @brief ec_asprintf_alloc     Formats into a string of exactly the needed
+ *                              size, allocated once using the given function,
+ *                              e.g. from an arena.
+ * @param [in]__alloc           The allocation function.
+ * @param [in]__context         Passed to the allocation function as is.
+ * @param [out]__len            Receives the length of the string. Can be
+ *                              EC_NULL.
+ * @param [in]__src             The format string.
+ * @return                      The NUL terminated string, or EC_NULL if the
+ *                              allocation failed.
+ */
+__attribute__((hot,noinline))
+char *
+ec_asprintf_alloc(ec_printf_alloc_t __alloc, void *__context, size_t *__len,
+                                        const char *__restrict __src, ...);
+
+#define ec_vasprintf(__strp, __format, __arg)                                  \
+      __ec_vasprintf(__strp, __format, __arg)
+
+/**
+ * @brief ec_vasprintf          The va_list variant of ec_asprintf.
+ */
+__attribute__((hot,noinline))
+int
+ec_vasprintf(char **__strp, const char *__restrict __src, va_list __arg);
+
+/**
+ * @brief ec_asprintf           Formats into a string of exactly the needed
+ *                              size, allocated once using malloc.
+ * @param [out]__strp           Receives the string, to be released using
+ *                              free(). Set to EC_NULL on failure.
+ * @param [in]__src             The format string.
+ * @return                      Length of the string, or -1 if the allocation
+ *                              failed.
+ */
+__attribute__((hot,noinline))
+int
+ec_asprintf(char **__strp, const char *__restrict __src, ...);
+
 #ifdef __cplusplus
 }
 #endif
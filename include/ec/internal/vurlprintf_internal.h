@@ -65,6 +65,116 @@ extern "C"
 #define __ec_urlprintf_func__2(__dst, __src)                                   \
             (int)strlen(strcpy(__dst, __src))
 
+/* All the calls with arguments after the format end up in the variadic
+ * function, the same way ec_sprintf does in <sprintf_fix_optimizer.h>. */
+#define __ec_urlprintf_func__4    __ec_urlprintf_func__3
+#define __ec_urlprintf_func__5    __ec_urlprintf_func__3
+#define __ec_urlprintf_func__6    __ec_urlprintf_func__3
+#define __ec_urlprintf_func__7    __ec_urlprintf_func__3
+#define __ec_urlprintf_func__8    __ec_urlprintf_func__3
+#define __ec_urlprintf_func__9    __ec_urlprintf_func__3
+#define __ec_urlprintf_func__10   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__11   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__12   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__13   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__14   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__15   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__16   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__17   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__18   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__19   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__20   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__21   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__22   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__23   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__24   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__25   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__26   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__27   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__28   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__29   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__30   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__31   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__32   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__33   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__34   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__35   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__36   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__37   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__38   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__39   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__40   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__41   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__42   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__43   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__44   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__45   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__46   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__47   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__48   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__49   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__50   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__51   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__52   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__53   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__54   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__55   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__56   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__57   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__58   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__59   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__60   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__61   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__62   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__63   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__64   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__65   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__66   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__67   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__68   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__69   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__70   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__71   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__72   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__73   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__74   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__75   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__76   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__77   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__78   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__79   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__80   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__81   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__82   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__83   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__84   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__85   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__86   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__87   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__88   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__89   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__90   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__91   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__92   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__93   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__94   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__95   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__96   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__97   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__98   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__99   __ec_urlprintf_func__3
+#define __ec_urlprintf_func__100  __ec_urlprintf_func__3
+#define __ec_urlprintf_func__101  __ec_urlprintf_func__3
+#define __ec_urlprintf_func__102  __ec_urlprintf_func__3
+#define __ec_urlprintf_func__103  __ec_urlprintf_func__3
+#define __ec_urlprintf_func__104  __ec_urlprintf_func__3
+#define __ec_urlprintf_func__105  __ec_urlprintf_func__3
+#define __ec_urlprintf_func__106  __ec_urlprintf_func__3
+#define __ec_urlprintf_func__107  __ec_urlprintf_func__3
+#define __ec_urlprintf_func__108  __ec_urlprintf_func__3
+#define __ec_urlprintf_func__109  __ec_urlprintf_func__3
+#define __ec_urlprintf_func__110  __ec_urlprintf_func__3
+
 
 __attribute__((hot,noinline))
 int
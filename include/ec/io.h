@@ -30,6 +30,7 @@
 #include <stdarg.h>
 #include <stdbool.h>
 #include <ec/vector.h>
+#include <ec/sstring.h>
 #include <ec/internal/vprintf_internal.h>
 
 #ifdef __cplusplus
@@ -147,13 +148,26 @@ void ec_generate_progress_bar(char *ptr, double progress, int width,
  */
 void ec_popen(char *command, char *respond, size_t respond_size);
 
+/**
+ * @brief ec_popen_sstring     A wrapper around standard popen function. It runs
+ *                             the given command and stores the first line of
+ *                             the response, whatever its length, inside the
+ *                             given string. Short responses don't allocate.
+ * @param [in]command          The command to be run.
+ * @param [out]respond         The string to hold the response. It must be
+ *                             initialized.
+ * @return                     false if the command could not be run or the
+ *                             allocation failed.
+ */
+bool ec_popen_sstring(char *command, ec_sstring *respond);
+
 /**
  * @brief ec_int_popen          A wrapper around standard popen function. It
  *                              runs the given command that is supposed to only
  *                              return an integer value. Then converts the
  *                              given respond to integer and returns the value.
- *                              If the respond is not an integer, the builtin
- *                              atoi function's behaviour is returning 0.
+ *                              If the respond is not an integer, 0 is
+ *                              returned. Out of range values are saturated.
  * @param command               The command to be run.
  * @return                      The respond converted to integer.
  */
@@ -165,8 +179,9 @@ int ec_int_popen(char *command);
  *                              return an integer value or a double value. Then
  *                              converts the given respond to double and
  *                              returns the value.
- *                              If the respond is not a valid number, the
- *                              builtin atof function's behavior is returning 0.
+ *                              If the respond is not a valid number, 0 is
+ *                              returned. The conversion doesn't depend on the
+ *                              current locale.
  * @param command               The command to be run.
  * @return                      The respond converted to double.
  */
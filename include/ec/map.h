@@ -25,6 +25,10 @@
 #ifndef ECLIBC_MAP_H
 #define ECLIBC_MAP_H 1
 
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -48,9 +52,112 @@ extern "C"
 #define EC_NULL NULL
 #endif
 
+/**
+ *****************************************************************************
+ **                                                                         **
+ **                          How to use this API                            **
+ **                                                                         **
+ *****************************************************************************
+ *****************************************************************************
+ **                                                                         **
+ ** ec_flatmap is a read-mostly sorted map of 64 bit keys. It is built once **
+ ** from an already sorted array and afterwards only supports lookups.      **
+ **                                                                         **
+ ** Instead of keeping the keys in sorted order, they are stored in the     **
+ ** Eytzinger (BFS/heap) order: the children of the node "k" live at "2k"   **
+ ** and "2k+1". The first levels of the tree therefore share a handful of   **
+ ** cache lines, the search loop is branch free and the cache lines of the  **
+ ** levels to come can be prefetched ahead of time. That makes lookups on   **
+ ** large sets noticeably faster than a plain binary search over a sorted   **
+ ** array, while keeping the memory footprint at a single array.            **
+ **                                                                         **
+ ** To build a map, use:                                                    **
+ **      ec_flatmap_build(&$MAP$, $SORTED_KEYS$, $VALUES$, $COUNT$);        **
+ ** $VALUES$ may be EC_NULL, in which case the map acts as a set.           **
+ **                                                                         **
+ ** For sets, the following shorthands are also available:                  **
+ **      ec_flatset_build(&$SET$, $SORTED_KEYS$, $COUNT$);                  **
+ **      ec_flatset_contains(&$SET$, $KEY$);                                **
+ **                                                                         **
+ ** The memory is released using:                                           **
+ **      ec_flatmap_delete(&$MAP$);                                         **
+ **                                                                         **
+ *****************************************************************************
+ *****************************************************************************
+ **/
+
+typedef struct
+{
+    /* Keys in Eytzinger order, 1 based. keys[0] is unused. */
+    uint64_t *keys;
+    /* Values in the same order as the keys, or EC_NULL for sets. */
+    void    **values;
+    /* Number of the stored keys. */
+    size_t    size;
+    /* The raw allocation backing the cache line aligned keys array. */
+    void     *__storage;
+} ec_flatmap;
+
+typedef ec_flatmap ec_flatset;
+
+/**
+ * @brief ec_flatmap_build      Builds the map out of the given sorted keys.
+ *                              The keys and values are copied, so the given
+ *                              arrays can be released after the call.
+ * @param [out]map              The map to be built.
+ * @param [in]keys              The keys, sorted in ascending order. Duplicate
+ *                              keys are allowed, lookups return the first one.
+ * @param [in]values            The values matching the keys, or EC_NULL to
+ *                              build a set.
+ * @param [in]count             Number of the given keys.
+ * @return                      false if the keys are not sorted or the memory
+ *                              allocation fails, true otherwise.
+ */
+bool ec_flatmap_build(ec_flatmap *map, const uint64_t *keys,
+                      void *const *values, size_t count);
+
+/**
+ * @brief ec_flatmap_delete     Releases the memory held by the map.
+ * @param [in]map               The map to be deleted.
+ */
+void ec_flatmap_delete(ec_flatmap *map);
+
+/**
+ * @brief ec_flatmap_find       Looks the given key up.
+ * @param [in]map               The map to be searched.
+ * @param [in]key               The key to look for.
+ * @param [out]value            Receives the value of the key, if it was found.
+ *                              Can be EC_NULL.
+ * @return                      true if the key exists in the map.
+ */
+bool ec_flatmap_find(const ec_flatmap *map, uint64_t key, void **value);
+
+/**
+ * @brief ec_flatmap_lower_bound    Finds the smallest key which is not less
+ *                                  than the given key.
+ * @param [in]map                   The map to be searched.
+ * @param [in]key                   The key to look for.
+ * @param [out]found_key            Receives the found key. Can be EC_NULL.
+ * @param [out]value                Receives the value of the found key. Can
+ *                                  be EC_NULL.
+ * @return                          false if all the keys are less than the
+ *                                  given key.
+ */
+bool ec_flatmap_lower_bound(const ec_flatmap *map, uint64_t key,
+                            uint64_t *found_key, void **value);
+
+#define ec_flatmap_size(_map)       ((_map)->size)
+
+#define ec_flatmap_contains(_map, _key)                                        \
+        ec_flatmap_find(_map, _key, EC_NULL)
 
+#define ec_flatset_build(_set, _keys, _count)                                  \
+        ec_flatmap_build(_set, _keys, EC_NULL, _count)
 
+#define ec_flatset_contains(_set, _key)                                        \
+        ec_flatmap_find(_set, _key, EC_NULL)
 
+#define ec_flatset_delete(_set)     ec_flatmap_delete(_set)
 
 #ifdef __cplusplus
 }
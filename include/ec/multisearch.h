@@ -0,0 +1,237 @@
+/* <multisearch.h> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef ECLIBC_MULTISEARCH_H
+#define ECLIBC_MULTISEARCH_H 1
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Since different compilers and different platforms implement NULL in a
+ * different manner, EC_NULL is a helping macro to unify the NULL pointer over
+ * all platforms.
+ * E.g. some platforms have __builtin_null (like XC16) and some define it the
+ *      same exact way.
+ */
+#ifndef EC_NULL
+#define EC_NULL ((void *)0)
+#endif
+
+/* All CPP compilers on the other hand, use the same exact NULL pointer on all
+ * platforms. So, there is no need to change the course of standard C++ library.
+ */
+#ifdef __cplusplus
+#undef EC_NULL
+#define EC_NULL NULL
+#endif
+
+/**
+ *****************************************************************************
+ **                                                                         **
+ **                          How to use this API                            **
+ **                                                                         **
+ *****************************************************************************
+ *****************************************************************************
+ **                                                                         **
+ ** ec_multisearch finds all the occurrences of many patterns (keywords) in **
+ ** a text, while reading every byte of the text only once, no matter how   **
+ ** many patterns there are. It is an Aho-Corasick automaton compiled into **
+ ** a dense table: one lookup per input byte. Bytes which don't appear in   **
+ ** any pattern share a single column of the table.                         **
+ **                                                                         **
+ ** The patterns are compiled once:                                         **
+ **      ec_multisearch_build(&$SEARCH$, $PATTERNS$, $LENGTHS$, $COUNT$,    **
+ **                           $FLAGS$)                                      **
+ ** The ID of a pattern is its index in the given array.                    **
+ **                                                                         **
+ ** A whole buffer is searched with:                                        **
+ **      ec_multisearch_scan(&$SEARCH$, $TEXT$, $LEN$, $CALLBACK$, $CTX$)   **
+ **      ec_multisearch_find(&$SEARCH$, $TEXT$, $LEN$, &$ID$, &$OFFSET$)    **
+ ** The latter only reports the first match.                                **
+ **                                                                         **
+ ** A stream (a socket, a log file being read in chunks...) is searched    **
+ ** with a stream state, which carries partial matches over the chunk       **
+ ** boundaries. The offsets are counted from the start of the stream:       **
+ **      ec_multisearch_stream_init(&$STREAM$)                              **
+ **      ec_multisearch_feed(&$SEARCH$, &$STREAM$, $CHUNK$, $LEN$,          **
+ **                          $CALLBACK$, $CTX$)                             **
+ **                                                                         **
+ ** A compiled ec_multisearch is never modified by the searches, so it can **
+ ** be shared between threads; each thread needs its own stream state.      **
+ **                                                                         **
+ *****************************************************************************
+ *****************************************************************************
+ **/
+
+/* Build flags */
+/* ASCII letters match regardless of their case. */
+#define EC_MULTISEARCH_IGNORE_CASE      0x01U
+
+typedef struct
+{
+    /* Transitions, indexed by state + class. The states are premultiplied
+     * by class_count, so the next state is read without a multiplication. */
+    uint32_t *transitions;
+    /* Pattern IDs matched by each matching state, flattened. Matching states
+     * are numbered last: state >= match_threshold means a match. */
+    uint32_t *match_first;
+    uint32_t *match_ids;
+    size_t   *pattern_lengths;
+    uint32_t  match_threshold;
+    uint32_t  class_count;
+    size_t    state_count;
+    size_t    pattern_count;
+    /* Bytes leaving the root state, used to skip the text quickly when they
+     * are few. */
+    uint8_t   start_bytes[8];
+    uint8_t   start_count;
+    uint8_t   classes[256];
+    void     *__storage;
+} ec_multisearch;
+
+typedef struct
+{
+    uint32_t state;
+    /* Stream offset of the first byte of the next chunk. */
+    uint64_t offset;
+} ec_multisearch_stream;
+
+/**
+ * @brief ec_multisearch_callback_t     The callback type used to report the
+ *                                      matches.
+ * @param [in]pattern_id                The index of the matched pattern.
+ * @param [in]offset                    Offset of the first byte of the match.
+ * @param [in]context                   The user context given to the search.
+ * @return                              false to stop the search.
+ */
+typedef bool (*ec_multisearch_callback_t)(size_t pattern_id, uint64_t offset,
+                                          void *context);
+
+/**
+ * @brief ec_multisearch_build  Compiles the patterns.
+ * @param [out]search           The search to be built.
+ * @param [in]patterns          The patterns. They are copied, so they don't
+ *                              need to outlive the search.
+ * @param [in]lengths           Lengths of the patterns, or EC_NULL if the
+ *                              patterns are NUL terminated strings.
+ * @param [in]count             Number of the patterns.
+ * @param [in]flags             EC_MULTISEARCH_* flags, or 0.
+ * @return                      false if a pattern is empty or the memory
+ *                              allocation fails.
+ */
+bool ec_multisearch_build(ec_multisearch *search,
+                          const char *const *patterns, const size_t *lengths,
+                          size_t count, unsigned flags);
+
+/**
+ * @brief ec_multisearch_delete     Releases the memory held by the search.
+ * @param [in]search                The search to be deleted.
+ */
+void ec_multisearch_delete(ec_multisearch *search);
+
+/**
+ * @brief ec_multisearch_stream_init    Prepares a stream state to search a
+ *                                      new stream.
+ * @param [out]stream                   The stream state.
+ */
+static inline void
+__attribute__ ((unused, always_inline))
+ec_multisearch_stream_init(ec_multisearch_stream *stream)
+{
+    stream->state = 0;
+    stream->offset = 0;
+}
+
+/**
+ * @brief ec_multisearch_feed   Searches the next chunk of a stream. Matches
+ *                              spanning over several chunks are reported when
+ *                              their last byte is fed.
+ * @param [in]search            The compiled search.
+ * @param [in]stream            The stream state.
+ * @param [in]data              The chunk.
+ * @param [in]len               Length of the chunk.
+ * @param [in]callback          The callback receiving the matches, in the
+ *                              order of their end offsets. Can be EC_NULL to
+ *                              only count the matches.
+ * @param [in]context           User context passed to the callback.
+ * @return                      Number of the reported matches.
+ * @note                        If the callback stops the search, the stream
+ *                              stays right after the last byte of that match
+ *                              and its offset only counts the bytes up to
+ *                              there. Feeding the rest of the chunk, i.e.
+ *                              from the new offset on, goes on with the
+ *                              search. Other patterns ending at the same
+ *                              byte are not reported then.
+ */
+size_t ec_multisearch_feed(const ec_multisearch *search,
+                           ec_multisearch_stream *stream, const char *data,
+                           size_t len, ec_multisearch_callback_t callback,
+                           void *context);
+
+/**
+ * @brief ec_multisearch_scan   Searches a whole buffer.
+ * @param [in]search            The compiled search.
+ * @param [in]data              The buffer.
+ * @param [in]len               Length of the buffer.
+ * @param [in]callback          The callback receiving the matches. Can be
+ *                              EC_NULL to only count the matches.
+ * @param [in]context           User context passed to the callback.
+ * @return                      Number of the reported matches.
+ */
+size_t ec_multisearch_scan(const ec_multisearch *search, const char *data,
+                           size_t len, ec_multisearch_callback_t callback,
+                           void *context);
+
+/**
+ * @brief ec_multisearch_find   Finds the match which ends first. Of the
+ *                              patterns ending at the same byte, the longest
+ *                              one is reported.
+ * @param [in]search            The compiled search.
+ * @param [in]data              The buffer.
+ * @param [in]len               Length of the buffer.
+ * @param [out]pattern_id       Receives the pattern ID. Can be EC_NULL.
+ * @param [out]offset           Receives the offset of the match. Can be
+ *                              EC_NULL.
+ * @return                      true if any pattern matched.
+ */
+bool ec_multisearch_find(const ec_multisearch *search, const char *data,
+                         size_t len, size_t *pattern_id, size_t *offset);
+
+#define ec_multisearch_pattern_count(_search)   ((_search)->pattern_count)
+
+#define ec_multisearch_contains(_search, _data, _len)                          \
+        ec_multisearch_find(_search, _data, _len, EC_NULL, EC_NULL)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,419 @@
+/* <print.h> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef ECLIBC_PRINT_H
+#define ECLIBC_PRINT_H 1
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <ec/types.h>
+#include <ec/utf8.h>
+#include <ec/string.h>
+#include <ec/strbuf.h>
+#include <ec/preprocessor.h>
+#include <ec/internal/text_parse/itoa.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Since different compilers and different platforms implement NULL in a
+ * different manner, EC_NULL is a helping macro to unify the NULL pointer over
+ * all platforms.
+ * E.g. some platforms have __builtin_null (like XC16) and some define it the
+ *      same exact way.
+ */
+#ifndef EC_NULL
+#define EC_NULL ((void *)0)
+#endif
+
+/* All CPP compilers on the other hand, use the same exact NULL pointer on all
+ * platforms. So, there is no need to change the course of standard C++ library.
+ */
+#ifdef __cplusplus
+#undef EC_NULL
+#define EC_NULL NULL
+#endif
+
+/**
+ *****************************************************************************
+ **                                                                         **
+ **                          How to use this API                            **
+ **                                                                         **
+ *****************************************************************************
+ *****************************************************************************
+ **                                                                         **
+ ** ec_print prints its arguments one after the other, picking the writer  **
+ ** of each argument from its type at compile time:                         **
+ **      ec_print("client ", ip, " sent ", bytes, " bytes\n");              **
+ ** There is no format string to be parsed and no va_arg, so every call    **
+ ** compiles down to direct calls of the matching writers.                  **
+ **                                                                         **
+ ** Supported types are the integer types (printed in decimal), char       **
+ ** (printed as a character), bool (True/False), float and double, char *, **
+ ** ec_strview, ec_ipv4_t, ec_ipv6_t, ec_mac_t and UTF8 characters wrapped  **
+ ** using ec_print_utf8($CHAR$). Anything else is a compile error.          **
+ ** Note that in C, a character constant such as ' ' is an int and hence   **
+ ** printed as a number. Use " " or (char)' ' instead.                      **
+ **                                                                         **
+ **      ec_print(...)                  prints to stdout.                   **
+ **      ec_fprint($STREAM$, ...)       prints to the given stream.         **
+ **      ec_strbuf_print(&$BUF$, ...)   appends to a string builder.        **
+ **                                                                         **
+ ** Up to 32 arguments can be given. The output of a call is written to    **
+ ** the stream at once, the same way ec_printf does.                        **
+ **                                                                         **
+ ** The type dispatch needs C11 (_Generic) or C++. With C99 only the typed **
+ ** ec_strbuf_print_* writers are available.                                **
+ **                                                                         **
+ *****************************************************************************
+ *****************************************************************************
+ **/
+
+#ifndef EC_PRINT_BUFFER_SIZE
+#define EC_PRINT_BUFFER_SIZE                    512
+#endif
+
+/* A UTF8 character, which would be printed as a number otherwise. */
+typedef struct
+{
+    ec_utf8_t value;
+} ec_print_utf8_t;
+
+static inline ec_print_utf8_t
+__attribute__ ((unused, always_inline))
+ec_print_utf8(ec_utf8_t value)
+{
+    ec_print_utf8_t result;
+    result.value = value;
+    return result;
+}
+
+/**
+ * @brief ec_strbuf_print_uint  Appends an unsigned integer in decimal.
+ * @param [in]buf               The builder.
+ * @param [in]value             The value.
+ */
+static inline void
+__attribute__ ((unused, always_inline))
+ec_strbuf_print_uint(ec_strbuf *buf, uint64_t value)
+{
+    /* With room for the longest value the digits are written in place. */
+    if(buf->cap - buf->len > 20)
+    {
+        buf->len += ec_utoa10(value, buf->data + buf->len);
+        buf->data[buf->len] = '\0';
+        return;
+    }
+
+    char storage[24];
+    char *end = storage + sizeof(storage);
+    char *start = ec_itoa_uint64_t(value, end, 10, false);
+    ec_strbuf_append_n(buf, start, (size_t)(end - start));
+}
+
+/**
+ * @brief ec_strbuf_print_int   Appends a signed integer in decimal.
+ * @param [in]buf               The builder.
+ * @param [in]value             The value.
+ */
+static inline void
+__attribute__ ((unused, always_inline))
+ec_strbuf_print_int(ec_strbuf *buf, int64_t value)
+{
+    uint64_t magnitude = (uint64_t)value;
+    if(value < 0)
+    {
+        ec_strbuf_append_char(buf, '-');
+        magnitude = 0U - magnitude;
+    }
+    ec_strbuf_print_uint(buf, magnitude);
+}
+
+static inline void
+__attribute__ ((unused, always_inline))
+ec_strbuf_print_char(ec_strbuf *buf, char value)
+{
+    ec_strbuf_append_char(buf, value);
+}
+
+static inline void
+__attribute__ ((unused, always_inline))
+ec_strbuf_print_bool(ec_strbuf *buf, bool value)
+{
+    if(value)
+        ec_strbuf_append_n(buf, "True", 4);
+    else
+        ec_strbuf_append_n(buf, "False", 5);
+}
+
+/* A null pointer is printed as "(null)". */
+static inline void
+__attribute__ ((unused, always_inline))
+ec_strbuf_print_str(ec_strbuf *buf, const char *value)
+{
+    if(value == EC_NULL)
+        ec_strbuf_append_n(buf, "(null)", 6);
+    else
+        ec_strbuf_append(buf, value);
+}
+
+static inline void
+__attribute__ ((unused, always_inline))
+ec_strbuf_print_view(ec_strbuf *buf, ec_strview value)
+{
+    ec_strbuf_append_view(buf, value);
+}
+
+static inline void
+__attribute__ ((unused, always_inline))
+ec_strbuf_print_utf8(ec_strbuf *buf, ec_print_utf8_t value)
+{
+    char storage[5];
+    size_t len = 0;
+    ea_utf8_decode(value.value, storage);
+    while(len < sizeof(storage) && storage[len] != '\0')
+        len++;
+    ec_strbuf_append_n(buf, storage, len);
+}
+
+/**
+ * @brief ec_strbuf_print_double    Appends a double the same way "%!g" of
+ *                                  ec_printf prints it: the shortest string
+ *                                  that reads back as the same value.
+ * @param [in]buf                   The builder.
+ * @param [in]value                 The value.
+ */
+void ec_strbuf_print_double(ec_strbuf *buf, double value);
+
+/**
+ * @brief ec_strbuf_print_float     Appends a float the same way "%!hg" of
+ *                                  ec_printf prints it, e.g. 0.1f is "0.1".
+ * @param [in]buf                   The builder.
+ * @param [in]value                 The value.
+ */
+void ec_strbuf_print_float(ec_strbuf *buf, float value);
+
+/**
+ * @brief ec_strbuf_print_ipv4  Appends an IPv4 address, the same way "%!i"
+ *                              of ec_printf prints it.
+ * @param [in]buf               The builder.
+ * @param [in]value             The address.
+ */
+void ec_strbuf_print_ipv4(ec_strbuf *buf, ec_ipv4_t value);
+
+/**
+ * @brief ec_strbuf_print_ipv6  Appends an IPv6 address, the same way "%!I"
+ *                              of ec_printf prints it.
+ * @param [in]buf               The builder.
+ * @param [in]value             The address.
+ */
+void ec_strbuf_print_ipv6(ec_strbuf *buf, ec_ipv6_t value);
+
+/**
+ * @brief ec_strbuf_print_mac   Appends a MAC address in the lower case
+ *                              "00:00:5e:00:53:af" form.
+ * @param [in]buf               The builder.
+ * @param [in]value             The address.
+ */
+void ec_strbuf_print_mac(ec_strbuf *buf, ec_mac_t value);
+
+/* Locks the stream and prepares the builder of an ec_fprint call. */
+void __ec_print_begin(ec_strbuf *buf, char *storage, size_t size,
+                                                                FILE *stream);
+
+/* Writes the rest of the output of an ec_fprint call and unlocks the
+ * stream. */
+void __ec_print_end(ec_strbuf *buf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#if defined(__cplusplus)
+#define __EC_PRINT_GENERIC 1
+#elif defined(__STDC_VERSION__)
+#if __STDC_VERSION__ >= 201112L
+#define __EC_PRINT_GENERIC 1
+#define __ec_print_value(_buf, _value)                                         \
+    _Generic((_value),                                                         \
+        char:                   ec_strbuf_print_char,                          \
+        signed char:            ec_strbuf_print_int,                           \
+        short:                  ec_strbuf_print_int,                           \
+        int:                    ec_strbuf_print_int,                           \
+        long:                   ec_strbuf_print_int,                           \
+        long long:              ec_strbuf_print_int,                           \
+        unsigned char:          ec_strbuf_print_uint,                          \
+        unsigned short:         ec_strbuf_print_uint,                          \
+        unsigned int:           ec_strbuf_print_uint,                          \
+        unsigned long:          ec_strbuf_print_uint,                          \
+        unsigned long long:     ec_strbuf_print_uint,                          \
+        bool:                   ec_strbuf_print_bool,                          \
+        float:                  ec_strbuf_print_float,                         \
+        double:                 ec_strbuf_print_double,                        \
+        char *:                 ec_strbuf_print_str,                           \
+        const char *:           ec_strbuf_print_str,                           \
+        ec_strview:             ec_strbuf_print_view,                          \
+        ec_ipv4_t:              ec_strbuf_print_ipv4,                          \
+        ec_ipv6_t:              ec_strbuf_print_ipv6,                          \
+        ec_mac_t:               ec_strbuf_print_mac,                           \
+        ec_print_utf8_t:        ec_strbuf_print_utf8)((_buf), (_value))
+#endif
+#endif
+
+#ifdef __cplusplus
+
+static inline void
+__attribute__ ((unused, always_inline))
+__ec_print_value(ec_strbuf *buf, char value)
+{
+    ec_strbuf_print_char(buf, value);
+}
+
+#define __EC_PRINT_OVERLOAD(_type, _writer)                                    \
+    static inline void                                                         \
+    __attribute__ ((unused, always_inline))                                    \
+    __ec_print_value(ec_strbuf *buf, _type value)                              \
+    {                                                                          \
+        _writer(buf, value);                                                   \
+    }
+
+__EC_PRINT_OVERLOAD(signed char,            ec_strbuf_print_int)
+__EC_PRINT_OVERLOAD(short,                  ec_strbuf_print_int)
+__EC_PRINT_OVERLOAD(int,                    ec_strbuf_print_int)
+__EC_PRINT_OVERLOAD(long,                   ec_strbuf_print_int)
+__EC_PRINT_OVERLOAD(long long,              ec_strbuf_print_int)
+__EC_PRINT_OVERLOAD(unsigned char,          ec_strbuf_print_uint)
+__EC_PRINT_OVERLOAD(unsigned short,         ec_strbuf_print_uint)
+__EC_PRINT_OVERLOAD(unsigned int,           ec_strbuf_print_uint)
+__EC_PRINT_OVERLOAD(unsigned long,          ec_strbuf_print_uint)
+__EC_PRINT_OVERLOAD(unsigned long long,     ec_strbuf_print_uint)
+__EC_PRINT_OVERLOAD(bool,                   ec_strbuf_print_bool)
+__EC_PRINT_OVERLOAD(float,                  ec_strbuf_print_float)
+__EC_PRINT_OVERLOAD(double,                 ec_strbuf_print_double)
+__EC_PRINT_OVERLOAD(const char *,           ec_strbuf_print_str)
+__EC_PRINT_OVERLOAD(ec_strview,             ec_strbuf_print_view)
+__EC_PRINT_OVERLOAD(ec_ipv4_t,              ec_strbuf_print_ipv4)
+__EC_PRINT_OVERLOAD(ec_ipv6_t,              ec_strbuf_print_ipv6)
+__EC_PRINT_OVERLOAD(ec_mac_t,               ec_strbuf_print_mac)
+__EC_PRINT_OVERLOAD(ec_print_utf8_t,        ec_strbuf_print_utf8)
+
+#undef __EC_PRINT_OVERLOAD
+
+#endif
+
+#ifdef __EC_PRINT_GENERIC
+
+#define __ec_print_each_1(b, x)       __ec_print_value(b, x);
+#define __ec_print_each_2(b, x, ...)  __ec_print_value(b, x);                  \
+                                      __ec_print_each_1(b, __VA_ARGS__)
+#define __ec_print_each_3(b, x, ...)  __ec_print_value(b, x);                  \
+                                      __ec_print_each_2(b, __VA_ARGS__)
+#define __ec_print_each_4(b, x, ...)  __ec_print_value(b, x);                  \
+                                      __ec_print_each_3(b, __VA_ARGS__)
+#define __ec_print_each_5(b, x, ...)  __ec_print_value(b, x);                  \
+                                      __ec_print_each_4(b, __VA_ARGS__)
+#define __ec_print_each_6(b, x, ...)  __ec_print_value(b, x);                  \
+                                      __ec_print_each_5(b, __VA_ARGS__)
+#define __ec_print_each_7(b, x, ...)  __ec_print_value(b, x);                  \
+                                      __ec_print_each_6(b, __VA_ARGS__)
+#define __ec_print_each_8(b, x, ...)  __ec_print_value(b, x);                  \
+                                      __ec_print_each_7(b, __VA_ARGS__)
+#define __ec_print_each_9(b, x, ...)  __ec_print_value(b, x);                  \
+                                      __ec_print_each_8(b, __VA_ARGS__)
+#define __ec_print_each_10(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_9(b, __VA_ARGS__)
+#define __ec_print_each_11(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_10(b, __VA_ARGS__)
+#define __ec_print_each_12(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_11(b, __VA_ARGS__)
+#define __ec_print_each_13(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_12(b, __VA_ARGS__)
+#define __ec_print_each_14(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_13(b, __VA_ARGS__)
+#define __ec_print_each_15(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_14(b, __VA_ARGS__)
+#define __ec_print_each_16(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_15(b, __VA_ARGS__)
+#define __ec_print_each_17(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_16(b, __VA_ARGS__)
+#define __ec_print_each_18(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_17(b, __VA_ARGS__)
+#define __ec_print_each_19(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_18(b, __VA_ARGS__)
+#define __ec_print_each_20(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_19(b, __VA_ARGS__)
+#define __ec_print_each_21(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_20(b, __VA_ARGS__)
+#define __ec_print_each_22(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_21(b, __VA_ARGS__)
+#define __ec_print_each_23(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_22(b, __VA_ARGS__)
+#define __ec_print_each_24(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_23(b, __VA_ARGS__)
+#define __ec_print_each_25(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_24(b, __VA_ARGS__)
+#define __ec_print_each_26(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_25(b, __VA_ARGS__)
+#define __ec_print_each_27(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_26(b, __VA_ARGS__)
+#define __ec_print_each_28(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_27(b, __VA_ARGS__)
+#define __ec_print_each_29(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_28(b, __VA_ARGS__)
+#define __ec_print_each_30(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_29(b, __VA_ARGS__)
+#define __ec_print_each_31(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_30(b, __VA_ARGS__)
+#define __ec_print_each_32(b, x, ...) __ec_print_value(b, x);                  \
+                                      __ec_print_each_31(b, __VA_ARGS__)
+
+#define __ec_print_each_impl(n, b, ...) __ec_print_each_ ## n(b, __VA_ARGS__)
+#define __ec_print_each(n, b, ...)      __ec_print_each_impl(n, b, __VA_ARGS__)
+
+#define ec_strbuf_print(_buf, ...)                                             \
+    do                                                                         \
+    {                                                                          \
+        __ec_print_each(__EC_VA_NARGS__(__VA_ARGS__), (_buf), __VA_ARGS__)     \
+    } while(0)
+
+#define ec_fprint(_stream, ...)                                                \
+    do                                                                         \
+    {                                                                          \
+        char __ec_print_storage[EC_PRINT_BUFFER_SIZE];                         \
+        ec_strbuf __ec_print_buf;                                              \
+        __ec_print_begin(&__ec_print_buf, __ec_print_storage,                  \
+                                    sizeof(__ec_print_storage), (_stream));    \
+        __ec_print_each(__EC_VA_NARGS__(__VA_ARGS__), &__ec_print_buf,         \
+                                                                 __VA_ARGS__)  \
+        __ec_print_end(&__ec_print_buf);                                       \
+    } while(0)
+
+#define ec_print(...)               ec_fprint(stdout, __VA_ARGS__)
+
+#endif
+
+#endif
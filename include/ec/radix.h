@@ -0,0 +1,214 @@
+/* <radix.h> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef ECLIBC_RADIX_H
+#define ECLIBC_RADIX_H 1
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Since different compilers and different platforms implement NULL in a
+ * different manner, EC_NULL is a helping macro to unify the NULL pointer over
+ * all platforms.
+ * E.g. some platforms have __builtin_null (like XC16) and some define it the
+ *      same exact way.
+ */
+#ifndef EC_NULL
+#define EC_NULL ((void *)0)
+#endif
+
+/* All CPP compilers on the other hand, use the same exact NULL pointer on all
+ * platforms. So, there is no need to change the course of standard C++ library.
+ */
+#ifdef __cplusplus
+#undef EC_NULL
+#define EC_NULL NULL
+#endif
+
+/**
+ *****************************************************************************
+ **                                                                         **
+ **                          How to use this API                            **
+ **                                                                         **
+ *****************************************************************************
+ *****************************************************************************
+ **                                                                         **
+ ** ec_radix_tree is a compressed radix tree (trie) of byte string keys.    **
+ ** Common key fragments are stored only once and the inner nodes adapt     **
+ ** their size to the number of their children (4, 16, 48 or 256), the same **
+ ** way the "Adaptive Radix Tree" does. Keys may be prefixes of other keys. **
+ **                                                                         **
+ ** The tree is mainly meant to classify an input against many prefixes at **
+ ** once, instead of calling ec_str_starts_with in a loop:                  **
+ **      ec_radix_longest_prefix(&$TREE$, $INPUT$, $LEN$, &$MATCH$, &$VAL$) **
+ **      ec_radix_all_prefixes(&$TREE$, $INPUT$, $LEN$, $CALLBACK$, $CTX$)  **
+ ** Both walk the input only once, no matter how many keys are stored.     **
+ **                                                                         **
+ ** The stored keys can be visited in lexicographical order using:          **
+ **      ec_radix_for_each(&$TREE$, $CALLBACK$, $CTX$)                      **
+ **      ec_radix_prefix_scan(&$TREE$, $PREFIX$, $LEN$, $CALLBACK$, $CTX$)  **
+ ** The latter only visits the keys starting with the given prefix.         **
+ **                                                                         **
+ ** The callbacks return false to stop the iteration.                       **
+ **                                                                         **
+ *****************************************************************************
+ *****************************************************************************
+ **/
+
+typedef struct __ec_radix_node __ec_radix_node;
+
+typedef struct
+{
+    __ec_radix_node *root;
+    /* Number of the stored keys. */
+    size_t           size;
+    /* Length of the longest stored key, used by the iteration API. */
+    size_t           max_key_len;
+} ec_radix_tree;
+
+/**
+ * @brief ec_radix_callback_t   The callback type used to report the keys.
+ * @param [in]key               The key. It is NOT null terminated.
+ * @param [in]key_len           Length of the key.
+ * @param [in]value             The value stored with the key.
+ * @param [in]context           The user context given to the API call.
+ * @return                      false to stop the iteration.
+ */
+typedef bool (*ec_radix_callback_t)(const char *key, size_t key_len,
+                                    void *value, void *context);
+
+/**
+ * @brief ec_radix_init     Initializes an empty tree.
+ * @param [out]tree         The tree to be initialized.
+ */
+void ec_radix_init(ec_radix_tree *tree);
+
+/**
+ * @brief ec_radix_delete   Releases all the memory held by the tree. The tree
+ *                          is empty and ready to be used after the call.
+ * @param [in]tree          The tree to be deleted.
+ */
+void ec_radix_delete(ec_radix_tree *tree);
+
+/**
+ * @brief ec_radix_insert   Inserts a key into the tree. If the key already
+ *                          exists, its value is replaced.
+ * @param [in]tree          The tree.
+ * @param [in]key           The key. Can contain any byte, including zero.
+ * @param [in]key_len       Length of the key.
+ * @param [in]value         The value to be stored with the key.
+ * @return                  false if the memory allocation fails.
+ */
+bool ec_radix_insert(ec_radix_tree *tree, const char *key, size_t key_len,
+                     void *value);
+
+/**
+ * @brief ec_radix_find     Looks an exact key up.
+ * @param [in]tree          The tree.
+ * @param [in]key           The key.
+ * @param [in]key_len       Length of the key.
+ * @param [out]value        Receives the value of the key. Can be EC_NULL.
+ * @return                  true if the key exists.
+ */
+bool ec_radix_find(const ec_radix_tree *tree, const char *key, size_t key_len,
+                   void **value);
+
+/**
+ * @brief ec_radix_longest_prefix   Finds the longest stored key which is a
+ *                                  prefix of the given input.
+ * @param [in]tree                  The tree.
+ * @param [in]input                 The input.
+ * @param [in]input_len             Length of the input.
+ * @param [out]match_len            Receives the length of the matched key.
+ *                                  Can be EC_NULL.
+ * @param [out]value                Receives the value of the matched key.
+ *                                  Can be EC_NULL.
+ * @return                          true if any key matched.
+ */
+bool ec_radix_longest_prefix(const ec_radix_tree *tree, const char *input,
+                             size_t input_len, size_t *match_len,
+                             void **value);
+
+/**
+ * @brief ec_radix_all_prefixes     Reports every stored key which is a
+ *                                  prefix of the given input, shortest first.
+ * @param [in]tree                  The tree.
+ * @param [in]input                 The input.
+ * @param [in]input_len             Length of the input.
+ * @param [in]callback              The callback receiving the matches. The
+ *                                  key given to it points into the input.
+ * @param [in]context               User context passed to the callback.
+ * @return                          Number of the reported matches.
+ */
+size_t ec_radix_all_prefixes(const ec_radix_tree *tree, const char *input,
+                             size_t input_len, ec_radix_callback_t callback,
+                             void *context);
+
+/**
+ * @brief ec_radix_for_each     Visits all the stored keys in lexicographical
+ *                              order.
+ * @param [in]tree              The tree.
+ * @param [in]callback          The callback receiving the keys.
+ * @param [in]context           User context passed to the callback.
+ * @return                      false if the callback stopped the iteration or
+ *                              the memory allocation failed.
+ */
+bool ec_radix_for_each(const ec_radix_tree *tree, ec_radix_callback_t callback,
+                       void *context);
+
+/**
+ * @brief ec_radix_prefix_scan  Visits all the stored keys starting with the
+ *                              given prefix, in lexicographical order.
+ * @param [in]tree              The tree.
+ * @param [in]prefix            The prefix.
+ * @param [in]prefix_len        Length of the prefix.
+ * @param [in]callback          The callback receiving the keys.
+ * @param [in]context           User context passed to the callback.
+ * @return                      false if the callback stopped the iteration or
+ *                              the memory allocation failed.
+ */
+bool ec_radix_prefix_scan(const ec_radix_tree *tree, const char *prefix,
+                          size_t prefix_len, ec_radix_callback_t callback,
+                          void *context);
+
+#define ec_radix_size(_tree)        ((_tree)->size)
+
+#define ec_radix_insert_str(_tree, _key, _value)                               \
+        ec_radix_insert(_tree, _key, strlen(_key), _value)
+
+#define ec_radix_find_str(_tree, _key, _value)                                 \
+        ec_radix_find(_tree, _key, strlen(_key), _value)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,302 @@
+/* <sstring.h> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef ECLIBC_SSTRING_H
+#define ECLIBC_SSTRING_H 1
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ec/string.h>
+#include <ec/strbuf.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Since different compilers and different platforms implement NULL in a
+ * different manner, EC_NULL is a helping macro to unify the NULL pointer over
+ * all platforms.
+ * E.g. some platforms have __builtin_null (like XC16) and some define it the
+ *      same exact way.
+ */
+#ifndef EC_NULL
+#define EC_NULL ((void *)0)
+#endif
+
+/* All CPP compilers on the other hand, use the same exact NULL pointer on all
+ * platforms. So, there is no need to change the course of standard C++ library.
+ */
+#ifdef __cplusplus
+#undef EC_NULL
+#define EC_NULL NULL
+#endif
+
+/**
+ *****************************************************************************
+ **                                                                         **
+ **                          How to use this API                            **
+ **                                                                         **
+ *****************************************************************************
+ *****************************************************************************
+ **                                                                         **
+ ** ec_sstring is an owned, NUL terminated string which keeps short strings **
+ ** inside the structure itself: up to 23 bytes on 64 bit platforms (11 on  **
+ ** 32 bit ones) never touch the heap. Longer strings move to the heap. The **
+ ** length is always cached.                                                **
+ **                                                                         **
+ **      ec_sstring name;                                                   **
+ **      ec_sstring_init(&name);                                            **
+ **      ec_sstring_assign_str(&name, "eth0");                              **
+ **      ec_sstring_append_fmt(&name, ":%d", 1);                            **
+ **      ec_printf("%s\n", ec_sstring_cstr(&name));                         **
+ **      ec_sstring_delete(&name);                                          **
+ **                                                                         **
+ ** An ec_sstring must not be copied with "=" once it may be on the heap;  **
+ ** both copies would own the same memory. Use ec_sstring_move to hand the **
+ ** string over (the source is left empty), ec_sstring_steal to take a     **
+ ** plain heap string out of it, and ec_sstring_from_strbuf to take over   **
+ ** the result of an ec_strbuf without copying it.                          **
+ **                                                                         **
+ ** ec_sstring_view gives an ec_strview of the string for the ec_strview_* **
+ ** functions and ec_strbuf_append_view.                                    **
+ **                                                                         **
+ *****************************************************************************
+ *****************************************************************************
+ **/
+
+typedef union
+{
+    struct
+    {
+        char   *ptr;
+        size_t  len;
+        /* Capacity excluding the NUL terminator, tagged as heap storage. */
+        size_t  cap;
+    } heap;
+    /* The inline string. Its last byte holds the unused inline capacity, so
+     * it becomes the NUL terminator of a full inline string. On the heap,
+     * the same byte has the 0x80 bit set by the capacity tag. */
+    char small[3 * sizeof(size_t)];
+} ec_sstring;
+
+/* Number of characters stored without a heap allocation. */
+#define EC_SSTRING_INLINE_CAPACITY  (sizeof(ec_sstring) - 1)
+
+#define __ec_sstring_tag(_str)                                                 \
+        ((uint8_t)(_str)->small[EC_SSTRING_INLINE_CAPACITY])
+
+/**
+ * @brief ec_sstring_init       Initializes an empty string.
+ * @param [out]str              The string.
+ */
+static inline void
+__attribute__ ((unused, always_inline))
+ec_sstring_init(ec_sstring *str)
+{
+    str->small[0] = '\0';
+    str->small[EC_SSTRING_INLINE_CAPACITY] = (char)EC_SSTRING_INLINE_CAPACITY;
+}
+
+/**
+ * @brief ec_sstring_is_inline  Tells if the string is stored inline.
+ * @param [in]str               The string.
+ * @return                      true if the string doesn't use the heap.
+ */
+static inline bool
+__attribute__ ((unused, always_inline))
+ec_sstring_is_inline(const ec_sstring *str)
+{
+    return (__ec_sstring_tag(str) & 0x80U) == 0;
+}
+
+/**
+ * @brief ec_sstring_len        Returns the cached length of the string.
+ * @param [in]str               The string.
+ * @return                      The length, excluding the NUL terminator.
+ */
+static inline size_t
+__attribute__ ((unused, always_inline))
+ec_sstring_len(const ec_sstring *str)
+{
+    return ec_sstring_is_inline(str) ?
+                    EC_SSTRING_INLINE_CAPACITY - __ec_sstring_tag(str) :
+                    str->heap.len;
+}
+
+/**
+ * @brief ec_sstring_cstr       Returns the NUL terminated string.
+ * @param [in]str               The string.
+ * @return                      The pointer to the string. It is invalidated
+ *                              by any modification of the string.
+ */
+static inline const char *
+__attribute__ ((unused, always_inline))
+ec_sstring_cstr(const ec_sstring *str)
+{
+    return ec_sstring_is_inline(str) ? str->small : str->heap.ptr;
+}
+
+/**
+ * @brief ec_sstring_view       Returns a view of the string.
+ * @param [in]str               The string.
+ * @return                      The view. It is invalidated by any
+ *                              modification of the string.
+ */
+static inline ec_strview
+__attribute__ ((unused, always_inline))
+ec_sstring_view(const ec_sstring *str)
+{
+    return ec_strview_make(ec_sstring_cstr(str), ec_sstring_len(str));
+}
+
+/**
+ * @brief ec_sstring_delete     Releases the heap memory of the string, if
+ *                              any, and leaves it empty.
+ * @param [in]str               The string.
+ */
+void ec_sstring_delete(ec_sstring *str);
+
+/**
+ * @brief ec_sstring_reserve    Makes sure the string can grow to the given
+ *                              length without another allocation.
+ * @param [in]str               The string.
+ * @param [in]capacity          The length, excluding the NUL terminator.
+ * @return                      false if the allocation failed.
+ */
+bool ec_sstring_reserve(ec_sstring *str, size_t capacity);
+
+/**
+ * @brief ec_sstring_assign     Replaces the content of the string.
+ * @param [in]str               The string.
+ * @param [in]ptr               The new content. It must not point into the
+ *                              string itself.
+ * @param [in]len               Length of the new content.
+ * @return                      false if the allocation failed, in which case
+ *                              the string is left unchanged.
+ */
+bool ec_sstring_assign(ec_sstring *str, const char *ptr, size_t len);
+
+/**
+ * @brief ec_sstring_append     Appends to the string.
+ * @param [in]str               The string.
+ * @param [in]ptr               The content to append. It must not point into
+ *                              the string itself.
+ * @param [in]len               Length of the content.
+ * @return                      false if the allocation failed, in which case
+ *                              the string is left unchanged.
+ */
+bool ec_sstring_append(ec_sstring *str, const char *ptr, size_t len);
+
+/**
+ * @brief ec_sstring_append_fmt Appends a formatted string. Supports the same
+ *                              format specifiers as ec_printf.
+ * @param [in]str               The string.
+ * @param [in]format            The format string.
+ * @return                      false if the allocation failed.
+ */
+bool ec_sstring_append_fmt(ec_sstring *str, const char *format, ...);
+
+/**
+ * @brief ec_sstring_move       Moves the string from "src" to "dst". "dst" is
+ *                              released first and "src" is left empty.
+ *                              Nothing is allocated or copied but the
+ *                              structure itself.
+ * @param [in]dst               The destination string.
+ * @param [in]src               The source string.
+ */
+void ec_sstring_move(ec_sstring *dst, ec_sstring *src);
+
+/**
+ * @brief ec_sstring_steal      Hands the string over to the caller and leaves
+ *                              it empty. The result is always on the heap and
+ *                              must be released using free().
+ * @param [in]str               The string.
+ * @param [out]len              Receives the length. Can be EC_NULL.
+ * @return                      The string, or EC_NULL if the allocation
+ *                              failed.
+ */
+char *ec_sstring_steal(ec_sstring *str, size_t *len);
+
+/**
+ * @brief ec_sstring_from_strbuf    Replaces the content of the string with
+ *                                  the content of the builder, and leaves the
+ *                                  builder empty. A heap allocated builder
+ *                                  hands its memory over without a copy.
+ * @param [in]str                   The string.
+ * @param [in]buf                   The builder.
+ * @return                          false if the allocation failed.
+ */
+bool ec_sstring_from_strbuf(ec_sstring *str, ec_strbuf *buf);
+
+/**
+ * @brief ec_sstring_append_char    Appends a character.
+ * @param [in]str                   The string.
+ * @param [in]character             The character.
+ * @return                          false if the allocation failed.
+ */
+static inline bool
+__attribute__ ((unused, always_inline))
+ec_sstring_append_char(ec_sstring *str, char character)
+{
+    return ec_sstring_append(str, &character, 1);
+}
+
+/**
+ * @brief ec_sstring_clear      Empties the string, keeping its capacity.
+ * @param [in]str               The string.
+ */
+static inline void
+__attribute__ ((unused, always_inline))
+ec_sstring_clear(ec_sstring *str)
+{
+    if(ec_sstring_is_inline(str))
+        ec_sstring_init(str);
+    else
+    {
+        str->heap.len = 0;
+        str->heap.ptr[0] = '\0';
+    }
+}
+
+#define ec_sstring_assign_str(_str, _cstr)                                     \
+        ec_sstring_assign(_str, _cstr, strlen(_cstr))
+
+#define ec_sstring_assign_view(_str, _view)                                    \
+        ec_sstring_assign(_str, (_view).ptr, (_view).len)
+
+#define ec_sstring_append_str(_str, _cstr)                                     \
+        ec_sstring_append(_str, _cstr, strlen(_cstr))
+
+#define ec_sstring_append_view(_str, _view)                                    \
+        ec_sstring_append(_str, (_view).ptr, (_view).len)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,388 @@
+/* <strbuf.h> -*- C -*- */
+/**
+ ** @copyright
+ ** This file is part of the "eclibc" project.
+ ** Copyright (C) 2022 ExoticCandy
+ ** @email  admin@ecandy.ir
+ **
+ ** Project's home page:
+ ** https://github.com/ExoticCandyC/eclibc
+ **
+ ** This program is free software: you can redistribute it and/or modify
+ ** it under the terms of the GNU General Public License as published by
+ ** the Free Software Foundation, either version 3 of the License, or
+ ** (at your option) any later version.
+ **
+ ** This program is distributed in the hope that it will be useful,
+ ** but WITHOUT ANY WARRANTY; without even the implied warranty of
+ ** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ ** GNU General Public License for more details.
+ **
+ ** You should have received a copy of the GNU General Public License
+ ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef ECLIBC_STRBUF_H
+#define ECLIBC_STRBUF_H 1
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ec/string.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Since different compilers and different platforms implement NULL in a
+ * different manner, EC_NULL is a helping macro to unify the NULL pointer over
+ * all platforms.
+ * E.g. some platforms have __builtin_null (like XC16) and some define it the
+ *      same exact way.
+ */
+#ifndef EC_NULL
+#define EC_NULL ((void *)0)
+#endif
+
+/* All CPP compilers on the other hand, use the same exact NULL pointer on all
+ * platforms. So, there is no need to change the course of standard C++ library.
+ */
+#ifdef __cplusplus
+#undef EC_NULL
+#define EC_NULL NULL
+#endif
+
+/**
+ *****************************************************************************
+ **                                                                         **
+ **                          How to use this API                            **
+ **                                                                         **
+ *****************************************************************************
+ *****************************************************************************
+ **                                                                         **
+ ** ec_strbuf is a string builder. It caches the length and the capacity of **
+ ** the string, so appending never rescans the string the way strcat does, **
+ ** and it grows geometrically, so appending is amortized O(1) per byte.    **
+ ** The string is always kept NUL terminated.                               **
+ **                                                                         **
+ ** There are four ways to initialize a builder:                            **
+ **     1) ec_strbuf_init(&$BUF$)                                           **
+ **             starts empty and allocates on the first append.             **
+ **     2) ec_strbuf_init_inline(&$BUF$, $STORAGE$, sizeof($STORAGE$))      **
+ **             uses the given (e.g. stack) storage first and moves to the  **
+ **             heap only if the string outgrows it.                        **
+ **     3) ec_strbuf_init_fixed(&$BUF$, $STORAGE$, sizeof($STORAGE$))       **
+ **             never grows. Anything not fitting the storage is dropped.   **
+ **     4) ec_strbuf_init_sink(&$BUF$, $STORAGE$, sizeof($STORAGE$),        **
+ **                                                  $SINK$, $CONTEXT$)     **
+ **             never grows either. Whenever the storage is full, its       **
+ **             content is handed to the sink and the storage is reused.    **
+ **             Call ec_strbuf_flush(&$BUF$) to hand over the rest.         **
+ **                                                                         **
+ ** The builder is also a printf sink:                                      **
+ **      ec_strbuf_append_fmt(&$BUF$, "%d %!i", 42, ip);                    **
+ ** supports the exact same format specifiers as ec_printf.                 **
+ **                                                                         **
+ ** When done, either take the heap string with ec_strbuf_detach, or call  **
+ ** ec_strbuf_delete to release the memory.                                 **
+ **                                                                         **
+ *****************************************************************************
+ *****************************************************************************
+ **/
+
+/* The data is allocated by the builder and released by ec_strbuf_delete. */
+#define EC_STRBUF_HEAP              0x01U
+/* The data can not grow. Appends not fitting the storage are truncated. */
+#define EC_STRBUF_FIXED             0x02U
+/* Some appends were dropped, either because a memory allocation failed or
+ * because the fixed storage was full. */
+#define EC_STRBUF_FAILED            0x04U
+
+/* The data is handed to a sink function whenever the storage is full. */
+#define EC_STRBUF_SINK              0x08U
+
+/**
+ * @brief ec_strbuf_sink_t      Receives the content of a sink builder.
+ * @param [in]context           The context given to ec_strbuf_init_sink.
+ * @param [in]data              The characters. Not NUL terminated.
+ * @param [in]len               Number of the characters.
+ * @return                      false if the characters could not be written.
+ */
+typedef bool (*ec_strbuf_sink_t)(void *context, const char *data, size_t len);
+
+typedef struct
+{
+    char    *data;
+    /* Length of the string, excluding the NUL terminator. */
+    size_t   len;
+    /* Size of the storage, including the NUL terminator. */
+    size_t   cap;
+    uint8_t  flags;
+    /* Only used by the sink builders. */
+    ec_strbuf_sink_t sink;
+    void    *context;
+    /* Number of the characters which did not fit, see EC_STRBUF_FAILED. */
+    size_t   dropped;
+} ec_strbuf;
+
+/**
+ * @brief ec_strbuf_init        Initializes an empty builder. Nothing is
+ *                              allocated until the first append.
+ * @param [out]buf              The builder.
+ */
+void ec_strbuf_init(ec_strbuf *buf);
+
+/**
+ * @brief ec_strbuf_init_inline Initializes a builder using the given storage
+ *                              until the string outgrows it, at which point
+ *                              the string moves to the heap.
+ * @param [out]buf              The builder.
+ * @param [in]storage           The initial storage. It must outlive the
+ *                              builder, or at least its use of the storage.
+ * @param [in]size              Size of the storage in bytes. Must be > 0.
+ */
+void ec_strbuf_init_inline(ec_strbuf *buf, char *storage, size_t size);
+
+/**
+ * @brief ec_strbuf_init_fixed  Initializes a builder which never grows beyond
+ *                              the given storage. Appends are truncated to
+ *                              fit, and the string stays NUL terminated.
+ * @param [out]buf              The builder.
+ * @param [in]storage           The storage.
+ * @param [in]size              Size of the storage in bytes. Must be > 0.
+ */
+void ec_strbuf_init_fixed(ec_strbuf *buf, char *storage, size_t size);
+
+/**
+ * @brief ec_strbuf_init_sink   Initializes a builder which collects the
+ *                              appended characters in the given storage and
+ *                              hands them to the sink each time the storage
+ *                              fills up, e.g. to write them to a file in big
+ *                              chunks instead of one character at a time.
+ * @param [out]buf              The builder.
+ * @param [in]storage           The storage.
+ * @param [in]size              Size of the storage in bytes. Must be > 1.
+ * @param [in]sink              The function receiving the characters.
+ * @param [in]context           Passed to the sink as is.
+ */
+void ec_strbuf_init_sink(ec_strbuf *buf, char *storage, size_t size,
+                                        ec_strbuf_sink_t sink, void *context);
+
+/**
+ * @brief ec_strbuf_flush       Hands the collected characters of a sink
+ *                              builder to its sink and empties the builder.
+ *                              Does nothing for the other builders.
+ * @param [in]buf               The builder.
+ * @return                      false if the sink failed, now or before.
+ */
+bool ec_strbuf_flush(ec_strbuf *buf);
+
+/**
+ * @brief ec_strbuf_delete      Releases the heap memory of the builder, if
+ *                              any, and leaves it empty.
+ * @param [in]buf               The builder.
+ */
+void ec_strbuf_delete(ec_strbuf *buf);
+
+/**
+ * @brief ec_strbuf_reserve     Makes sure the given number of bytes can be
+ *                              appended without another allocation.
+ * @param [in]buf               The builder.
+ * @param [in]extra             Number of the bytes to be appended.
+ * @return                      false if the allocation failed or the builder
+ *                              is fixed and too small.
+ */
+bool ec_strbuf_reserve(ec_strbuf *buf, size_t extra);
+
+/**
+ * @brief ec_strbuf_detach      Hands the string over to the caller and leaves
+ *                              the builder empty. The string is always on the
+ *                              heap and must be released using free().
+ * @param [in]buf               The builder.
+ * @param [out]len              Receives the length of the string. Can be
+ *                              EC_NULL.
+ * @return                      The string, or EC_NULL if the allocation
+ *                              failed.
+ */
+char *ec_strbuf_detach(ec_strbuf *buf, size_t *len);
+
+/**
+ * @brief ec_strbuf_append_fmt  Appends a formatted string. Supports the same
+ *                              format specifiers as ec_printf.
+ * @param [in]buf               The builder.
+ * @param [in]format            The format string.
+ * @return                      false if some of the output was dropped.
+ */
+bool ec_strbuf_append_fmt(ec_strbuf *buf, const char *format, ...);
+
+/**
+ * @brief ec_strbuf_append_vfmt The va_list variant of ec_strbuf_append_fmt.
+ */
+bool ec_strbuf_append_vfmt(ec_strbuf *buf, const char *format, va_list arg);
+
+/* Hex dump layouts. */
+/* The bytes separated by spaces, e.g. "de ad be ef". */
+#define EC_HEXDUMP_SPACED           0x00U
+/* The layout of "hexdump -C": lines of 16 bytes starting with their offset
+ * and ending with the printable characters between '|'s. */
+#define EC_HEXDUMP_CLASSIC          0x01U
+
+/**
+ * @brief ec_strbuf_append_hex  Appends the bytes as hexadecimal digits, see
+ *                              ec_hex_encode.
+ * @param [in]buf               The builder.
+ * @param [in]src               The bytes.
+ * @param [in]len               Number of the bytes.
+ * @param [in]upper_case        true for "ABCDEF", false for "abcdef".
+ * @return                      false if some of the output was dropped.
+ */
+bool ec_strbuf_append_hex(ec_strbuf *buf, const void *src, size_t len,
+                                                            bool upper_case);
+
+/**
+ * @brief ec_strbuf_append_hexdump Appends a hex dump of the bytes.
+ * @param [in]buf               The builder.
+ * @param [in]src               The bytes.
+ * @param [in]len               Number of the bytes.
+ * @param [in]mode              EC_HEXDUMP_SPACED or EC_HEXDUMP_CLASSIC.
+ * @return                      false if some of the output was dropped.
+ */
+bool ec_strbuf_append_hexdump(ec_strbuf *buf, const void *src, size_t len,
+                                                                unsigned mode);
+
+/**
+ * @brief ec_strbuf_append_base64 Appends the bytes base64 encoded, see
+ *                              ec_base64_encode.
+ * @param [in]buf               The builder.
+ * @param [in]src               The bytes.
+ * @param [in]len               Number of the bytes.
+ * @param [in]mode              EC_BASE64_STANDARD or EC_BASE64_URL.
+ * @return                      false if some of the output was dropped.
+ */
+bool ec_strbuf_append_base64(ec_strbuf *buf, const void *src, size_t len,
+                                                                unsigned mode);
+
+/* Slow path of the appends: grows or truncates, then appends. */
+bool __ec_strbuf_append_slow(ec_strbuf *buf, const char *ptr, size_t len);
+bool __ec_strbuf_repeat_slow(ec_strbuf *buf, char character, size_t count);
+
+/**
+ * @brief ec_strbuf_append_n    Appends the given characters.
+ * @param [in]buf               The builder.
+ * @param [in]ptr               The characters.
+ * @param [in]len               Number of the characters.
+ * @return                      false if the characters did not fit.
+ */
+static inline bool
+__attribute__ ((unused, always_inline))
+ec_strbuf_append_n(ec_strbuf *buf, const char *ptr, size_t len)
+{
+    if(len >= buf->cap - buf->len)
+        return __ec_strbuf_append_slow(buf, ptr, len);
+    memcpy(buf->data + buf->len, ptr, len);
+    buf->len += len;
+    buf->data[buf->len] = '\0';
+    return true;
+}
+
+/**
+ * @brief ec_strbuf_append_char Appends a single character.
+ * @param [in]buf               The builder.
+ * @param [in]character         The character.
+ * @return                      false if the character did not fit.
+ */
+static inline bool
+__attribute__ ((unused, always_inline))
+ec_strbuf_append_char(ec_strbuf *buf, char character)
+{
+    if(1 >= buf->cap - buf->len)
+        return __ec_strbuf_append_slow(buf, &character, 1);
+    buf->data[buf->len++] = character;
+    buf->data[buf->len] = '\0';
+    return true;
+}
+
+/**
+ * @brief ec_strbuf_append_repeat   Appends a character several times, e.g.
+ *                                  padding.
+ * @param [in]buf                   The builder.
+ * @param [in]character             The character.
+ * @param [in]count                 Number of the repetitions.
+ * @return                          false if the characters did not fit.
+ */
+static inline bool
+__attribute__ ((unused, always_inline))
+ec_strbuf_append_repeat(ec_strbuf *buf, char character, size_t count)
+{
+    if(count >= buf->cap - buf->len)
+        return __ec_strbuf_repeat_slow(buf, character, count);
+    memset(buf->data + buf->len, character, count);
+    buf->len += count;
+    buf->data[buf->len] = '\0';
+    return true;
+}
+
+/**
+ * @brief ec_strbuf_append      Appends a NUL terminated string.
+ * @param [in]buf               The builder.
+ * @param [in]str               The string.
+ * @return                      false if the string did not fit.
+ */
+static inline bool
+__attribute__ ((unused, always_inline))
+ec_strbuf_append(ec_strbuf *buf, const char *str)
+{
+    return ec_strbuf_append_n(buf, str, strlen(str));
+}
+
+/**
+ * @brief ec_strbuf_append_view Appends the characters of a string view.
+ * @param [in]buf               The builder.
+ * @param [in]view              The view.
+ * @return                      false if the characters did not fit.
+ */
+static inline bool
+__attribute__ ((unused, always_inline))
+ec_strbuf_append_view(ec_strbuf *buf, ec_strview view)
+{
+    return ec_strbuf_append_n(buf, view.ptr, view.len);
+}
+
+/**
+ * @brief ec_strbuf_clear       Empties the string, keeping the storage.
+ * @param [in]buf               The builder.
+ */
+static inline void
+__attribute__ ((unused, always_inline))
+ec_strbuf_clear(ec_strbuf *buf)
+{
+    buf->len = 0;
+    if(buf->cap > 0)
+        buf->data[0] = '\0';
+}
+
+/**
+ * @brief ec_strbuf_view        Returns a view over the current string.
+ * @param [in]buf               The builder.
+ * @return                      The view.
+ */
+static inline ec_strview
+__attribute__ ((unused, always_inline))
+ec_strbuf_view(const ec_strbuf *buf)
+{
+    return ec_strview_make(buf->data, buf->len);
+}
+
+#define ec_strbuf_len(_buf)         ((_buf)->len)
+
+#define ec_strbuf_cstr(_buf)                                                   \
+        (((_buf)->cap > 0) ? (const char *)(_buf)->data : "")
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -23,6 +23,8 @@
  **/
 
 #include <string.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
 #include <ec/internal/vsprintf_internal.h>
 
@@ -52,6 +54,330 @@ extern "C"
 #define EC_NULL NULL
 #endif
 
+/**
+ * ec_strview is a non-owning view over a run of characters. It carries its own
+ * length, so none of the operations below ever rescan the string to find a NUL
+ * terminator, and views can point into the middle of larger buffers. The
+ * characters are not required to be NUL terminated.
+ */
+typedef struct
+{
+    const char *ptr;
+    size_t      len;
+} ec_strview;
+
+/* Returned by the search functions when nothing is found. */
+#define EC_STRVIEW_NPOS             ((size_t)-1)
+
+/* Builds a view over a string literal without calling strlen. */
+#define ec_strview_literal(_str)                                               \
+        ec_strview_make("" _str, sizeof(_str) - 1)
+
+/**
+ * @brief ec_strview_make       Builds a view over the given characters.
+ * @param [in]ptr               The first character.
+ * @param [in]len               Number of the characters.
+ * @return                      The view.
+ */
+static inline ec_strview
+__attribute__ ((unused, always_inline))
+ec_strview_make(const char *ptr, size_t len)
+{
+    ec_strview view;
+    view.ptr = ptr;
+    view.len = len;
+    return view;
+}
+
+/**
+ * @brief ec_strview_from_cstr  Builds a view over a NUL terminated string.
+ *                              This is the only place the length is measured.
+ * @param [in]str               The string.
+ * @return                      The view.
+ */
+static inline ec_strview
+__attribute__ ((unused, always_inline))
+ec_strview_from_cstr(const char *str)
+{
+    return ec_strview_make(str, strlen(str));
+}
+
+/**
+ * @brief ec_strview_slice      Returns the characters [start, end) of the view.
+ *                              Both bounds are clamped to the view, so the
+ *                              result is always valid.
+ * @param [in]view              The view.
+ * @param [in]start             Index of the first character.
+ * @param [in]end               Index after the last character. EC_STRVIEW_NPOS
+ *                              means the end of the view.
+ * @return                      The sliced view.
+ */
+static inline ec_strview
+__attribute__ ((unused, always_inline))
+ec_strview_slice(ec_strview view, size_t start, size_t end)
+{
+    if(end > view.len)
+        end = view.len;
+    if(start > end)
+        start = end;
+    return ec_strview_make(view.ptr + start, end - start);
+}
+
+/**
+ * @brief ec_strview_equals     Checks if two views hold the same characters.
+ * @param [in]first             The first view.
+ * @param [in]second            The second view.
+ * @return                      true if they are equal.
+ */
+bool ec_strview_equals(ec_strview first, ec_strview second);
+
+/**
+ * @brief ec_strview_compare    Compares two views lexicographically, the same
+ *                              way memcmp does. A view which is a prefix of
+ *                              the other one is the smaller one.
+ * @param [in]first             The first view.
+ * @param [in]second            The second view.
+ * @return                      <0, 0 or >0 if first is less than, equal to or
+ *                              greater than second.
+ */
+int ec_strview_compare(ec_strview first, ec_strview second);
+
+/**
+ * @brief ec_strview_starts_with    Checks if the view starts with the prefix.
+ * @param [in]view                  The view.
+ * @param [in]prefix                The prefix.
+ * @return                          true if view starts with prefix.
+ */
+bool ec_strview_starts_with(ec_strview view, ec_strview prefix);
+
+/**
+ * @brief ec_strview_ends_with  Checks if the view ends with the suffix.
+ * @param [in]view              The view.
+ * @param [in]suffix            The suffix.
+ * @return                      true if view ends with suffix.
+ */
+bool ec_strview_ends_with(ec_strview view, ec_strview suffix);
+
+/**
+ * @brief ec_strview_find_char  Finds the first occurrence of a character.
+ * @param [in]view              The view to be searched.
+ * @param [in]ch                The character.
+ * @return                      Index of the character, or EC_STRVIEW_NPOS.
+ */
+size_t ec_strview_find_char(ec_strview view, char ch);
+
+/**
+ * @brief ec_strview_rfind_char Finds the last occurrence of a character.
+ * @param [in]view              The view to be searched.
+ * @param [in]ch                The character.
+ * @return                      Index of the character, or EC_STRVIEW_NPOS.
+ */
+size_t ec_strview_rfind_char(ec_strview view, char ch);
+
+/**
+ * @brief ec_strview_find       Finds the first occurrence of the needle.
+ * @param [in]view              The view to be searched.
+ * @param [in]needle            The needle. An empty needle matches at 0.
+ * @return                      Index of the needle, or EC_STRVIEW_NPOS.
+ */
+size_t ec_strview_find(ec_strview view, ec_strview needle);
+
+/**
+ * @brief ec_strview_rfind      Finds the last occurrence of the needle.
+ * @param [in]view              The view to be searched.
+ * @param [in]needle            The needle. An empty needle matches at the end.
+ * @return                      Index of the needle, or EC_STRVIEW_NPOS.
+ */
+size_t ec_strview_rfind(ec_strview view, ec_strview needle);
+
+/**
+ * @brief ec_strview_trim       Removes the leading and trailing white spaces
+ *                              (" \t\n\v\f\r").
+ * @param [in]view              The view.
+ * @return                      The trimmed view.
+ */
+ec_strview ec_strview_trim(ec_strview view);
+
+/**
+ * @brief ec_strview_ltrim      Removes the leading white spaces.
+ * @param [in]view              The view.
+ * @return                      The trimmed view.
+ */
+ec_strview ec_strview_ltrim(ec_strview view);
+
+/**
+ * @brief ec_strview_rtrim      Removes the trailing white spaces.
+ * @param [in]view              The view.
+ * @return                      The trimmed view.
+ */
+ec_strview ec_strview_rtrim(ec_strview view);
+
+/**
+ * @brief ec_strview_split      Pops the next field off the view, splitting on
+ *                              the given delimiter. Empty fields are kept, so
+ *                              "a,,b," yields "a", "", "b" and "".
+ * @param [in,out]rest          The remaining characters. After the last field
+ *                              is returned, its ptr is set to EC_NULL.
+ * @param [in]delimiter         The delimiter.
+ * @param [out]field            Receives the field.
+ * @return                      false when there are no more fields.
+ * @example
+ *      ec_strview rest = ec_strview_literal("a,b"), field;
+ *      while(ec_strview_split(&rest, ',', &field))
+ *          ...
+ */
+bool ec_strview_split(ec_strview *rest, char delimiter, ec_strview *field);
+
+/**
+ * @brief ec_memmem         Finds the first occurrence of the needle inside the
+ *                          haystack. Candidates are filtered by comparing the
+ *                          first and the last byte of the needle on a whole
+ *                          vector of positions at once. Needles producing too
+ *                          many false candidates switch to the Two-Way
+ *                          algorithm, so the search is always linear.
+ * @param [in]haystack      The memory to be searched.
+ * @param [in]haystack_len  Length of the haystack.
+ * @param [in]needle        The needle.
+ * @param [in]needle_len    Length of the needle. An empty needle matches at
+ *                          the beginning of the haystack.
+ * @return                  Pointer to the match, or EC_NULL.
+ */
+void *ec_memmem(const void *haystack, size_t haystack_len,
+                const void *needle, size_t needle_len);
+
+/**
+ * @brief ec_str_find       Finds a NUL terminated needle inside a haystack of
+ *                          known length. Unlike strstr, the haystack does not
+ *                          need to be NUL terminated and is never scanned for
+ *                          its terminator.
+ * @param [in]haystack      The buffer to be searched.
+ * @param [in]haystack_len  Length of the buffer.
+ * @param [in]needle        The NUL terminated needle.
+ * @return                  Pointer to the match, or EC_NULL.
+ */
+const char *ec_str_find(const char *haystack, size_t haystack_len,
+                        const char *needle);
+
+/**
+ * @brief ec_memchr2        Finds the first byte equal to either of the given
+ *                          characters.
+ * @param [in]ptr           The memory to be searched.
+ * @param [in]ch1           The first character.
+ * @param [in]ch2           The second character.
+ * @param [in]len           Length of the memory.
+ * @return                  Pointer to the found byte, or EC_NULL.
+ */
+void *ec_memchr2(const void *ptr, int ch1, int ch2, size_t len);
+
+/**
+ * @brief ec_memchr3        Finds the first byte equal to any of the three given
+ *                          characters.
+ * @param [in]ptr           The memory to be searched.
+ * @param [in]ch1           The first character.
+ * @param [in]ch2           The second character.
+ * @param [in]ch3           The third character.
+ * @param [in]len           Length of the memory.
+ * @return                  Pointer to the found byte, or EC_NULL.
+ */
+void *ec_memchr3(const void *ptr, int ch1, int ch2, int ch3, size_t len);
+
+/* The size of "len" bytes once hex encoded. */
+#define EC_HEX_ENCODED_SIZE(len)        (2 * (len))
+/* The largest possible size of "len" bytes once base64 encoded. */
+#define EC_BASE64_ENCODED_SIZE(len)     ((((len) + 2) / 3) * 4)
+
+/* Base64 alphabets. */
+/* RFC 4648 section 4: '+' and '/', padded with '=' to a multiple of 4. */
+#define EC_BASE64_STANDARD          0x00U
+/* RFC 4648 section 5: '-' and '_', not padded. Safe in URLs and names. */
+#define EC_BASE64_URL               0x01U
+
+/**
+ * @brief ec_hex_encode     Writes the two hexadecimal digits of each byte,
+ *                          16 bytes at a time where there is a vector unit.
+ * @param [out]dst          The destination, with room for
+ *                          EC_HEX_ENCODED_SIZE(len) characters. It is not NUL
+ *                          terminated.
+ * @param [in]src           The bytes.
+ * @param [in]len           Number of the bytes.
+ * @param [in]upper_case    true for "ABCDEF", false for "abcdef".
+ * @return                  Number of the characters written.
+ */
+size_t ec_hex_encode(char *dst, const void *src, size_t len, bool upper_case);
+
+/**
+ * @brief ec_base64_encode  Encodes bytes in base64.
+ * @param [out]dst          The destination, with room for
+ *                          EC_BASE64_ENCODED_SIZE(len) characters. It is not
+ *                          NUL terminated.
+ * @param [in]src           The bytes.
+ * @param [in]len           Number of the bytes.
+ * @param [in]mode          EC_BASE64_STANDARD or EC_BASE64_URL.
+ * @return                  Number of the characters written.
+ */
+size_t ec_base64_encode(char *dst, const void *src, size_t len, unsigned mode);
+
+/* Tokenizer modes. */
+/* Fields are separated by a single delimiter character. */
+#define EC_TOKENIZE_CHAR            0x00U
+/* Fields are separated by any of the characters of the delimiter set. */
+#define EC_TOKENIZE_SET             0x01U
+/* Fields are separated by runs of white spaces (" \t\n\v\f\r"). Leading and
+ * trailing white spaces are ignored. Implies EC_TOKENIZE_COLLAPSE. */
+#define EC_TOKENIZE_WHITESPACE      0x02U
+/* Can be OR'ed with the modes above to treat consecutive delimiters as one
+ * and drop the empty fields, the same way strtok does. */
+#define EC_TOKENIZE_COLLAPSE        0x10U
+
+/**
+ * ec_tokenizer walks over a string view and yields its fields as views into
+ * the original string. Unlike strtok, it never writes into the string and
+ * keeps all its state in the structure, so it is reentrant and thread-safe.
+ * Delimiters are located a whole vector (16 or 32 bytes) at a time.
+ */
+typedef struct
+{
+    const char *ptr;
+    const char *end;
+    uint8_t     mode;
+    /* Number of the characters in "set". Larger sets only use "table". */
+    uint8_t     set_len;
+    char        set[16];
+    /* Bitmap of the delimiter characters, one bit per byte value. */
+    uint8_t     table[32];
+    bool        done;
+} ec_tokenizer;
+
+/**
+ * @brief ec_tokenizer_init     Prepares a tokenizer over the given string.
+ * @param [out]tokenizer        The tokenizer.
+ * @param [in]input             The string to be split. It must outlive the
+ *                              tokenizer and the returned fields.
+ * @param [in]mode              One of the EC_TOKENIZE_* modes, optionally
+ *                              combined with EC_TOKENIZE_COLLAPSE.
+ * @param [in]delimiters        The delimiter character (EC_TOKENIZE_CHAR) or
+ *                              the NUL terminated delimiter set
+ *                              (EC_TOKENIZE_SET). Ignored, and can be EC_NULL,
+ *                              in EC_TOKENIZE_WHITESPACE mode.
+ * @example
+ *      ec_tokenizer tokenizer;
+ *      ec_strview field;
+ *      ec_tokenizer_init(&tokenizer, ec_strview_from_cstr(line),
+ *                        EC_TOKENIZE_WHITESPACE, EC_NULL);
+ *      while(ec_tokenizer_next(&tokenizer, &field))
+ *          ...
+ */
+void ec_tokenizer_init(ec_tokenizer *tokenizer, ec_strview input,
+                       unsigned mode, const char *delimiters);
+
+/**
+ * @brief ec_tokenizer_next     Yields the next field.
+ * @param [in]tokenizer         The tokenizer.
+ * @param [out]field            Receives the field.
+ * @return                      false when there are no more fields.
+ */
+bool ec_tokenizer_next(ec_tokenizer *tokenizer, ec_strview *field);
+
 bool ec_str_starts_with(const char *ptr, const char *refference);
 
 #ifdef __cplusplus
@@ -22,6 +22,10 @@
  ** along with this program.  If not, see <http://www.gnu.org/licenses/>.
  **/
 
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <ec/strbuf.h>
 #include <ec/internal/vurlprintf_internal.h>
 
 #ifndef ECLIBC_URL_H
@@ -50,7 +54,211 @@ extern "C"
 #define EC_NULL NULL
 #endif
 
+/**
+ *****************************************************************************
+ **                                                                         **
+ **                           Percent-encoding                              **
+ **                                                                         **
+ *****************************************************************************
+ ** The encoder and the decoder work on buffers of known length and write   **
+ ** through a cursor, so their cost is linear in the size of the text. The  **
+ ** characters which stay as they are, are classified a whole vector (16    **
+ ** or 32 bytes) at a time and copied in blocks.                            **
+ **                                                                         **
+ **     char   encoded[EC_URL_ENCODED_SIZE(sizeof(name))];                  **
+ **     size_t len = ec_url_encode(encoded, name, strlen(name),             **
+ **                                                       EC_URL_FORM);     **
+ **                                                                         **
+ *****************************************************************************
+ *****************************************************************************
+ **/
+
+/* Encoding modes. */
+/* RFC 3986: everything but the unreserved characters, i.e. the letters, the
+ * digits and "-._~", is percent-encoded. Safe to use in any part of a URL. */
+#define EC_URL_COMPONENT            0x00U
+/* application/x-www-form-urlencoded: the same, except ' ' is encoded as '+'.
+ * When decoding, '+' is turned back into ' '. */
+#define EC_URL_FORM                 0x01U
+/* A path: the characters RFC 3986 allows in a path, i.e. '/', ':', '@' and
+ * the sub-delims "!$&'()*+,;=", are kept as well. */
+#define EC_URL_PATH                 0x02U
+/* A fragment: the same as EC_URL_PATH, and '?' is kept too. */
+#define EC_URL_FRAGMENT             0x04U
+
+/* The largest possible size of "len" characters once encoded. */
+#define EC_URL_ENCODED_SIZE(len)    (3 * (len))
+
+/**
+ * @brief ec_url_encode         Percent-encodes the given characters.
+ * @param [out]dst              The destination. Must have room for
+ *                              EC_URL_ENCODED_SIZE(len) characters. It is not
+ *                              NUL terminated.
+ * @param [in]src               The characters.
+ * @param [in]len               Number of the characters.
+ * @param [in]mode              EC_URL_COMPONENT, EC_URL_FORM, EC_URL_PATH or
+ *                              EC_URL_FRAGMENT.
+ * @return                      Number of the characters written.
+ */
+size_t ec_url_encode(char *dst, const char *src, size_t len, unsigned mode);
+
+/**
+ * @brief ec_url_decode         Decodes percent-encoded characters. Invalid
+ *                              escapes, e.g. "%zz" or a '%' at the very end,
+ *                              are copied as they are.
+ * @param [out]dst              The destination. Must have room for "len"
+ *                              characters, and can be the same as "src" to
+ *                              decode in place. It is not NUL terminated.
+ * @param [in]src               The characters.
+ * @param [in]len               Number of the characters.
+ * @param [in]mode              EC_URL_COMPONENT or EC_URL_FORM.
+ * @return                      Number of the characters written.
+ */
+size_t ec_url_decode(char *dst, const char *src, size_t len, unsigned mode);
+
+/**
+ * @brief ec_strbuf_append_url_encoded Appends the characters percent-encoded.
+ * @param [in]buf               The builder.
+ * @param [in]src               The characters.
+ * @param [in]len               Number of the characters.
+ * @param [in]mode              EC_URL_COMPONENT, EC_URL_FORM, EC_URL_PATH or
+ *                              EC_URL_FRAGMENT.
+ * @return                      false if some of the output was dropped.
+ */
+bool ec_strbuf_append_url_encoded(ec_strbuf *buf, const char *src, size_t len,
+                                                                unsigned mode);
+
+/**
+ * @brief ec_url_decode_view    Decodes a view, only when it has to.
+ * @param [in]view              The percent-encoded characters.
+ * @param [out]dst              The destination, with room for view.len
+ *                              characters. Only written to when the view
+ *                              holds a '%', or a '+' for EC_URL_FORM.
+ * @param [in]mode              EC_URL_COMPONENT or EC_URL_FORM.
+ * @return                      The view itself when there was nothing to
+ *                              decode, otherwise the decoded part of "dst".
+ */
+ec_strview ec_url_decode_view(ec_strview view, char *dst, unsigned mode);
+
+/**
+ *****************************************************************************
+ **                                                                         **
+ **                                Parsing                                  **
+ **                                                                         **
+ *****************************************************************************
+ ** ec_url_parse splits a URL, or a relative reference, into its parts as   **
+ ** described by RFC 3986:                                                  **
+ **                                                                         **
+ **     scheme://userinfo@host:port/path?query#fragment                     **
+ **                                                                         **
+ ** The parts are views into the parsed string, so nothing is allocated or  **
+ ** copied, and they are left percent-encoded. A missing part has a NULL    **
+ ** ptr, which tells "http://host/?" (an empty query) from "http://host/"   **
+ ** (no query at all). The delimiters are not part of the views, except    **
+ ** the brackets of IPv6 hosts and the leading '/' of the paths.            **
+ **                                                                         **
+ ** ec_url_query walks over the "key=value" pairs of a query. The pairs are **
+ ** views as well and are only decoded when ec_url_decode_view is called    **
+ ** on them, so looking for a single parameter costs nothing for the rest.  **
+ **                                                                         **
+ **     ec_url       url;                                                   **
+ **     ec_url_query query;                                                 **
+ **     ec_url_param param;                                                 **
+ **     char         value[256];                                            **
+ **     if(!ec_url_parse(&url, request_target))                             **
+ **         return false;                                                   **
+ **     ec_url_query_init(&query, url.query);                               **
+ **     while(ec_url_query_next(&query, &param))                            **
+ **         if(param.value.len <= sizeof(value))                            **
+ **             use(param.key, ec_url_decode_view(param.value, value,       **
+ **                                                       EC_URL_FORM));    **
+ **                                                                         **
+ ** ec_strbuf_append_url does the opposite. It takes the parts decoded and  **
+ ** encodes each of them the way its place in the URL needs.                **
+ **                                                                         **
+ *****************************************************************************
+ *****************************************************************************
+ **/
+typedef struct
+{
+    ec_strview  scheme;
+    ec_strview  userinfo;
+    /* IPv6 addresses keep their brackets, e.g. "[::1]". */
+    ec_strview  host;
+    ec_strview  port;
+    /* Starts with a '/' whenever there is a host. */
+    ec_strview  path;
+    ec_strview  query;
+    ec_strview  fragment;
+    /* The value of the port, or 0 when there is none. */
+    uint16_t    port_number;
+} ec_url;
+
+typedef struct
+{
+    ec_strview  key;
+    /* Has a NULL ptr for the keys without a '=', e.g. "?debug". */
+    ec_strview  value;
+} ec_url_param;
+
+typedef struct
+{
+    const char *ptr;
+    const char *end;
+} ec_url_query;
 
+/**
+ * @brief ec_url_parse          Splits a URL into its parts.
+ * @param [out]url              Receives the parts.
+ * @param [in]input             The URL. It must outlive the parts.
+ * @return                      false for malformed URLs, i.e. a port which is
+ *                              not a number up to 65535 or an IPv6 host
+ *                              without its closing bracket. The parts are
+ *                              undefined then.
+ */
+bool ec_url_parse(ec_url *url, ec_strview input);
+
+/**
+ * @brief ec_url_query_init     Prepares to walk over the pairs of a query.
+ * @param [out]query            The iterator.
+ * @param [in]input             The query, without the '?'.
+ */
+void ec_url_query_init(ec_url_query *query, ec_strview input);
+
+/**
+ * @brief ec_url_query_next     Yields the next pair. The pairs are separated
+ *                              by '&', the empty ones are skipped.
+ * @param [in]query             The iterator.
+ * @param [out]param            Receives the pair, still percent-encoded.
+ * @return                      false when there are no more pairs.
+ */
+bool ec_url_query_next(ec_url_query *query, ec_url_param *param);
+
+/**
+ * @brief ec_url_query_find     Finds the first pair with the given key.
+ * @param [in]input             The query, without the '?'.
+ * @param [in]key               The key, compared to the keys of the query as
+ *                              they are, i.e. still percent-encoded.
+ * @param [out]value            Receives the value of the pair.
+ * @return                      false when there is no such key.
+ */
+bool ec_url_query_find(ec_strview input, ec_strview key, ec_strview *value);
+
+/**
+ * @brief ec_strbuf_append_url  Builds a URL from its parts.
+ * @param [in]buf               The builder.
+ * @param [in]url               The parts, not percent-encoded. The parts with
+ *                              a NULL ptr are left out along with their
+ *                              delimiters. "scheme", "port" and the IPv6
+ *                              hosts are written as they are, "query" as
+ *                              well since its '&' and '=' must be kept.
+ * @param [in]params            Pairs to encode into the query, after
+ *                              url->query when it has one. Can be EC_NULL.
+ * @param [in]count             Number of the pairs.
+ * @return                      false if some of the output was dropped.
+ */
+bool ec_strbuf_append_url(ec_strbuf *buf, const ec_url *url,
+                                const ec_url_param *params, size_t count);
 
 #ifdef __cplusplus
 }